@@ -0,0 +1,148 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file mind_bench.c
+ * @brief Raw C latency baseline for update/query
+ *
+ * Drives cr_state_update()/cr_state_query() (and their batch variants)
+ * with a steady-state workload: a fixed set of patterns is learned once,
+ * then cycled, so every timed update scans the same number of slots.
+ *
+ * Output is one "key value" pair per line so that binding benchmarks
+ * (external/bindings/python/benchmarks/bench_ffi.py) can parse it and
+ * report their overhead against it.
+ *
+ * Usage: mind_bench [dim] [patterns] [iterations] [coarse] [probe]
+ *
+ * With coarse > 0 the state uses two-level memory (cr_config_t
+ * coarse_slots / coarse_probe).
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "cr.h"
+
+/**
+ * @brief Deterministic xorshift generator (no libc rand state)
+ */
+static uint32_t bench_rand(uint32_t* s) {
+    uint32_t x = *s;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *s = x;
+    return x;
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+int main(int argc, char** argv) {
+    int dim = argc > 1 ? atoi(argv[1]) : 768;
+    int patterns = argc > 2 ? atoi(argv[2]) : 64;
+    int iterations = argc > 3 ? atoi(argv[3]) : 20000;
+    int coarse = argc > 4 ? atoi(argv[4]) : 0;
+    int probe = argc > 5 ? atoi(argv[5]) : 0;
+
+    if (dim <= 0 || patterns <= 0 || iterations <= 0 || coarse < 0 || probe < 0) {
+        fprintf(stderr, "usage: %s [dim] [patterns] [iterations] [coarse] [probe]\n",
+                argv[0]);
+        return 1;
+    }
+
+    cr_config_t cfg = {
+        .embedding_dim = dim,
+        .max_memory_slots = patterns,
+        .initial_plasticity = 1.0f,
+        .coarse_slots = coarse,
+        .coarse_probe = probe
+    };
+    cr_runtime_t* rt = cr_runtime_create(&cfg);
+    cr_state_t* st = rt ? cr_state_create(rt) : NULL;
+    float* data = malloc(sizeof(float) * (size_t)dim * patterns);
+    cr_hint_t* hints = malloc(sizeof(cr_hint_t) * patterns);
+    if (!st || !data || !hints) {
+        fprintf(stderr, "allocation failed\n");
+        return 1;
+    }
+
+    /* Random patterns in [-1, 1]; mutually dissimilar at realistic dims */
+    uint32_t seed = 0x4D494E44u;
+    for (size_t i = 0; i < (size_t)dim * patterns; i++) {
+        data[i] = (float)(bench_rand(&seed) % 20001u) / 10000.0f - 1.0f;
+    }
+
+    /* Warm up: learn every pattern once */
+    cr_state_update_batch(st, data, patterns, dim, dim, 1.0f);
+
+    /* Single-call update */
+    double t0 = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        cr_state_update(st, data + (size_t)(i % patterns) * dim, dim, 1.0f);
+    }
+    double update_ns = (now_ns() - t0) / iterations;
+
+    /* Single-call query */
+    cr_hint_t hint;
+    float sink = 0.0f;
+    t0 = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        cr_state_query(st, data + (size_t)(i % patterns) * dim, dim, &hint);
+        sink += hint.confidence;
+    }
+    double query_ns = (now_ns() - t0) / iterations;
+
+    /* Batched update/query, one batch = every pattern once */
+    int rounds = iterations / patterns > 0 ? iterations / patterns : 1;
+    t0 = now_ns();
+    for (int r = 0; r < rounds; r++) {
+        cr_state_update_batch(st, data, patterns, dim, dim, 1.0f);
+    }
+    double update_batch_ns = (now_ns() - t0) / ((double)rounds * patterns);
+
+    t0 = now_ns();
+    for (int r = 0; r < rounds; r++) {
+        cr_state_query_batch(st, data, patterns, dim, dim, hints);
+        sink += hints[0].confidence;
+    }
+    double query_batch_ns = (now_ns() - t0) / ((double)rounds * patterns);
+
+    printf("dim %d\n", dim);
+    printf("patterns %d\n", patterns);
+    printf("iterations %d\n", iterations);
+    printf("coarse %d\n", coarse);
+    printf("slots %d\n", cr_state_slot_count(st));
+    printf("update_ns %.1f\n", update_ns);
+    printf("query_ns %.1f\n", query_ns);
+    printf("update_batch_ns %.1f\n", update_batch_ns);
+    printf("query_batch_ns %.1f\n", query_batch_ns);
+    printf("checksum %.6f\n", sink);
+
+    free(hints);
+    free(data);
+    cr_state_destroy(st);
+    cr_runtime_destroy(rt);
+
+    return 0;
+}
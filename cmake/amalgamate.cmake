@@ -0,0 +1,77 @@
+# Copyright 2026 The MIND Contributors
+# Licensed under the Apache License, Version 2.0
+#
+# Concatenate foundation and core into a single translation unit.
+#
+#   cmake -DSOURCE_DIR=<repo> -DOUTPUT_DIR=<dir> -DSOURCES="a.c;b.c" \
+#         -P cmake/amalgamate.cmake
+#
+# Writes <dir>/mind.c and copies the public header <dir>/cr.h. Internal
+# headers are inlined once; the public cr.h stays an #include. Foundation
+# kernels and internal helpers get internal linkage (MIND_VEC_API /
+# CR_INTERNAL), so the compiler can inline and specialize them.
+
+if(NOT SOURCE_DIR OR NOT OUTPUT_DIR OR NOT SOURCES)
+    message(FATAL_ERROR "amalgamate.cmake needs SOURCE_DIR, OUTPUT_DIR and SOURCES")
+endif()
+
+set(include_dirs
+    ${SOURCE_DIR}/foundation/include
+    ${SOURCE_DIR}/core/include
+)
+
+file(READ ${SOURCE_DIR}/VERSION version)
+string(STRIP "${version}" version)
+
+set(out "/*
+ * MIND ${version} amalgamation: foundation + core in one translation unit.
+ * Generated by cmake/amalgamate.cmake. Do not edit.
+ *
+ * Build: cc -std=c11 -O2 -c mind.c   (cr.h next to it is the public API)
+ */
+
+/* Feature-test macros must precede every system header */
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#define MIND_AMALGAMATION 1
+#define MIND_VEC_API static inline
+#define CR_INTERNAL static inline
+")
+
+set(inlined "")
+
+foreach(src IN LISTS SOURCES)
+    file(READ ${SOURCE_DIR}/${src} body)
+    string(REGEX REPLACE "#define _POSIX_C_SOURCE[^\n]*\n" "" body "${body}")
+
+    string(REGEX MATCHALL "#include \"[^\"]+\"" includes "${body}")
+    foreach(inc IN LISTS includes)
+        string(REGEX REPLACE "#include \"([^\"]+)\"" "\\1" header "${inc}")
+        if(header STREQUAL "cr.h")
+            continue()
+        endif()
+
+        list(FIND inlined ${header} seen)
+        if(seen EQUAL -1)
+            list(APPEND inlined ${header})
+            find_file(header_path ${header} PATHS ${include_dirs} NO_DEFAULT_PATH)
+            if(NOT header_path)
+                message(FATAL_ERROR "amalgamate: cannot find ${header} (from ${src})")
+            endif()
+            file(READ ${header_path} header_body)
+            unset(header_path CACHE)
+            string(REPLACE "${inc}" "/*---------- ${header} ----------*/\n${header_body}" body "${body}")
+        else()
+            string(REPLACE "${inc}" "/* ${header}: inlined above */" body "${body}")
+        endif()
+    endforeach()
+
+    string(APPEND out "\n/*========== ${src} ==========*/\n\n${body}")
+endforeach()
+
+file(WRITE ${OUTPUT_DIR}/mind.c.tmp "${out}")
+configure_file(${OUTPUT_DIR}/mind.c.tmp ${OUTPUT_DIR}/mind.c COPYONLY)
+file(REMOVE ${OUTPUT_DIR}/mind.c.tmp)
+configure_file(${SOURCE_DIR}/core/include/cr.h ${OUTPUT_DIR}/cr.h COPYONLY)
@@ -69,11 +69,32 @@ typedef float cr_f32;
 
 /**
  * @brief Runtime configuration
+ *
+ * Fields after initial_plasticity are optional: leave them zero (e.g.
+ * with a designated or partial initializer) for the default behavior.
+ *
+ * With coarse_slots > 0, memory is two-level. Each invariant belongs to
+ * the bucket of one coarse summary (the running sum of its members).
+ * Updates and queries first rank the summaries, then scan only the
+ * coarse_probe best buckets, so a lookup costs about
+ * coarse_slots + coarse_probe × (slots per bucket) comparisons instead of
+ * slot_count. Matching is approximate: the closest invariant can be
+ * missed when it sits in a bucket that was not probed. The result is
+ * still deterministic.
+ *
+ * With weight_half_life > 0, invariant weights decay with age: a
+ * reinforcement counts half as much weight_half_life later. Old
+ * reinforcements then lower confidence and rank first for eviction.
  */
 typedef struct {
     int embedding_dim;      /**< Dimension of embedding vectors */
     int max_memory_slots;   /**< Maximum number of invariant slots */
     float initial_plasticity; /**< Starting plasticity (typically 1.0) */
+
+    /* Optional (zero = default) */
+    int coarse_slots;       /**< Two-level memory: coarse summaries (0 = flat scan) */
+    int coarse_probe;       /**< Coarse buckets searched per lookup (0 = 1) */
+    float weight_half_life; /**< Age over which weights halve (0 = no decay) */
 } cr_config_t;
 
 /**
@@ -88,6 +109,19 @@ typedef struct {
     float confidence;  /**< Derived confidence in [0, 1] */
 } cr_hint_t;
 
+/**
+ * @brief Stored invariant with its recency
+ *
+ * Returned by the recency queries. Unlike a hint, it describes the
+ * stored pattern itself rather than its match to a query.
+ */
+typedef struct {
+    cr_f32* vector;          /**< Pointer to invariant vector (internal buffer) */
+    int dim;                 /**< Dimension of the vector */
+    float weight;            /**< Reinforcement weight (decayed, if enabled) */
+    double reinforced_age;   /**< State age when last created or reinforced */
+} cr_invariant_t;
+
 /**
  * @brief Basic epistemic state
  *
@@ -96,7 +130,7 @@ typedef struct {
 typedef struct {
     float plasticity;  /**< Current malleability in (ε, 1.0] */
     float stability;   /**< 1 - plasticity */
-    float age;         /**< Continuous experiential time */
+    double age;        /**< Continuous experiential time */
 } cr_plasticity_t;
 
 /**
@@ -105,16 +139,46 @@ typedef struct {
  * Detailed view of the system's developmental state over time.
  */
 typedef struct {
-    float age;                      /**< Total experiential time */
+    double age;                     /**< Total experiential time */
     float plasticity;               /**< Current malleability */
     float velocity;                 /**< Rate of crystallization (Δplasticity/Δt) */
-    float maturity;                 /**< age × stability */
-    float last_reinforcement_age;   /**< Age at last pattern repetition */
-    float time_since_reinforcement; /**< Age - last_reinforcement_age */
-    int total_updates;              /**< Discrete update count */
-    int total_reinforcements;       /**< Pattern repetition count */
+    double maturity;                /**< age × stability */
+    double last_reinforcement_age;  /**< Age at last pattern repetition */
+    double time_since_reinforcement;/**< Age - last_reinforcement_age */
+    long long total_updates;        /**< Discrete update count */
+    long long total_reinforcements; /**< Pattern repetition count */
 } cr_temporal_t;
 
+/** Number of horizons in cr_rolling_t */
+#define CR_ROLLING_HORIZONS 3
+
+/**
+ * @brief Smoothed statistics over one horizon
+ *
+ * Rates are fractions of updates: reinforcement_ratio counts updates
+ * that reinforced an invariant, create_rate those that stored a new one.
+ */
+typedef struct {
+    int horizon;                /**< Horizon in updates */
+    int updates;                /**< Updates seen, up to horizon */
+    float velocity;             /**< Mean Δplasticity/Δt */
+    float reinforcement_ratio;  /**< Reinforcing updates / updates */
+    float create_rate;          /**< Creating updates / updates */
+} cr_rolling_stat_t;
+
+/**
+ * @brief Rolling temporal statistics
+ *
+ * Both views cover horizons of 16, 64 and 256 updates. ewma[] decays
+ * exponentially with weight 1/horizon (a plain mean until that many
+ * updates were seen); window[] is the exact mean of the last horizon
+ * updates.
+ */
+typedef struct {
+    cr_rolling_stat_t ewma[CR_ROLLING_HORIZONS];
+    cr_rolling_stat_t window[CR_ROLLING_HORIZONS];
+} cr_rolling_t;
+
 /**
  * @brief S2S calibration signal
  *
@@ -203,6 +267,30 @@ int cr_state_update(
     float delta_t
 );
 
+/**
+ * @brief Update state with a batch of experiences
+ *
+ * Equivalent to calling cr_state_update() once per row, in order, with
+ * the same delta_t. Arguments are validated once for the whole batch, so
+ * either every row is applied or none is.
+ *
+ * @param st State to update
+ * @param embeddings First row of the batch
+ * @param count Number of rows (0 is a no-op)
+ * @param stride Distance between rows in floats (must be >= dim)
+ * @param dim Dimension (must match config)
+ * @param delta_t Time increment per row (must be positive)
+ * @return 0 on success, -1 on error
+ */
+int cr_state_update_batch(
+    cr_state_t* st,
+    const cr_f32* embeddings,
+    int count,
+    int stride,
+    int dim,
+    float delta_t
+);
+
 /*============================================================================
  * Query Functions
  *============================================================================*/
@@ -226,6 +314,28 @@ int cr_state_query(
     cr_hint_t* out_hint
 );
 
+/**
+ * @brief Query state for a batch of hints
+ *
+ * Equivalent to calling cr_state_query() once per row.
+ *
+ * @param st State to query
+ * @param queries First row of the batch
+ * @param count Number of rows (0 is a no-op)
+ * @param stride Distance between rows in floats (must be >= dim)
+ * @param dim Dimension (must match config)
+ * @param out_hints Output hints, one per row (must not be NULL)
+ * @return 0 on success, -1 on error
+ */
+int cr_state_query_batch(
+    cr_state_t* st,
+    const cr_f32* queries,
+    int count,
+    int stride,
+    int dim,
+    cr_hint_t* out_hints
+);
+
 /*============================================================================
  * Epistemic State Functions
  *============================================================================*/
@@ -271,6 +381,23 @@ int cr_state_calibration(
     cr_calibration_t* out
 );
 
+/**
+ * @brief Get rolling temporal statistics
+ *
+ * Maintained in O(1) per update, so dashboards can read smoothed
+ * velocity, reinforcement ratio and create rate without polling every
+ * update. The statistics are not saved; they start over on reset and
+ * load.
+ *
+ * @param st State to query
+ * @param out Output structure (must not be NULL)
+ * @return 0 on success, -1 on error
+ */
+int cr_state_rolling(
+    const cr_state_t* st,
+    cr_rolling_t* out
+);
+
 /*============================================================================
  * Persistence Functions
  *============================================================================*/
@@ -299,6 +426,643 @@ int cr_state_save(cr_state_t* st, const char* path);
  */
 int cr_state_load(cr_state_t* st, const char* path);
 
+/**
+ * @brief Digest of the state's content
+ *
+ * FNV-1a (64-bit) of exactly the bytes cr_state_save() would write, so
+ * two states have equal digests when they would save identical files.
+ * Useful to check that a rebuilt or replayed state matches the original
+ * without writing it out.
+ *
+ * @param st State to digest
+ * @param out Receives the digest (must not be NULL)
+ * @return 0 on success, -1 on error
+ */
+int cr_state_digest(cr_state_t* st, unsigned long long* out);
+
+/*============================================================================
+ * Recency
+ *============================================================================*/
+
+/**
+ * @brief Get invariants reinforced within a recent span of age
+ *
+ * Returns invariants whose last creation or reinforcement happened at
+ * age >= (current age - within), most recent first. Cost is
+ * proportional to the number returned, not to the slot count.
+ *
+ * Vectors point into the state and are valid until its next update.
+ *
+ * @param st State to query
+ * @param within Span of age to look back over (>= 0)
+ * @param out Output array (may be NULL when max is 0)
+ * @param max Capacity of out
+ * @return Number of matching invariants (may exceed max), -1 on error
+ */
+int cr_state_recent(cr_state_t* st, double within, cr_invariant_t* out, int max);
+
+/**
+ * @brief Get the least recently reinforced invariant
+ *
+ * O(1). This is the invariant an expiry policy would drop first.
+ *
+ * @param st State to query
+ * @param out Output structure (must not be NULL)
+ * @return 0 on success, -1 on error or if the state is empty
+ */
+int cr_state_oldest(cr_state_t* st, cr_invariant_t* out);
+
+/**
+ * @brief Sliding-window statistics
+ */
+typedef struct {
+    double horizon;              /**< Current horizon (0 = never expire) */
+    unsigned long long expired;  /**< Invariants expired so far */
+} cr_expiry_stats_t;
+
+/**
+ * @brief Turn a state into a sliding window over age
+ *
+ * Invariants expire once the state's age passes their last creation or
+ * reinforcement by more than horizon. Expiry runs on update (and on
+ * load), taking the oldest invariants first; it costs amortized O(1)
+ * per update. Expired slots are reused, so memory stays bounded by the
+ * recent past. Setting a horizon expires stale invariants immediately.
+ * The horizon is not saved with the state.
+ *
+ * @param st State to configure
+ * @param horizon Span of age to keep (0 = never expire, the default)
+ * @return 0 on success, -1 on error
+ */
+int cr_state_set_horizon(cr_state_t* st, double horizon);
+
+/**
+ * @brief Get sliding-window statistics
+ *
+ * @param st State to query
+ * @param out Output structure (must not be NULL)
+ * @return 0 on success, -1 on error
+ */
+int cr_state_expiry(const cr_state_t* st, cr_expiry_stats_t* out);
+
+/*============================================================================
+ * State Splitting
+ *============================================================================*/
+
+/**
+ * @brief A state split into cluster-coherent children
+ *
+ * Child c holds the invariants closest to centroids row c. Route new
+ * experience with cr_split_route(), or let cr_split_update() and
+ * cr_split_query() do it, so each call scans one child only.
+ */
+typedef struct {
+    int k;                  /**< Number of children */
+    int dim;                /**< Embedding dimension */
+    cr_f32* centroids;      /**< k × dim routing table (unit length) */
+    cr_state_t** children;  /**< k states on the parent's runtime */
+} cr_split_t;
+
+/**
+ * @brief Partition a state's invariants into k child states
+ *
+ * Clusters the invariants with spherical k-means (weight-weighted
+ * centroids, farthest-point initialization, at most 32 rounds). Work is
+ * divided into fixed slot and centroid ranges, so the result does not
+ * depend on the thread count. Invariants keep their vectors, weights
+ * and relative order. Every child copies the parent's plasticity,
+ * velocity and age. The update counters are divided by membership:
+ * each invariant contributes its weight to total_updates and its
+ * weight - 1 to total_reinforcements.
+ *
+ * Children are plain states: no tiering, quota, pool or monitor. The
+ * parent is not modified.
+ *
+ * @param st State to split (at least k invariants)
+ * @param k Number of children (>= 1)
+ * @param threads Worker threads (<= 1 runs on the caller)
+ * @param out Receives children and routing table; free with cr_split_destroy()
+ * @return 0 on success, -1 on error
+ */
+int cr_state_split(cr_state_t* st, int k, int threads, cr_split_t* out);
+
+/**
+ * @brief Child whose centroid is most similar to the embedding
+ *
+ * @return Child index (ties go to the lower index), or -1 on error
+ */
+int cr_split_route(const cr_split_t* split, const cr_f32* embedding, int dim);
+
+/**
+ * @brief Route one experience and update that child only
+ *
+ * @return 0 on success, -1 on error
+ */
+int cr_split_update(cr_split_t* split, const cr_f32* embedding, int dim, float delta_t);
+
+/**
+ * @brief Route a query and answer it from that child only
+ *
+ * @return 0 on success, -1 on error
+ */
+int cr_split_query(cr_split_t* split, const cr_f32* query, int dim, cr_hint_t* out);
+
+/**
+ * @brief Destroy the children and free the routing table
+ *
+ * @param split Split to release (may be NULL; fields are cleared)
+ */
+void cr_split_destroy(cr_split_t* split);
+
+/*============================================================================
+ * Memory Tiering
+ *============================================================================*/
+
+/**
+ * @brief Hot/cold tier statistics
+ */
+typedef struct {
+    int hot_slots;                  /**< Hot tier capacity (0 = not tiered) */
+    int hot_count;                  /**< Occupied slots in the hot tier */
+    int cold_count;                 /**< Occupied slots in the cold tier */
+    unsigned long long promotions;  /**< Cold -> hot moves */
+    unsigned long long demotions;   /**< Hot -> cold moves */
+} cr_tier_stats_t;
+
+/**
+ * @brief Split slot storage into a hot RAM slab and a cold mapped file
+ *
+ * At most hot_slots invariants keep their vectors in RAM. The rest are
+ * demoted, least recently matched first, to a file-backed mapping. Cold
+ * rows are scanned through an in-RAM int8 sketch (dim bytes per slot)
+ * and read from the file only to confirm a likely match, which promotes
+ * them back to the hot tier. Anonymous memory is therefore about
+ * hot_slots × dim × 4 + slot_count × dim bytes, while the file holds
+ * max_slots × dim floats (sparse until written).
+ *
+ * Decisions use exact similarities of the candidates that are read. A
+ * cold invariant whose sketch ranks far below the best hot match is not
+ * read, so matching is approximate, but remains deterministic.
+ *
+ * Existing invariants are kept: the first hot_slots stay hot, the rest
+ * are demoted. Available on POSIX systems; elsewhere returns -1.
+ *
+ * @param st State (not yet tiered, not in a pool)
+ * @param hot_slots Hot tier capacity, in [1, max_slots]
+ * @param cold_path Backing file (created or truncated), or NULL for an
+ *                  unlinked temporary file in $TMPDIR (default /tmp)
+ * @return 0 on success, -1 on error
+ */
+int cr_state_tier(cr_state_t* st, int hot_slots, const char* cold_path);
+
+/**
+ * @brief Get tier statistics
+ *
+ * @param st State
+ * @param out Output statistics (all zero for untiered states)
+ * @return 0 on success, -1 on error
+ */
+int cr_state_tier_stats(const cr_state_t* st, cr_tier_stats_t* out);
+
+/*============================================================================
+ * Memory Quotas
+ *============================================================================*/
+
+/**
+ * @brief Degradation steps, in the order they are tried
+ */
+typedef enum {
+    CR_DEGRADE_NONE = 0,      /**< Within quota (or nothing left to give up) */
+    CR_DEGRADE_CACHES = 1,    /**< Released cached cold-tier pages */
+    CR_DEGRADE_QUANTIZE = 2,  /**< Moved slots to the int8-sketched cold tier */
+    CR_DEGRADE_INDEX = 3,     /**< Released the two-level index (flat scan) */
+    CR_DEGRADE_EVICT = 4      /**< Evicted least reinforced invariants */
+} cr_degrade_t;
+
+/**
+ * @brief Quota statistics
+ */
+typedef struct {
+    unsigned long long quota;         /**< Byte quota (0 = unlimited) */
+    unsigned long long bytes;         /**< Current footprint */
+    int step;                         /**< cr_degrade_t of the last enforcement */
+    unsigned long long enforcements;  /**< Times the quota was found exceeded */
+    unsigned long long evicted;       /**< Invariants evicted so far */
+} cr_quota_stats_t;
+
+/**
+ * @brief Limit the memory of a state
+ *
+ * The footprint is computed from the state's shape: slot table, arena
+ * rows in use, index, tier slab, sketches and cached cold pages. It is
+ * checked whenever a new invariant is stored, after a load, and (caches
+ * only) after queries. Over quota, the state degrades in this order and
+ * stops as soon as it fits:
+ *
+ *   1. release cached pages of the cold tier
+ *   2. move slots to the cold tier, keeping only an int8 sketch in RAM
+ *      (an untiered state is tiered with a temporary file; not for
+ *      pooled states)
+ *   3. release the two-level index, so lookups scan every slot
+ *   4. evict the least reinforced invariants, until 1/16 of the room
+ *      above the floor is free (at least one invariant is kept)
+ *
+ * Steps 2 and 3 are permanent. Steps 2-4 run on updates, loads and this
+ * call only, so hint vectors from queries stay valid.
+ *
+ * The floor is what no step can remove: the slot table (sized by
+ * max_memory_slots), the tier bookkeeping of a tiered state, and one
+ * invariant. Quotas below it are refused.
+ *
+ * @param st State
+ * @param bytes Quota in bytes (0 removes it)
+ * @return The cr_degrade_t reached now, or -1 on error (including a
+ *         quota below the floor, which leaves the previous one in place)
+ */
+int cr_state_set_quota(cr_state_t* st, unsigned long long bytes);
+
+/**
+ * @brief Get quota statistics
+ *
+ * @return 0 on success, -1 on error
+ */
+int cr_state_quota(const cr_state_t* st, cr_quota_stats_t* out);
+
+/**
+ * @brief Release slot storage past the live invariants
+ *
+ * A state's storage stays at its high-water mark after evictions. This
+ * call frees the rows past slot_count: the arena is reallocated to the
+ * live rows, and a tiered state frees its cold pages and the file blocks
+ * of rows past slot_count. Invariants, their order and lookups are
+ * unchanged. Later new invariants regrow the arena geometrically.
+ *
+ * @param st State
+ * @return 0 on success, -1 on error (the state is unchanged)
+ */
+int cr_state_shrink(cr_state_t* st);
+
+/*============================================================================
+ * Memory Pressure
+ *============================================================================*/
+
+/**
+ * @brief Opaque memory pressure monitor
+ *
+ * A monitor watches a Linux PSI file (/proc/pressure/memory, or a
+ * cgroup's memory.pressure) on its own thread. While pressure lasts,
+ * attached states release optional memory: the two-level index, the
+ * cold-tier sketches and cached cold pages. They rebuild it once
+ * pressure has ended. Both happen at the state's next update, query,
+ * save, load or reset, on the calling thread, so monitoring adds no
+ * locking to states. Results during pressure are exact flat-scan
+ * results, so they can differ from those of a two-level index.
+ */
+typedef struct cr_monitor cr_monitor_t;
+
+/**
+ * @brief Pressure transition callback
+ *
+ * Invoked on the monitor thread (or the cr_monitor_signal() caller)
+ * when pressure starts (1) or ends (0). Must not block. A host can use
+ * it to sweep pools or shed load.
+ */
+typedef void (*cr_pressure_fn)(void* ctx, int pressure);
+
+/**
+ * @brief Monitor configuration (zero fields take defaults)
+ */
+typedef struct {
+    const char* path;       /**< PSI file (default /proc/pressure/memory) */
+    int stall_us;           /**< Stall time per window that counts as pressure (150000) */
+    int window_us;          /**< PSI window (1000000) */
+    int quiet_ms;           /**< Pressure ends after this long without stalls (10000) */
+    cr_pressure_fn notify;  /**< Optional transition callback */
+    void* notify_ctx;       /**< Passed through to notify */
+} cr_monitor_config_t;
+
+/**
+ * @brief Create a monitor
+ *
+ * Registers a PSI trigger ("some stall_us window_us"). If the kernel
+ * refuses the trigger (e.g. unprivileged windows must be whole multiples
+ * of 2 s), the monitor samples avg10 once per window instead.
+ *
+ * @param cfg Configuration, or NULL for a monitor driven only by
+ *            cr_monitor_signal()
+ * @return Monitor handle, or NULL if the PSI file cannot be opened or
+ *         the platform lacks threads
+ */
+cr_monitor_t* cr_monitor_create(const cr_monitor_config_t* cfg);
+
+/**
+ * @brief Destroy a monitor
+ *
+ * Remove or destroy every attached state first.
+ *
+ * @param mon Monitor to destroy (may be NULL)
+ */
+void cr_monitor_destroy(cr_monitor_t* mon);
+
+/**
+ * @brief Attach a state to a monitor
+ *
+ * Must not race with other calls on the same state.
+ *
+ * @return 0 on success, -1 on error (e.g. attached elsewhere)
+ */
+int cr_monitor_add(cr_monitor_t* mon, cr_state_t* st);
+
+/**
+ * @brief Detach a state, rebuilding anything it released
+ *
+ * @return 0 on success, -1 if st is not attached to mon
+ */
+int cr_monitor_remove(cr_monitor_t* mon, cr_state_t* st);
+
+/**
+ * @brief Set the pressure level by hand (other signals, tests)
+ *
+ * @param pressure Nonzero to start pressure, 0 to end it
+ * @return 0 on success, -1 on error
+ */
+int cr_monitor_signal(cr_monitor_t* mon, int pressure);
+
+/**
+ * @brief Monitor statistics
+ */
+typedef struct {
+    int pressure;                   /**< Current level (0 or 1) */
+    int triggered;                  /**< 1: PSI trigger, 0: avg10 sampling or manual */
+    unsigned long long events;      /**< Pressure events observed */
+    unsigned long long samples;     /**< avg10 samples read (sampling mode) */
+    unsigned long long releases;    /**< States that released optional memory */
+    unsigned long long rebuilds;    /**< States that rebuilt it */
+} cr_monitor_stats_t;
+
+/**
+ * @brief Get monitor statistics
+ *
+ * @return 0 on success, -1 on error
+ */
+int cr_monitor_stats(const cr_monitor_t* mon, cr_monitor_stats_t* out);
+
+/*============================================================================
+ * State Pools
+ *============================================================================*/
+
+/**
+ * @brief Opaque pool handle
+ *
+ * A pool tracks when each member state was last used. cr_pool_sweep()
+ * hibernates members idle for at least the pool TTL: the state is
+ * serialized (to an in-memory image, or a file in the pool directory)
+ * and its slot memory is freed. The handle stays valid. The next call
+ * that needs slot memory (update, query, save, load, reset) revives the
+ * state first; concurrent callers wait for one shared revival.
+ *
+ * Scalar accessors (plasticity, temporal, calibration, slot count) do
+ * not revive. Hint vectors of a state are invalidated when it
+ * hibernates. Tiered states cannot be pooled. Available on POSIX
+ * systems; elsewhere cr_pool_create() returns NULL.
+ */
+typedef struct cr_pool cr_pool_t;
+
+/**
+ * @brief Pool statistics
+ */
+typedef struct {
+    int members;                        /**< States in the pool */
+    int hibernated;                     /**< Members currently hibernated */
+    unsigned long long hibernations;    /**< Total hibernations */
+    unsigned long long revivals;        /**< Total revivals */
+    unsigned long long image_bytes;     /**< Size of current hibernation images */
+} cr_pool_stats_t;
+
+/**
+ * @brief Create a pool
+ *
+ * @param ttl_seconds Idle time after which a sweep hibernates a member (>= 0)
+ * @param dir Directory for hibernation files, or NULL to keep images in memory
+ * @return Pool handle, or NULL on failure
+ */
+cr_pool_t* cr_pool_create(double ttl_seconds, const char* dir);
+
+/**
+ * @brief Destroy a pool
+ *
+ * Hibernated members are revived, then every member is detached. The
+ * states themselves remain owned by the caller. A member that cannot be
+ * revived (e.g. out of memory) is detached still hibernated: it keeps
+ * its image, its calls fail until a revival succeeds, and cr_pool_add()
+ * revives it first.
+ *
+ * @param pool Pool to destroy (may be NULL)
+ */
+void cr_pool_destroy(cr_pool_t* pool);
+
+/**
+ * @brief Add a state to a pool
+ *
+ * Must not race with other calls on the same state. A state belongs to
+ * at most one pool; destroying it removes it.
+ *
+ * @return 0 on success, -1 on error (already pooled, tiered, or no memory)
+ */
+int cr_pool_add(cr_pool_t* pool, cr_state_t* st);
+
+/**
+ * @brief Remove a state from its pool (reviving it if hibernated)
+ *
+ * @return 0 on success, -1 if st is not a member or cannot be revived
+ */
+int cr_pool_remove(cr_pool_t* pool, cr_state_t* st);
+
+/**
+ * @brief Limit the combined memory of a pool's members
+ *
+ * Enforced by cr_pool_sweep(): when members not in use, plus in-memory
+ * hibernation images, exceed the quota, members are hibernated least
+ * recently used first, regardless of the TTL.
+ *
+ * @param pool Pool
+ * @param bytes Quota in bytes (0 removes it)
+ * @return 0 on success, -1 on error
+ */
+int cr_pool_set_quota(cr_pool_t* pool, unsigned long long bytes);
+
+/**
+ * @brief Hibernate every member idle for at least the TTL
+ *
+ * Then, if the pool has a quota, hibernate further members until it
+ * fits. Members in use by another thread are skipped. Safe to call from
+ * a timer thread while members are in use.
+ *
+ * @return Number of states hibernated, or -1 on error
+ */
+int cr_pool_sweep(cr_pool_t* pool);
+
+/**
+ * @brief Get pool statistics
+ *
+ * @return 0 on success, -1 on error
+ */
+int cr_pool_stats(cr_pool_t* pool, cr_pool_stats_t* out);
+
+/*============================================================================
+ * Asynchronous Submission
+ *============================================================================*/
+
+/**
+ * @brief Opaque submission queue handle
+ *
+ * A queue owns one worker thread that executes submitted operations
+ * against a single state, strictly in submission order. Results are
+ * identical to issuing the same calls synchronously.
+ *
+ * While a queue is attached, the state must only be touched through
+ * the queue. Available on POSIX systems; elsewhere cr_queue_create()
+ * returns NULL.
+ */
+typedef struct cr_queue cr_queue_t;
+
+/**
+ * @brief Queued operation kinds
+ */
+typedef enum {
+    CR_OP_UPDATE = 1,  /**< cr_state_update_batch() */
+    CR_OP_QUERY = 2,   /**< cr_state_query_batch() */
+    CR_OP_SAVE = 3     /**< cr_state_save() */
+} cr_op_t;
+
+/**
+ * @brief Completion record
+ */
+typedef struct {
+    unsigned long long tag;  /**< Caller tag given at submission */
+    int op;                  /**< cr_op_t of the operation */
+    int status;              /**< 0 on success, -1 on error */
+} cr_completion_t;
+
+/**
+ * @brief Completion callback
+ *
+ * Invoked on the worker thread, once per completed operation, in
+ * submission order. Must not block. The completed operation no longer
+ * counts against capacity, so the callback may submit to the same queue.
+ */
+typedef void (*cr_notify_fn)(void* ctx, const cr_completion_t* completion);
+
+/**
+ * @brief Create a submission queue for a state
+ *
+ * @param st State the queue operates on (must outlive the queue)
+ * @param capacity Maximum operations in flight (submitted, not yet reaped)
+ * @return Queue handle, or NULL on failure
+ */
+cr_queue_t* cr_queue_create(cr_state_t* st, int capacity);
+
+/**
+ * @brief Destroy a queue
+ *
+ * Waits for every submitted operation to execute, then stops the worker.
+ * Unreaped completions are discarded.
+ *
+ * @param q Queue to destroy (may be NULL)
+ */
+void cr_queue_destroy(cr_queue_t* q);
+
+/**
+ * @brief Readiness file descriptor
+ *
+ * Becomes readable when completions are waiting to be reaped with
+ * cr_queue_poll(). On Linux this is an eventfd; elsewhere the read end
+ * of a pipe. Suitable for epoll/kqueue/asyncio add_reader().
+ *
+ * @param q Queue
+ * @return File descriptor, or -1 on error
+ */
+int cr_queue_fd(const cr_queue_t* q);
+
+/**
+ * @brief Deliver completions through a callback instead of cr_queue_poll()
+ *
+ * Must be called before the first submission. With a callback installed
+ * the readiness descriptor is never signalled.
+ *
+ * @param q Queue
+ * @param fn Callback (NULL restores polling)
+ * @param ctx Passed through to fn
+ * @return 0 on success, -1 on error
+ */
+int cr_queue_set_notify(cr_queue_t* q, cr_notify_fn fn, void* ctx);
+
+/**
+ * @brief Submit an update of count rows
+ *
+ * The rows are not copied: they must stay valid until the completion
+ * is reaped.
+ *
+ * @return 0 if queued, -1 on invalid arguments or if the queue is full
+ */
+int cr_queue_submit_update(
+    cr_queue_t* q,
+    const cr_f32* embeddings,
+    int count,
+    int stride,
+    int dim,
+    float delta_t,
+    unsigned long long tag
+);
+
+/**
+ * @brief Submit a query of count rows
+ *
+ * Queries and out_hints must stay valid until the completion is reaped.
+ * If out_vectors is not NULL (count × dim floats), each hint vector is
+ * copied there on the worker thread and hint.vector points into it, so
+ * the result is not disturbed by later queued updates.
+ *
+ * @return 0 if queued, -1 on invalid arguments or if the queue is full
+ */
+int cr_queue_submit_query(
+    cr_queue_t* q,
+    const cr_f32* queries,
+    int count,
+    int stride,
+    int dim,
+    cr_hint_t* out_hints,
+    cr_f32* out_vectors,
+    unsigned long long tag
+);
+
+/**
+ * @brief Submit a save (path is copied)
+ *
+ * @return 0 if queued, -1 on invalid arguments or if the queue is full
+ */
+int cr_queue_submit_save(
+    cr_queue_t* q,
+    const char* path,
+    unsigned long long tag
+);
+
+/**
+ * @brief Reap completed operations (non-blocking)
+ *
+ * Clears the readiness descriptor, then reaps up to max completions. If
+ * more are waiting, the descriptor is set again, so it stays readable
+ * until everything is reaped. Event loops should still call this until
+ * it returns fewer than max before waiting on cr_queue_fd() again;
+ * otherwise every leftover batch costs one more wakeup.
+ *
+ * @param q Queue
+ * @param out Output completions
+ * @param max Capacity of out
+ * @return Number of completions written (0 if none), or -1 on error
+ */
+int cr_queue_poll(cr_queue_t* q, cr_completion_t* out, int max);
+
 /*============================================================================
  * Utility Functions
  *============================================================================*/
@@ -24,6 +24,8 @@
 #ifndef CR_INTERNAL_H
 #define CR_INTERNAL_H
 
+#include <stdio.h>
+
 /*============================================================================
  * Constants (Frozen v0.1 Semantics)
  *============================================================================*/
@@ -68,7 +70,24 @@
 /**
  * @brief Persistence format version
  */
-#define CR_PERSIST_VERSION 1
+#define CR_PERSIST_VERSION 3
+
+/**
+ * @brief Weight decay renormalization point
+ *
+ * Stored weights are true weights × e^weight_log. Once weight_log passes
+ * this, stored weights are divided back down (about every 58 half-lives).
+ */
+#define CR_DECAY_RENORM_LOG 40.0
+
+/**
+ * @brief Rolling statistics ring size (the longest window, in updates)
+ */
+#define CR_ROLLING_RING 256
+
+/** Update outcomes recorded by the rolling statistics */
+#define CR_EVENT_REINFORCED 1
+#define CR_EVENT_CREATED 2
 
 /*============================================================================
  * Internal Structures
@@ -82,8 +101,65 @@
 typedef struct {
     float* vector;  /**< Invariant vector (dimension = rt->dim) */
     float weight;   /**< Reinforcement weight */
+    int coarse;     /**< Owning coarse summary (two-level memory), else -1 */
+    int next;       /**< Next slot in the same bucket, or -1 */
+    int hot;        /**< Hot slab row (tiered states), else -1 */
+    unsigned long long last_access;  /**< Tier clock at last match/creation */
+    double reinforced_age;  /**< Age when last created or reinforced */
+    int newer;      /**< Next more recently reinforced slot, or -1 */
+    int older;      /**< Next less recently reinforced slot, or -1 */
 } cr_slot_t;
 
+/**
+ * @brief Coarse summary (two-level memory)
+ *
+ * sum is the element-wise sum of the member invariants, kept current on
+ * every reinforcement. Cosine similarity is scale invariant, so matching
+ * against the sum is matching against the bucket mean.
+ */
+typedef struct {
+    float* sum;     /**< Sum of member vectors (dimension = rt->dim) */
+    int head;       /**< First member slot, or -1 */
+    int count;      /**< Number of members */
+} cr_coarse_t;
+
+/**
+ * @brief Hot/cold storage of slot vectors (cr_tier.c)
+ *
+ * Hot rows live in an in-RAM slab. Cold rows live in a file-backed
+ * mapping (row i of the file belongs to slot i) and are matched through
+ * an int8 sketch, so scanning them never touches the mapping.
+ */
+typedef struct {
+    int hot_slots;              /**< Slab capacity in rows */
+    int hot_used;               /**< Slab rows handed out */
+    float* slab;                /**< hot_slots × dim */
+    int* hot_owner;             /**< Slab row -> slot */
+
+    float* cold;                /**< Mapping, max_slots × dim */
+    unsigned long long cold_bytes;  /**< Size of the mapping */
+    int fd;                     /**< Backing file */
+
+    signed char* sketch;        /**< max_slots × dim, valid for cold slots;
+                                     NULL while released under pressure */
+    float* sketch_scale;        /**< Per slot: max |v| / 127 */
+    float* sketch_norm;         /**< Per slot: ||v|| */
+
+    unsigned char* resident;    /**< Per slot: cold row touched since last drop */
+    int resident_count;
+
+    unsigned long long clock;   /**< Advances once per lookup */
+    unsigned long long pin_from;    /**< Slots matched at or after this clock keep
+                                         their slab row (0 = no pinning) */
+    unsigned long long promotions;
+    unsigned long long demotions;
+} cr_tier_t;
+
+/**
+ * @brief Pool membership of a state (cr_pool.c)
+ */
+typedef struct cr_pool_member cr_pool_member_t;
+
 /**
  * @brief Runtime structure (opaque)
  *
@@ -92,6 +168,10 @@ typedef struct {
 struct cr_runtime {
     int dim;        /**< Embedding dimension */
     int max_slots;  /**< Maximum memory slots */
+    int coarse_slots;   /**< Coarse summaries (0 = flat memory) */
+    int coarse_probe;   /**< Buckets scanned per lookup */
+    float weight_half_life; /**< As configured (0 = no decay) */
+    double decay_rate;      /**< ln 2 / weight_half_life per unit of age */
 };
 
 /**
@@ -105,23 +185,75 @@ struct cr_state {
     /* Memory */
     cr_slot_t* slots;       /**< Array of memory slots */
     int slot_count;         /**< Number of occupied slots */
+    float* arena;           /**< Slot vectors, arena_rows × dim, contiguous */
+    int arena_rows;         /**< Rows allocated (max_slots until shrunk) */
+
+    /* Two-level memory (NULL when flat) */
+    cr_coarse_t* coarse;    /**< Coarse summaries */
+    int coarse_count;       /**< Number of coarse summaries in use */
+    float* coarse_arena;    /**< Summary vectors, coarse_slots × dim */
+    int* probe;             /**< Scratch: best coarse indices */
+    float* probe_sim;       /**< Scratch: their similarities */
+
+    /* Recency list: slots by reinforced_age (cr_recency.c) */
+    int recent_head;        /**< Most recently reinforced slot, or -1 */
+    int recent_tail;        /**< Least recently reinforced slot, or -1 */
+
+    /* Sliding window (cr_expiry.c) */
+    double horizon;                 /**< Expire after this much age (0 = never) */
+    unsigned long long expired;     /**< Slots expired so far */
+
+    /* Hot/cold tiering (NULL when every row is in arena) */
+    cr_tier_t* tier;
+
+    /* Pool membership (NULL when not pooled); slots and arena are NULL
+     * while the state is hibernated */
+    cr_pool_member_t* member;
+
+    /* Byte quota (cr_quota.c) */
+    unsigned long long quota;       /**< 0 = unlimited */
+    int quota_step;                 /**< cr_degrade_t of the last enforcement */
+    int index_dropped;              /**< Two-level index released for good */
+    unsigned long long quota_enforcements;
+    unsigned long long quota_evicted;
+
+    /* Memory pressure (cr_monitor.c) */
+    cr_monitor_t* monitor;          /**< NULL when not monitored */
+    int pressure_released;          /**< Optional structures are released */
+
+    /* Weight decay: slot.weight = true weight × weight_scale */
+    double weight_log;              /**< Decay accumulated since renormalization */
+    double weight_scale;            /**< e^weight_log */
 
     /* Core epistemic state */
     float plasticity;       /**< Current malleability in (ε, 1.0] */
-    float age;              /**< Continuous experiential time */
+    double age;             /**< Continuous experiential time */
 
     /* Temporal tracking */
     float plasticity_prev;          /**< Previous plasticity (for velocity) */
     float velocity;                 /**< Rate of crystallization */
-    float last_reinforcement_age;   /**< Age at last reinforcement */
-    int total_updates;              /**< Total update count */
-    int total_reinforcements;       /**< Total reinforcement count */
+    double last_reinforcement_age;  /**< Age at last reinforcement */
+    long long total_updates;        /**< Total update count */
+    long long total_reinforcements; /**< Total reinforcement count */
+
+    /* Rolling statistics (cr_temporal.c); per horizon: velocity,
+     * reinforced, created */
+    long long rolling_count;                        /**< Updates since reset */
+    float rolling_ewma[CR_ROLLING_HORIZONS][3];
+    double rolling_sum[CR_ROLLING_HORIZONS][3];     /**< Window sums */
+    float rolling_velocity[CR_ROLLING_RING];
+    unsigned char rolling_event[CR_ROLLING_RING];   /**< CR_EVENT_* bits */
 };
 
 /*============================================================================
  * Internal Functions
  *============================================================================*/
 
+/* Linkage of internal helpers; the amalgamation makes them static inline */
+#ifndef CR_INTERNAL
+#define CR_INTERNAL
+#endif
+
 /**
  * @brief Compute cosine similarity
  *
@@ -130,6 +262,204 @@ struct cr_state {
  * @param dim Dimension
  * @return Cosine similarity in [-1, 1], or 0 if either vector is zero
  */
-float cr_cosine_similarity(const float* a, const float* b, int dim);
+CR_INTERNAL float cr_cosine_similarity(const float* a, const float* b, int dim);
+
+/*
+ * State memory (cr_state.c) and its serialized form (cr_persist.c)
+ */
+
+/** Allocate slots, arena and index for an empty state; 0 or -1 */
+CR_INTERNAL int cr_state_alloc(cr_state_t* st);
+
+/** Free slots, arena, index and tiers (the scalar state is kept) */
+CR_INTERNAL void cr_state_release(cr_state_t* st);
+
+/** Decayed weight of a slot (its stored weight over weight_scale) */
+CR_INTERNAL float cr_slot_weight(const cr_state_t* st, const cr_slot_t* slot);
+
+/** Make slots [0, rows) writable, growing a shrunk arena; 0 or -1 */
+CR_INTERNAL int cr_state_reserve(cr_state_t* st, int rows);
+
+/** Write/read the persistence format to/from an open stream; 0 or -1 */
+CR_INTERNAL int cr_persist_write(const cr_state_t* st, FILE* f);
+CR_INTERNAL int cr_persist_read(cr_state_t* st, FILE* f);
+
+/*
+ * Recency list (cr_recency.c): slots ordered by reinforced_age, newest at
+ * recent_head. Ages only grow, so a touched slot always moves to the head.
+ */
+
+/** Stamp a slot with age and move it to the head (O(1)) */
+CR_INTERNAL void cr_recency_touch(cr_state_t* st, int slot, double age);
+
+/** Remove a slot from the list (O(1)) */
+CR_INTERNAL void cr_recency_unlink(cr_state_t* st, int slot);
+
+/** Empty the list (the slots' ages are kept) */
+CR_INTERNAL void cr_recency_clear(cr_state_t* st);
+
+/** Relink slots [0, slot_count) by reinforced_age, e.g. after compaction or load */
+CR_INTERNAL int cr_recency_rebuild(cr_state_t* st);
+
+/** Give slot from's list position to slot to (to must be unlinked) */
+CR_INTERNAL void cr_recency_move(cr_state_t* st, int from, int to);
+
+/*
+ * Sliding window (cr_expiry.c)
+ */
+
+/** Expire slots not reinforced within the horizon of age now; returns count */
+CR_INTERNAL int cr_expiry_run(cr_state_t* st, double now);
+
+/*
+ * Rolling statistics (cr_temporal.c)
+ */
+
+/** Record an update's outcome (CR_EVENT_* bits); call after velocity is set */
+CR_INTERNAL void cr_temporal_record(cr_state_t* st, int events);
+
+/** Forget all recorded updates (reset) */
+CR_INTERNAL void cr_temporal_clear(cr_state_t* st);
+
+/*
+ * Slot index (cr_index.c): finds the best-matching slot, flat or two-level
+ */
+
+/** Allocate index structures for st (no-op for flat memory); 0 or -1 */
+CR_INTERNAL int cr_index_create(cr_state_t* st);
+
+/** Free index structures */
+CR_INTERNAL void cr_index_destroy(cr_state_t* st);
+
+/** Forget every slot (the slots themselves are untouched) */
+CR_INTERNAL void cr_index_clear(cr_state_t* st);
+
+/** Re-index slots [0, slot_count), e.g. after load */
+CR_INTERNAL void cr_index_rebuild(cr_state_t* st);
+
+/**
+ * @brief Best-matching slot for an embedding
+ *
+ * @param out_sim Receives its similarity (0 if none is above 0)
+ * @return Best slot with positive similarity, or NULL
+ */
+CR_INTERNAL cr_slot_t* cr_index_match(cr_state_t* st, const float* embedding,
+                                      int dim, float* out_sim);
+
+/** Add a newly created slot to the index */
+CR_INTERNAL void cr_index_insert(cr_state_t* st, int slot);
+
+/** Bracket an in-place write to a slot vector (keeps summaries current) */
+CR_INTERNAL void cr_index_retract(cr_state_t* st, const cr_slot_t* slot);
+CR_INTERNAL void cr_index_commit(cr_state_t* st, const cr_slot_t* slot);
+
+/** Take a slot out of the index (at most one bucket walk, like a lookup) */
+CR_INTERNAL void cr_index_remove(cr_state_t* st, int slot);
+
+/** Give slot from's index membership to slot to (to must be removed) */
+CR_INTERNAL void cr_index_move(cr_state_t* st, int from, int to);
+
+/*
+ * Hot/cold tiering (cr_tier.c). Every function is a no-op on untiered states.
+ */
+
+/** Give a slot a hot row, demoting the least recently used hot slot */
+CR_INTERNAL void cr_tier_place(cr_state_t* st, int slot);
+
+/** Move a cold slot into the hot tier (contents preserved; stays cold if
+ *  every slab row is pinned) */
+CR_INTERNAL void cr_tier_promote(cr_state_t* st, int slot);
+
+/** Keep the slab rows of slots matched from now on until cr_tier_unpin() */
+CR_INTERNAL void cr_tier_pin(cr_state_t* st);
+CR_INTERNAL void cr_tier_unpin(cr_state_t* st);
+
+/** Approximate cosine similarity of a cold slot, from its sketch */
+CR_INTERNAL float cr_tier_estimate(const cr_state_t* st, int slot,
+                                   const float* embedding, float embedding_norm);
+
+/** Start a new lookup; returns the clock value to stamp matches with */
+CR_INTERNAL unsigned long long cr_tier_tick(cr_state_t* st);
+
+/** Forget all placements (reset) */
+CR_INTERNAL void cr_tier_clear(cr_state_t* st);
+
+/** Place slots [0, count) before their contents are loaded */
+CR_INTERNAL void cr_tier_layout(cr_state_t* st, int count);
+
+/** Recompute sketches of cold slots after their contents changed */
+CR_INTERNAL void cr_tier_rebuild(cr_state_t* st);
+
+/** Note a read of a cold row (its page is now cached) */
+CR_INTERNAL void cr_tier_touch(cr_state_t* st, int slot);
+
+/** Detach a slot past slot_count from the hot slab (eviction) */
+CR_INTERNAL void cr_tier_drop(cr_state_t* st, int slot);
+
+/** Move slot from's row (hot or cold) to slot to (to must be dropped) */
+CR_INTERNAL void cr_tier_move(cr_state_t* st, int from, int to);
+
+/** Write back and release cached cold pages; 0 if anything was cached */
+CR_INTERNAL int cr_tier_drop_cache(cr_state_t* st);
+
+/** Free the sketches (cold lookups then read rows) / recompute them */
+CR_INTERNAL void cr_tier_release_sketch(cr_state_t* st);
+CR_INTERNAL int cr_tier_restore_sketch(cr_state_t* st);
+
+/** Release cached pages and file blocks of rows past slot_count; 0 or -1 */
+CR_INTERNAL int cr_tier_trim(cr_state_t* st);
+
+/** Demote every hot slot and resize the slab to hot_slots rows; 0 or -1 */
+CR_INTERNAL int cr_tier_shrink(cr_state_t* st, int hot_slots);
+
+/** Release all tier resources */
+CR_INTERNAL void cr_tier_destroy(cr_state_t* st);
+
+/*
+ * Byte quotas (cr_quota.c)
+ */
+
+/** Bytes of memory attributed to st (O(1)) */
+CR_INTERNAL unsigned long long cr_quota_bytes(const cr_state_t* st);
+
+/**
+ * @brief Degrade st until it fits its quota
+ *
+ * @param max_step Deepest cr_degrade_t allowed (queries stop at caches)
+ * @return The cr_degrade_t reached (CR_DEGRADE_NONE if within quota)
+ */
+CR_INTERNAL int cr_quota_enforce(cr_state_t* st, int max_step);
+
+/*
+ * State pools (cr_pool.c). Both are no-ops for states outside a pool.
+ */
+
+/**
+ * @brief Pin a state for one public call, reviving it if hibernated
+ *
+ * Concurrent callers of a hibernated state wait for a single revival.
+ *
+ * @return 0 (pinned; pair with cr_pool_leave), or -1 if revival failed
+ */
+CR_INTERNAL int cr_pool_enter(cr_state_t* st);
+
+/** Unpin a state and restart its idle timer */
+CR_INTERNAL void cr_pool_leave(cr_state_t* st);
+
+/** Detach a state that is being destroyed, dropping any hibernation image */
+CR_INTERNAL void cr_pool_forget(cr_state_t* st);
+
+/*
+ * Memory pressure (cr_monitor.c)
+ */
+
+/**
+ * @brief Follow the monitor's pressure level
+ *
+ * Releases the index, sketches and cached cold pages when pressure
+ * starts and rebuilds them on the first call after it ends. Runs at the
+ * start of every public call that touches slot memory.
+ */
+CR_INTERNAL void cr_monitor_apply(cr_state_t* st);
 
 #endif /* CR_INTERNAL_H */
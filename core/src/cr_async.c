@@ -0,0 +1,480 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file cr_async.c
+ * @brief Asynchronous submission queue
+ *
+ * One ring of entries serves as both submission and completion queue.
+ * Three monotonic sequence numbers partition it:
+ *
+ *   [reap_seq, run_seq)    completed, waiting to be reaped
+ *   [run_seq, submit_seq)  submitted, waiting for the worker
+ *
+ * Submission fails once submit_seq - reap_seq reaches capacity, so the
+ * completion side can never overflow. A single worker executes entries
+ * in order, which keeps state evolution identical to synchronous calls.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include "cr.h"
+#include "cr_internal.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#endif
+
+typedef struct {
+    int op;
+    const float* data;
+    int count;
+    int stride;
+    float delta_t;
+    cr_hint_t* hints;
+    float* vectors;
+    char* path;
+    unsigned long long tag;
+    int status;
+} cr_queue_entry_t;
+
+struct cr_queue {
+    cr_state_t* st;
+    cr_queue_entry_t* ring;
+    int capacity;
+
+    unsigned long long submit_seq;  /**< Next entry to fill */
+    unsigned long long run_seq;     /**< Next entry to execute */
+    unsigned long long reap_seq;    /**< Next entry to reap */
+
+    pthread_mutex_t lock;
+    pthread_cond_t work;            /**< Submission or stop */
+    pthread_t worker;
+    int stopping;
+
+    int fds[2];                     /**< Read/write ends (same fd for eventfd) */
+    cr_notify_fn notify;
+    void* notify_ctx;
+};
+
+/*============================================================================
+ * Readiness Descriptor
+ *============================================================================*/
+
+static int queue_fd_open(cr_queue_t* q) {
+#if defined(__linux__)
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    q->fds[0] = q->fds[1] = fd;
+#else
+    if (pipe(q->fds) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < 2; i++) {
+        fcntl(q->fds[i], F_SETFL, fcntl(q->fds[i], F_GETFL) | O_NONBLOCK);
+        fcntl(q->fds[i], F_SETFD, FD_CLOEXEC);
+    }
+#endif
+    return 0;
+}
+
+static void queue_fd_close(cr_queue_t* q) {
+    close(q->fds[0]);
+    if (q->fds[1] != q->fds[0]) {
+        close(q->fds[1]);
+    }
+}
+
+static void queue_fd_signal(cr_queue_t* q) {
+#if defined(__linux__)
+    uint64_t one = 1;
+    ssize_t n = write(q->fds[1], &one, sizeof(one));
+#else
+    char one = 1;
+    ssize_t n = write(q->fds[1], &one, 1);  /* EAGAIN: already readable */
+#endif
+    (void)n;
+}
+
+static void queue_fd_clear(cr_queue_t* q) {
+#if defined(__linux__)
+    uint64_t count;
+    ssize_t n = read(q->fds[0], &count, sizeof(count));
+    (void)n;
+#else
+    char buf[64];
+    while (read(q->fds[0], buf, sizeof(buf)) > 0) {
+    }
+#endif
+}
+
+/*============================================================================
+ * Worker
+ *============================================================================*/
+
+static void queue_execute(cr_queue_t* q, cr_queue_entry_t* e) {
+    int dim = q->st->rt->dim;
+
+    switch (e->op) {
+    case CR_OP_UPDATE:
+        e->status = cr_state_update_batch(
+            q->st, e->data, e->count, e->stride, dim, e->delta_t);
+        break;
+    case CR_OP_QUERY:
+        e->status = cr_state_query_batch(
+            q->st, e->data, e->count, e->stride, dim, e->hints);
+        if (e->status == 0 && e->vectors) {
+            /* Snapshot: later updates must not move the caller's result */
+            for (int i = 0; i < e->count; i++) {
+                float* dst = e->vectors + (size_t)i * dim;
+                if (e->hints[i].vector) {
+                    memcpy(dst, e->hints[i].vector, sizeof(float) * dim);
+                    e->hints[i].vector = dst;
+                }
+            }
+        }
+        break;
+    case CR_OP_SAVE:
+        e->status = cr_state_save(q->st, e->path);
+        free(e->path);
+        e->path = NULL;
+        break;
+    default:
+        e->status = -1;
+        break;
+    }
+}
+
+static void* queue_worker(void* arg) {
+    cr_queue_t* q = arg;
+
+    pthread_mutex_lock(&q->lock);
+    for (;;) {
+        while (q->run_seq == q->submit_seq && !q->stopping) {
+            pthread_cond_wait(&q->work, &q->lock);
+        }
+        if (q->run_seq == q->submit_seq) {
+            break;  /* Stopping and drained */
+        }
+
+        cr_queue_entry_t* e = &q->ring[q->run_seq % q->capacity];
+        pthread_mutex_unlock(&q->lock);
+
+        queue_execute(q, e);
+        cr_completion_t c = {e->tag, e->op, e->status};
+
+        pthread_mutex_lock(&q->lock);
+        q->run_seq++;
+
+        if (q->notify) {
+            /* c is a copy, so the entry can be reused before the callback */
+            q->reap_seq++;
+            pthread_mutex_unlock(&q->lock);
+            q->notify(q->notify_ctx, &c);
+            pthread_mutex_lock(&q->lock);
+        } else {
+            queue_fd_signal(q);
+        }
+    }
+    pthread_mutex_unlock(&q->lock);
+
+    return NULL;
+}
+
+/*============================================================================
+ * Lifecycle
+ *============================================================================*/
+
+cr_queue_t* cr_queue_create(cr_state_t* st, int capacity) {
+    if (!st || capacity <= 0) {
+        return NULL;
+    }
+
+    cr_queue_t* q = calloc(1, sizeof(*q));
+    if (!q) {
+        return NULL;
+    }
+
+    q->st = st;
+    q->capacity = capacity;
+    q->ring = calloc(capacity, sizeof(cr_queue_entry_t));
+    if (!q->ring) {
+        free(q);
+        return NULL;
+    }
+
+    if (queue_fd_open(q) != 0) {
+        free(q->ring);
+        free(q);
+        return NULL;
+    }
+
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->work, NULL);
+
+    if (pthread_create(&q->worker, NULL, queue_worker, q) != 0) {
+        pthread_cond_destroy(&q->work);
+        pthread_mutex_destroy(&q->lock);
+        queue_fd_close(q);
+        free(q->ring);
+        free(q);
+        return NULL;
+    }
+
+    return q;
+}
+
+void cr_queue_destroy(cr_queue_t* q) {
+    if (!q) {
+        return;
+    }
+
+    pthread_mutex_lock(&q->lock);
+    q->stopping = 1;
+    pthread_cond_signal(&q->work);
+    pthread_mutex_unlock(&q->lock);
+
+    pthread_join(q->worker, NULL);
+
+    pthread_cond_destroy(&q->work);
+    pthread_mutex_destroy(&q->lock);
+    queue_fd_close(q);
+    free(q->ring);
+    free(q);
+}
+
+int cr_queue_fd(const cr_queue_t* q) {
+    if (!q) {
+        return -1;
+    }
+    return q->fds[0];
+}
+
+int cr_queue_set_notify(cr_queue_t* q, cr_notify_fn fn, void* ctx) {
+    if (!q) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&q->lock);
+    int idle = (q->submit_seq == q->reap_seq);
+    if (idle) {
+        q->notify = fn;
+        q->notify_ctx = ctx;
+    }
+    pthread_mutex_unlock(&q->lock);
+
+    return idle ? 0 : -1;
+}
+
+/*============================================================================
+ * Submission
+ *============================================================================*/
+
+static int queue_push(cr_queue_t* q, const cr_queue_entry_t* e) {
+    pthread_mutex_lock(&q->lock);
+
+    if (q->stopping || q->submit_seq - q->reap_seq >= (unsigned long long)q->capacity) {
+        pthread_mutex_unlock(&q->lock);
+        return -1;
+    }
+
+    q->ring[q->submit_seq % q->capacity] = *e;
+    q->submit_seq++;
+    pthread_cond_signal(&q->work);
+
+    pthread_mutex_unlock(&q->lock);
+    return 0;
+}
+
+int cr_queue_submit_update(
+    cr_queue_t* q,
+    const float* embeddings,
+    int count,
+    int stride,
+    int dim,
+    float delta_t,
+    unsigned long long tag
+) {
+    if (!q || (!embeddings && count > 0) || count < 0) {
+        return -1;
+    }
+    if (dim != q->st->rt->dim || stride < dim || delta_t <= 0.0f) {
+        return -1;
+    }
+
+    cr_queue_entry_t e = {0};
+    e.op = CR_OP_UPDATE;
+    e.data = embeddings;
+    e.count = count;
+    e.stride = stride;
+    e.delta_t = delta_t;
+    e.tag = tag;
+
+    return queue_push(q, &e);
+}
+
+int cr_queue_submit_query(
+    cr_queue_t* q,
+    const float* queries,
+    int count,
+    int stride,
+    int dim,
+    cr_hint_t* out_hints,
+    float* out_vectors,
+    unsigned long long tag
+) {
+    if (!q || !out_hints || (!queries && count > 0) || count < 0) {
+        return -1;
+    }
+    if (dim != q->st->rt->dim || stride < dim) {
+        return -1;
+    }
+
+    cr_queue_entry_t e = {0};
+    e.op = CR_OP_QUERY;
+    e.data = queries;
+    e.count = count;
+    e.stride = stride;
+    e.hints = out_hints;
+    e.vectors = out_vectors;
+    e.tag = tag;
+
+    return queue_push(q, &e);
+}
+
+int cr_queue_submit_save(
+    cr_queue_t* q,
+    const char* path,
+    unsigned long long tag
+) {
+    if (!q || !path) {
+        return -1;
+    }
+
+    size_t len = strlen(path) + 1;
+    cr_queue_entry_t e = {0};
+    e.op = CR_OP_SAVE;
+    e.path = malloc(len);
+    e.tag = tag;
+    if (!e.path) {
+        return -1;
+    }
+    memcpy(e.path, path, len);
+
+    if (queue_push(q, &e) != 0) {
+        free(e.path);
+        return -1;
+    }
+    return 0;
+}
+
+/*============================================================================
+ * Completion
+ *============================================================================*/
+
+int cr_queue_poll(cr_queue_t* q, cr_completion_t* out, int max) {
+    if (!q || !out || max < 0) {
+        return -1;
+    }
+
+    /* Clear first: a completion racing with us re-arms the descriptor */
+    queue_fd_clear(q);
+
+    pthread_mutex_lock(&q->lock);
+    int n = 0;
+    while (n < max && q->reap_seq < q->run_seq) {
+        const cr_queue_entry_t* e = &q->ring[q->reap_seq % q->capacity];
+        out[n].tag = e->tag;
+        out[n].op = e->op;
+        out[n].status = e->status;
+        q->reap_seq++;
+        n++;
+    }
+    int left = q->reap_seq < q->run_seq;
+    pthread_mutex_unlock(&q->lock);
+
+    /* More than max were ready: keep the descriptor readable for the rest */
+    if (left) {
+        queue_fd_signal(q);
+    }
+
+    return n;
+}
+
+#else /* No POSIX threads: asynchronous submission unavailable */
+
+cr_queue_t* cr_queue_create(cr_state_t* st, int capacity) {
+    (void)st;
+    (void)capacity;
+    return NULL;
+}
+
+void cr_queue_destroy(cr_queue_t* q) {
+    (void)q;
+}
+
+int cr_queue_fd(const cr_queue_t* q) {
+    (void)q;
+    return -1;
+}
+
+int cr_queue_set_notify(cr_queue_t* q, cr_notify_fn fn, void* ctx) {
+    (void)q;
+    (void)fn;
+    (void)ctx;
+    return -1;
+}
+
+int cr_queue_submit_update(cr_queue_t* q, const float* embeddings, int count,
+                           int stride, int dim, float delta_t,
+                           unsigned long long tag) {
+    (void)q; (void)embeddings; (void)count; (void)stride;
+    (void)dim; (void)delta_t; (void)tag;
+    return -1;
+}
+
+int cr_queue_submit_query(cr_queue_t* q, const float* queries, int count,
+                          int stride, int dim, cr_hint_t* out_hints,
+                          float* out_vectors, unsigned long long tag) {
+    (void)q; (void)queries; (void)count; (void)stride;
+    (void)dim; (void)out_hints; (void)out_vectors; (void)tag;
+    return -1;
+}
+
+int cr_queue_submit_save(cr_queue_t* q, const char* path,
+                         unsigned long long tag) {
+    (void)q; (void)path; (void)tag;
+    return -1;
+}
+
+int cr_queue_poll(cr_queue_t* q, cr_completion_t* out, int max) {
+    (void)q; (void)out; (void)max;
+    return -1;
+}
+
+#endif
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file cr_expiry.c
+ * @brief Sliding-window memory
+ *
+ * A state with a horizon forgets every invariant that has not been
+ * created or reinforced within the last horizon of age. The recency
+ * list (cr_recency.c) is already ordered by that age, so the slots due
+ * to expire are exactly a run at its tail: each update pops them until
+ * the tail is recent enough. A slot expires at most once per creation,
+ * so the cost is amortized O(1) per update and nothing is ever swept.
+ *
+ * Removal keeps slots dense by moving the last slot into the hole, so
+ * each expiry is O(1) as well (quota eviction compacts instead, because
+ * it removes many slots at once).
+ */
+
+#include <string.h>
+#include "cr.h"
+#include "cr_internal.h"
+
+/* Remove one slot; the last slot takes its index */
+static void expiry_remove(cr_state_t* st, int slot) {
+    int last = st->slot_count - 1;
+    cr_recency_unlink(st, slot);
+    cr_index_remove(st, slot);
+    cr_tier_drop(st, slot);
+
+    if (slot != last) {
+        cr_slot_t* to = &st->slots[slot];
+        const cr_slot_t* from = &st->slots[last];
+        if (st->tier) {
+            cr_tier_move(st, last, slot);
+        } else {
+            memcpy(to->vector, from->vector, sizeof(float) * st->rt->dim);
+        }
+        to->weight = from->weight;
+        to->last_access = from->last_access;
+        to->reinforced_age = from->reinforced_age;
+        cr_index_move(st, last, slot);
+        cr_recency_move(st, last, slot);
+    }
+
+    /* Rows past slot_count must stay zero */
+    cr_slot_t* s = &st->slots[last];
+    if (!st->tier) {
+        memset(s->vector, 0, sizeof(float) * st->rt->dim);
+    }
+    s->weight = 0.0f;
+    s->last_access = 0;
+    s->reinforced_age = 0.0;
+    st->slot_count = last;
+}
+
+CR_INTERNAL int cr_expiry_run(cr_state_t* st, double now) {
+    if (st->horizon <= 0.0) {
+        return 0;
+    }
+
+    int n = 0;
+    while (st->recent_tail >= 0 &&
+           now - st->slots[st->recent_tail].reinforced_age > st->horizon) {
+        expiry_remove(st, st->recent_tail);
+        n++;
+    }
+    st->expired += (unsigned long long)n;
+    return n;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+int cr_state_set_horizon(cr_state_t* st, double horizon) {
+    if (!st || !(horizon >= 0.0)) {
+        return -1;
+    }
+    if (cr_pool_enter(st) != 0) {
+        return -1;
+    }
+
+    st->horizon = horizon;
+    cr_expiry_run(st, st->age);
+
+    cr_pool_leave(st);
+    return 0;
+}
+
+int cr_state_expiry(const cr_state_t* st, cr_expiry_stats_t* out) {
+    if (!st || !out) {
+        return -1;
+    }
+
+    out->horizon = st->horizon;
+    out->expired = st->expired;
+    return 0;
+}
@@ -0,0 +1,351 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file cr_index.c
+ * @brief Slot index: flat scan or two-level (coarse-to-fine) memory
+ *
+ * Flat memory compares an embedding against every occupied slot.
+ *
+ * Two-level memory groups slots into buckets, each summarized by the sum
+ * of its members. A lookup ranks the summaries, then scans only the
+ * coarse_probe best buckets. A new slot joins the bucket whose summary
+ * it matches best, or founds a new bucket when no summary is similar
+ * enough (CR_SIM_THRESHOLD) and a coarse slot is free. Reinforcement
+ * moves a slot's vector, so its summary is adjusted by the difference.
+ *
+ * Tiered states (cr_tier.c) are scanned the same way, except that cold
+ * slots are estimated from their sketch and only promising ones are read.
+ *
+ * Everything is a pure function of the update sequence: no randomness,
+ * no training phase. The index is derived data and is rebuilt on load.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cr.h"
+#include "cr_internal.h"
+
+/*============================================================================
+ * Lifecycle
+ *============================================================================*/
+
+CR_INTERNAL int cr_index_create(cr_state_t* st) {
+    const cr_runtime_t* rt = st->rt;
+    if (rt->coarse_slots == 0 || st->index_dropped) {
+        return 0;
+    }
+
+    st->coarse = calloc(rt->coarse_slots, sizeof(cr_coarse_t));
+    st->coarse_arena = calloc((size_t)rt->coarse_slots * rt->dim, sizeof(float));
+    st->probe = calloc(rt->coarse_probe, sizeof(int));
+    st->probe_sim = calloc(rt->coarse_probe, sizeof(float));
+    if (!st->coarse || !st->coarse_arena || !st->probe || !st->probe_sim) {
+        cr_index_destroy(st);
+        return -1;
+    }
+
+    for (int c = 0; c < rt->coarse_slots; c++) {
+        st->coarse[c].sum = st->coarse_arena + (size_t)c * rt->dim;
+    }
+    cr_index_clear(st);
+
+    return 0;
+}
+
+CR_INTERNAL void cr_index_destroy(cr_state_t* st) {
+    free(st->coarse);
+    free(st->coarse_arena);
+    free(st->probe);
+    free(st->probe_sim);
+    st->coarse = NULL;
+    st->coarse_arena = NULL;
+    st->probe = NULL;
+    st->probe_sim = NULL;
+    st->coarse_count = 0;
+}
+
+CR_INTERNAL void cr_index_clear(cr_state_t* st) {
+    for (int i = 0; i < st->slot_count; i++) {
+        st->slots[i].coarse = -1;
+        st->slots[i].next = -1;
+    }
+    if (!st->coarse) {
+        return;
+    }
+
+    /* Only summaries in use can be non-zero */
+    for (int c = 0; c < st->coarse_count; c++) {
+        memset(st->coarse[c].sum, 0, sizeof(float) * st->rt->dim);
+    }
+    for (int c = 0; c < st->rt->coarse_slots; c++) {
+        st->coarse[c].head = -1;
+        st->coarse[c].count = 0;
+    }
+    st->coarse_count = 0;
+}
+
+CR_INTERNAL void cr_index_rebuild(cr_state_t* st) {
+    cr_index_clear(st);
+    for (int i = 0; i < st->slot_count; i++) {
+        cr_index_insert(st, i);
+    }
+}
+
+/*============================================================================
+ * Lookup
+ *============================================================================*/
+
+/*
+ * Rank coarse summaries against the embedding, keeping the best
+ * coarse_probe in st->probe (descending). Returns how many were kept.
+ */
+static int index_rank_coarse(cr_state_t* st, const float* embedding, int dim, int keep) {
+    int n = 0;
+
+    for (int c = 0; c < st->coarse_count; c++) {
+        float sim = cr_cosine_similarity(embedding, st->coarse[c].sum, dim);
+        if (n == keep && sim <= st->probe_sim[n - 1]) {
+            continue;
+        }
+
+        /* Insertion into the short sorted list; ties keep the earlier bucket */
+        int pos = n < keep ? n++ : keep - 1;
+        while (pos > 0 && sim > st->probe_sim[pos - 1]) {
+            st->probe[pos] = st->probe[pos - 1];
+            st->probe_sim[pos] = st->probe_sim[pos - 1];
+            pos--;
+        }
+        st->probe[pos] = c;
+        st->probe_sim[pos] = sim;
+    }
+
+    return n;
+}
+
+/*
+ * Tiered states: cold slots are ranked by sketch estimate and only the
+ * best few are read. One is skipped when its estimate trails the best
+ * exact similarity by more than the sketch error can explain.
+ */
+#define INDEX_COLD_VERIFY 4
+#define INDEX_SKETCH_SLACK 0.02f
+
+typedef struct {
+    cr_slot_t* best;
+    float best_sim;
+    float norm;                         /* ||embedding||, tiered only */
+    int cold_count;
+    int cold[INDEX_COLD_VERIFY];        /* Descending by estimate */
+    float cold_est[INDEX_COLD_VERIFY];
+} index_scan_t;
+
+static void index_consider(cr_state_t* st, index_scan_t* sc,
+                           const float* embedding, int dim, int i) {
+    int cold = st->tier && st->slots[i].hot < 0;
+    if (cold && st->tier->sketch) {
+        float est = cr_tier_estimate(st, i, embedding, sc->norm);
+        if (sc->cold_count == INDEX_COLD_VERIFY &&
+            est <= sc->cold_est[INDEX_COLD_VERIFY - 1]) {
+            return;
+        }
+        int pos = sc->cold_count < INDEX_COLD_VERIFY ? sc->cold_count++
+                                                     : INDEX_COLD_VERIFY - 1;
+        while (pos > 0 && est > sc->cold_est[pos - 1]) {
+            sc->cold[pos] = sc->cold[pos - 1];
+            sc->cold_est[pos] = sc->cold_est[pos - 1];
+            pos--;
+        }
+        sc->cold[pos] = i;
+        sc->cold_est[pos] = est;
+        return;
+    }
+
+    if (cold) {
+        cr_tier_touch(st, i);  /* Sketches released: read the row itself */
+    }
+    float sim = cr_cosine_similarity(embedding, st->slots[i].vector, dim);
+    if (sim > sc->best_sim) {
+        sc->best_sim = sim;
+        sc->best = &st->slots[i];
+    }
+}
+
+CR_INTERNAL cr_slot_t* cr_index_match(cr_state_t* st, const float* embedding,
+                                      int dim, float* out_sim) {
+    index_scan_t sc;
+    sc.best = NULL;
+    sc.best_sim = 0.0f;
+    sc.cold_count = 0;
+    sc.norm = 0.0f;
+
+    unsigned long long now = cr_tier_tick(st);
+    if (st->tier) {
+        for (int i = 0; i < dim; i++) {
+            sc.norm += embedding[i] * embedding[i];
+        }
+        sc.norm = sqrtf(sc.norm);
+    }
+
+    if (!st->coarse) {
+        for (int i = 0; i < st->slot_count; i++) {
+            index_consider(st, &sc, embedding, dim, i);
+        }
+    } else {
+        int probed = index_rank_coarse(st, embedding, dim, st->rt->coarse_probe);
+        for (int p = 0; p < probed; p++) {
+            for (int i = st->coarse[st->probe[p]].head; i >= 0; i = st->slots[i].next) {
+                index_consider(st, &sc, embedding, dim, i);
+            }
+        }
+    }
+
+    /* Confirm cold candidates against their stored rows */
+    for (int c = 0; c < sc.cold_count; c++) {
+        if (sc.cold_est[c] < sc.best_sim - INDEX_SKETCH_SLACK) {
+            break;
+        }
+        int i = sc.cold[c];
+        cr_tier_touch(st, i);
+        float sim = cr_cosine_similarity(embedding, st->slots[i].vector, dim);
+        if (sim > sc.best_sim) {
+            sc.best_sim = sim;
+            sc.best = &st->slots[i];
+        }
+    }
+
+    if (sc.best) {
+        if (sc.best->hot < 0) {
+            cr_tier_promote(st, (int)(sc.best - st->slots));
+        }
+        sc.best->last_access = now;
+    }
+
+    *out_sim = sc.best_sim;
+    return sc.best;
+}
+
+/*============================================================================
+ * Maintenance
+ *============================================================================*/
+
+static void index_sum_add(float* sum, const float* v, int dim) {
+    for (int i = 0; i < dim; i++) {
+        sum[i] += v[i];
+    }
+}
+
+static void index_sum_sub(float* sum, const float* v, int dim) {
+    for (int i = 0; i < dim; i++) {
+        sum[i] -= v[i];
+    }
+}
+
+CR_INTERNAL void cr_index_insert(cr_state_t* st, int slot) {
+    cr_slot_t* s = &st->slots[slot];
+    s->coarse = -1;
+    s->next = -1;
+    if (!st->coarse) {
+        return;
+    }
+
+    int dim = st->rt->dim;
+    int c;
+    if (index_rank_coarse(st, s->vector, dim, 1) == 0 ||
+        (st->probe_sim[0] <= CR_SIM_THRESHOLD &&
+         st->coarse_count < st->rt->coarse_slots)) {
+        c = st->coarse_count++;  /* Found a new bucket */
+    } else {
+        c = st->probe[0];
+    }
+
+    cr_coarse_t* b = &st->coarse[c];
+    s->coarse = c;
+    s->next = b->head;
+    b->head = slot;
+    b->count++;
+    index_sum_add(b->sum, s->vector, dim);
+}
+
+CR_INTERNAL void cr_index_retract(cr_state_t* st, const cr_slot_t* slot) {
+    if (st->coarse && slot->coarse >= 0) {
+        index_sum_sub(st->coarse[slot->coarse].sum, slot->vector, st->rt->dim);
+    }
+}
+
+CR_INTERNAL void cr_index_commit(cr_state_t* st, const cr_slot_t* slot) {
+    if (st->coarse && slot->coarse >= 0) {
+        index_sum_add(st->coarse[slot->coarse].sum, slot->vector, st->rt->dim);
+    }
+}
+
+/*
+ * Buckets are singly linked, so unlinking walks one bucket: no more than
+ * a lookup scans. A bucket that empties takes the last bucket's place,
+ * so founding new buckets works as before.
+ */
+static int* index_link_to(cr_state_t* st, int slot) {
+    int* link = &st->coarse[st->slots[slot].coarse].head;
+    while (*link != slot) {
+        link = &st->slots[*link].next;
+    }
+    return link;
+}
+
+static void index_drop_bucket(cr_state_t* st, int c) {
+    int last = --st->coarse_count;
+    cr_coarse_t* b = &st->coarse[c];
+    if (c != last) {
+        cr_coarse_t* m = &st->coarse[last];
+        memcpy(b->sum, m->sum, sizeof(float) * st->rt->dim);
+        b->head = m->head;
+        b->count = m->count;
+        for (int i = b->head; i >= 0; i = st->slots[i].next) {
+            st->slots[i].coarse = c;
+        }
+        b = m;
+    }
+    memset(b->sum, 0, sizeof(float) * st->rt->dim);
+    b->head = -1;
+    b->count = 0;
+}
+
+CR_INTERNAL void cr_index_remove(cr_state_t* st, int slot) {
+    cr_slot_t* s = &st->slots[slot];
+    if (st->coarse && s->coarse >= 0) {
+        cr_coarse_t* b = &st->coarse[s->coarse];
+        *index_link_to(st, slot) = s->next;
+        index_sum_sub(b->sum, s->vector, st->rt->dim);
+        if (--b->count == 0) {
+            index_drop_bucket(st, s->coarse);
+        }
+    }
+    s->coarse = -1;
+    s->next = -1;
+}
+
+CR_INTERNAL void cr_index_move(cr_state_t* st, int from, int to) {
+    cr_slot_t* f = &st->slots[from];
+    cr_slot_t* t = &st->slots[to];
+    t->coarse = f->coarse;
+    t->next = f->next;
+    if (st->coarse && f->coarse >= 0) {
+        *index_link_to(st, from) = to;
+    }
+    f->coarse = -1;
+    f->next = -1;
+}
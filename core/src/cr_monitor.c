@@ -0,0 +1,354 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file cr_monitor.c
+ * @brief Memory pressure monitor (Linux PSI)
+ *
+ * The monitor thread only maintains one atomic pressure level. States
+ * compare against it when they are next used (cr_monitor_apply, called
+ * from the pin hook of every public call that touches slot memory), so
+ * all releasing and rebuilding happens on the thread that owns the
+ * state at that moment.
+ *
+ * Pressure starts with a PSI event (trigger mode) or an avg10 sample at
+ * or above stall/window (sampling mode), and ends after quiet_ms
+ * without either.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include "cr.h"
+#include "cr_internal.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MONITOR_DEFAULT_PATH "/proc/pressure/memory"
+
+struct cr_monitor {
+    int fd;                     /**< PSI file, -1 for manual monitors */
+    int triggered;              /**< fd is a PSI trigger (else sampled) */
+    float threshold;            /**< avg10 percentage when sampling */
+    int window_ms;
+    int quiet_ms;
+    cr_pressure_fn notify;
+    void* notify_ctx;
+
+    pthread_t thread;
+    int running;
+    int wake[2];                /**< Self-pipe that stops the thread */
+
+    atomic_int pressure;
+    atomic_ullong events;
+    atomic_ullong samples;
+    atomic_ullong releases;
+    atomic_ullong rebuilds;
+};
+
+/*============================================================================
+ * States
+ *============================================================================*/
+
+static void monitor_release(cr_state_t* st) {
+    cr_index_destroy(st);
+    cr_index_clear(st);
+    cr_tier_release_sketch(st);
+    cr_tier_drop_cache(st);
+    st->pressure_released = 1;
+    atomic_fetch_add(&st->monitor->releases, 1);
+}
+
+static void monitor_rebuild(cr_state_t* st) {
+    /* Best effort: without them lookups are slower, not wrong */
+    if (!st->coarse && cr_index_create(st) == 0) {
+        cr_index_rebuild(st);
+    }
+    cr_tier_restore_sketch(st);
+    st->pressure_released = 0;
+    atomic_fetch_add(&st->monitor->rebuilds, 1);
+}
+
+CR_INTERNAL void cr_monitor_apply(cr_state_t* st) {
+    cr_monitor_t* mon = st->monitor;
+    if (!mon || !st->slots) {
+        return;
+    }
+
+    int pressure = atomic_load_explicit(&mon->pressure, memory_order_relaxed);
+    if (pressure && !st->pressure_released) {
+        monitor_release(st);
+    } else if (!pressure && st->pressure_released) {
+        monitor_rebuild(st);
+    }
+}
+
+int cr_monitor_add(cr_monitor_t* mon, cr_state_t* st) {
+    if (!mon || !st || st->monitor) {
+        return -1;
+    }
+    st->monitor = mon;
+    return 0;
+}
+
+int cr_monitor_remove(cr_monitor_t* mon, cr_state_t* st) {
+    if (!mon || !st || st->monitor != mon) {
+        return -1;
+    }
+    if (st->pressure_released) {
+        monitor_rebuild(st);
+    }
+    st->monitor = NULL;
+    return 0;
+}
+
+/*============================================================================
+ * Monitor Thread
+ *============================================================================*/
+
+static void monitor_set(cr_monitor_t* mon, int pressure) {
+    if (atomic_exchange(&mon->pressure, pressure) != pressure && mon->notify) {
+        mon->notify(mon->notify_ctx, pressure);
+    }
+}
+
+static double monitor_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* "some avg10=1.23 avg60=... total=..." */
+static int monitor_sample(cr_monitor_t* mon) {
+    char buf[256];
+    ssize_t n = pread(mon->fd, buf, sizeof(buf) - 1, 0);
+    if (n <= 0) {
+        return 0;
+    }
+    buf[n] = '\0';
+    atomic_fetch_add(&mon->samples, 1);
+
+    float avg10;
+    if (sscanf(buf, "some avg10=%f", &avg10) != 1) {
+        return 0;
+    }
+    return avg10 >= mon->threshold;
+}
+
+static void* monitor_main(void* arg) {
+    cr_monitor_t* mon = arg;
+    struct pollfd fds[2];
+    fds[0].fd = mon->fd;
+    fds[0].events = POLLPRI;
+    fds[0].revents = 0;
+    fds[1].fd = mon->wake[0];
+    fds[1].events = POLLIN;
+
+    /* A PSI file without a trigger always polls POLLERR, so sampling
+     * waits on the wake pipe alone and reads the file on each timeout */
+    struct pollfd* watch = mon->triggered ? fds : fds + 1;
+    nfds_t nfds = mon->triggered ? 2 : 1;
+    int timeout = mon->triggered ? mon->quiet_ms : mon->window_ms;
+    double last_stall = 0.0;
+
+    for (;;) {
+        int n = poll(watch, nfds, timeout);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (fds[1].revents) {
+            break;  /* Destroy */
+        }
+        if (fds[0].revents & (POLLERR | POLLNVAL)) {
+            break;  /* Trigger gone (e.g. cgroup removed) */
+        }
+
+        int stalled = mon->triggered ? (fds[0].revents & POLLPRI) != 0
+                                     : monitor_sample(mon);
+        double now = monitor_now();
+        if (stalled) {
+            last_stall = now;
+            atomic_fetch_add(&mon->events, 1);
+            monitor_set(mon, 1);
+        } else if (now - last_stall >= mon->quiet_ms / 1000.0) {
+            monitor_set(mon, 0);
+        }
+    }
+
+    return NULL;
+}
+
+/*============================================================================
+ * Lifecycle
+ *============================================================================*/
+
+static int monitor_open(cr_monitor_t* mon, const cr_monitor_config_t* cfg) {
+    const char* path = cfg->path ? cfg->path : MONITOR_DEFAULT_PATH;
+    int stall_us = cfg->stall_us > 0 ? cfg->stall_us : 150000;
+    int window_us = cfg->window_us > 0 ? cfg->window_us : 1000000;
+    if (stall_us > window_us) {
+        return -1;
+    }
+
+    mon->window_ms = window_us / 1000 > 0 ? window_us / 1000 : 1;
+    mon->quiet_ms = cfg->quiet_ms > 0 ? cfg->quiet_ms : 10000;
+    mon->threshold = 100.0f * (float)stall_us / (float)window_us;
+    mon->notify = cfg->notify;
+    mon->notify_ctx = cfg->notify_ctx;
+
+    /* Triggers need a writable descriptor; sampling works read-only */
+    char trigger[64];
+    int len = snprintf(trigger, sizeof(trigger), "some %d %d", stall_us, window_us);
+    mon->fd = open(path, O_RDWR | O_NONBLOCK);
+    if (mon->fd >= 0 && write(mon->fd, trigger, (size_t)len + 1) == len + 1) {
+        mon->triggered = 1;
+        return 0;
+    }
+    if (mon->fd >= 0) {
+        close(mon->fd);
+    }
+    mon->fd = open(path, O_RDONLY);
+    return mon->fd >= 0 ? 0 : -1;
+}
+
+cr_monitor_t* cr_monitor_create(const cr_monitor_config_t* cfg) {
+    cr_monitor_t* mon = calloc(1, sizeof(*mon));
+    if (!mon) {
+        return NULL;
+    }
+    mon->fd = -1;
+    mon->wake[0] = -1;
+    mon->wake[1] = -1;
+    atomic_init(&mon->pressure, 0);
+    atomic_init(&mon->events, 0);
+    atomic_init(&mon->samples, 0);
+    atomic_init(&mon->releases, 0);
+    atomic_init(&mon->rebuilds, 0);
+
+    if (!cfg) {
+        return mon;  /* Manual */
+    }
+
+    if (monitor_open(mon, cfg) != 0 || pipe(mon->wake) != 0) {
+        cr_monitor_destroy(mon);
+        return NULL;
+    }
+    if (pthread_create(&mon->thread, NULL, monitor_main, mon) != 0) {
+        cr_monitor_destroy(mon);
+        return NULL;
+    }
+    mon->running = 1;
+
+    return mon;
+}
+
+void cr_monitor_destroy(cr_monitor_t* mon) {
+    if (!mon) {
+        return;
+    }
+
+    if (mon->running) {
+        char c = 0;
+        while (write(mon->wake[1], &c, 1) < 0 && errno == EINTR) {
+        }
+        pthread_join(mon->thread, NULL);
+    }
+    for (int i = 0; i < 2; i++) {
+        if (mon->wake[i] >= 0) {
+            close(mon->wake[i]);
+        }
+    }
+    if (mon->fd >= 0) {
+        close(mon->fd);
+    }
+    free(mon);
+}
+
+int cr_monitor_signal(cr_monitor_t* mon, int pressure) {
+    if (!mon) {
+        return -1;
+    }
+    if (pressure) {
+        atomic_fetch_add(&mon->events, 1);
+    }
+    monitor_set(mon, pressure != 0);
+    return 0;
+}
+
+int cr_monitor_stats(const cr_monitor_t* mon, cr_monitor_stats_t* out) {
+    if (!mon || !out) {
+        return -1;
+    }
+
+    cr_monitor_t* m = (cr_monitor_t*)mon;  /* Atomic loads take non-const */
+    out->pressure = atomic_load(&m->pressure);
+    out->triggered = m->triggered;
+    out->events = atomic_load(&m->events);
+    out->samples = atomic_load(&m->samples);
+    out->releases = atomic_load(&m->releases);
+    out->rebuilds = atomic_load(&m->rebuilds);
+
+    return 0;
+}
+
+#else /* Non-POSIX: no monitors, so no state is ever attached */
+
+CR_INTERNAL void cr_monitor_apply(cr_state_t* st) {
+    (void)st;
+}
+
+cr_monitor_t* cr_monitor_create(const cr_monitor_config_t* cfg) {
+    (void)cfg;
+    return NULL;
+}
+
+void cr_monitor_destroy(cr_monitor_t* mon) {
+    (void)mon;
+}
+
+int cr_monitor_add(cr_monitor_t* mon, cr_state_t* st) {
+    (void)mon; (void)st;
+    return -1;
+}
+
+int cr_monitor_remove(cr_monitor_t* mon, cr_state_t* st) {
+    (void)mon; (void)st;
+    return -1;
+}
+
+int cr_monitor_signal(cr_monitor_t* mon, int pressure) {
+    (void)mon; (void)pressure;
+    return -1;
+}
+
+int cr_monitor_stats(const cr_monitor_t* mon, cr_monitor_stats_t* out) {
+    (void)mon; (void)out;
+    return -1;
+}
+
+#endif
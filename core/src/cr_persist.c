@@ -22,24 +22,31 @@
  *
  * Header (16 bytes):
  *   - magic: uint32 (0x4D494E44 = "MIND")
- *   - version: uint32 (1)
+ *   - version: uint32 (3)
  *   - dim: int32
  *   - max_slots: int32
  *
  * State (variable):
  *   - slot_count: int32
  *   - plasticity: float32
- *   - age: float32
+ *   - age: float64
  *   - plasticity_prev: float32
  *   - velocity: float32
- *   - last_reinforcement_age: float32
- *   - total_updates: int32
- *   - total_reinforcements: int32
+ *   - last_reinforcement_age: float64
+ *   - total_updates: int64
+ *   - total_reinforcements: int64
  *
- * Slots (slot_count × (dim × 4 + 4) bytes):
+ * Version 1 files, where age and last_reinforcement_age are float32 and
+ * the counters int32, are still read.
+ *
+ * Slots (slot_count × (dim × 4 + 12) bytes):
  *   For each occupied slot:
  *     - vector: float32[dim]
  *     - weight: float32
+ *     - reinforced_age: float64
+ *
+ * Versions 1 and 2 have no reinforced_age; their slots are read as
+ * reinforced at the saved age, in slot order.
  *
  * Note: This format is not optimized for size. Future versions may
  * add compression or more efficient encoding while maintaining
@@ -48,125 +55,252 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
 #include "cr.h"
 #include "cr_internal.h"
 
-/**
- * @brief Save state to file
+/*
+ * Everything written goes through one sink, so the digest covers
+ * exactly the bytes a save would write.
  */
-int cr_state_save(cr_state_t* st, const char* path) {
-    if (!st || !path) {
-        return -1;
-    }
+#define PERSIST_FNV_OFFSET 0xcbf29ce484222325ULL
+#define PERSIST_FNV_PRIME 0x100000001b3ULL
 
-    FILE* f = fopen(path, "wb");
-    if (!f) {
-        return -1;
+typedef struct {
+    FILE* f;            /**< Stream, or NULL to hash */
+    uint64_t hash;      /**< FNV-1a 64 of everything put so far */
+} persist_sink_t;
+
+static int persist_put(persist_sink_t* s, const void* p, size_t size, size_t n) {
+    if (s->f) {
+        return fwrite(p, size, n, s->f) == n ? 0 : -1;
+    }
+    const unsigned char* b = p;
+    for (size_t i = 0; i < size * n; i++) {
+        s->hash = (s->hash ^ b[i]) * PERSIST_FNV_PRIME;
     }
+    return 0;
+}
 
+static int persist_emit(const cr_state_t* st, persist_sink_t* sink) {
     /* Write header */
     uint32_t magic = CR_MAGIC;
     uint32_t version = CR_PERSIST_VERSION;
     int32_t dim = st->rt->dim;
     int32_t max_slots = st->rt->max_slots;
 
-    if (fwrite(&magic, sizeof(magic), 1, f) != 1) goto error;
-    if (fwrite(&version, sizeof(version), 1, f) != 1) goto error;
-    if (fwrite(&dim, sizeof(dim), 1, f) != 1) goto error;
-    if (fwrite(&max_slots, sizeof(max_slots), 1, f) != 1) goto error;
+    if (persist_put(sink, &magic, sizeof(magic), 1) != 0) return -1;
+    if (persist_put(sink, &version, sizeof(version), 1) != 0) return -1;
+    if (persist_put(sink, &dim, sizeof(dim), 1) != 0) return -1;
+    if (persist_put(sink, &max_slots, sizeof(max_slots), 1) != 0) return -1;
 
     /* Write state */
     int32_t slot_count = st->slot_count;
-    int32_t total_updates = st->total_updates;
-    int32_t total_reinforcements = st->total_reinforcements;
-
-    if (fwrite(&slot_count, sizeof(slot_count), 1, f) != 1) goto error;
-    if (fwrite(&st->plasticity, sizeof(float), 1, f) != 1) goto error;
-    if (fwrite(&st->age, sizeof(float), 1, f) != 1) goto error;
-    if (fwrite(&st->plasticity_prev, sizeof(float), 1, f) != 1) goto error;
-    if (fwrite(&st->velocity, sizeof(float), 1, f) != 1) goto error;
-    if (fwrite(&st->last_reinforcement_age, sizeof(float), 1, f) != 1) goto error;
-    if (fwrite(&total_updates, sizeof(total_updates), 1, f) != 1) goto error;
-    if (fwrite(&total_reinforcements, sizeof(total_reinforcements), 1, f) != 1) goto error;
-
-    /* Write occupied slots */
+    int64_t total_updates = st->total_updates;
+    int64_t total_reinforcements = st->total_reinforcements;
+
+    if (persist_put(sink, &slot_count, sizeof(slot_count), 1) != 0) return -1;
+    if (persist_put(sink, &st->plasticity, sizeof(float), 1) != 0) return -1;
+    if (persist_put(sink, &st->age, sizeof(double), 1) != 0) return -1;
+    if (persist_put(sink, &st->plasticity_prev, sizeof(float), 1) != 0) return -1;
+    if (persist_put(sink, &st->velocity, sizeof(float), 1) != 0) return -1;
+    if (persist_put(sink, &st->last_reinforcement_age, sizeof(double), 1) != 0) return -1;
+    if (persist_put(sink, &total_updates, sizeof(total_updates), 1) != 0) return -1;
+    if (persist_put(sink, &total_reinforcements, sizeof(total_reinforcements), 1) != 0) return -1;
+
+    /* Write occupied slots (decayed weights, so files are scale-free) */
     for (int i = 0; i < st->slot_count; i++) {
-        if (fwrite(st->slots[i].vector, sizeof(float), dim, f) != (size_t)dim) goto error;
-        if (fwrite(&st->slots[i].weight, sizeof(float), 1, f) != 1) goto error;
+        float weight = cr_slot_weight(st, &st->slots[i]);
+        if (persist_put(sink, st->slots[i].vector, sizeof(float), dim) != 0) return -1;
+        if (persist_put(sink, &weight, sizeof(float), 1) != 0) return -1;
+        if (persist_put(sink, &st->slots[i].reinforced_age, sizeof(double), 1) != 0) return -1;
     }
 
-    fclose(f);
     return 0;
-
-error:
-    fclose(f);
-    return -1;
 }
 
 /**
- * @brief Load state from file
+ * @brief Write state to an open stream
  */
-int cr_state_load(cr_state_t* st, const char* path) {
-    if (!st || !path) {
-        return -1;
+CR_INTERNAL int cr_persist_write(const cr_state_t* st, FILE* f) {
+    persist_sink_t sink = {f, 0};
+    return persist_emit(st, &sink);
+}
+
+/* Version 1 stored ages as float32 and counters as int32 */
+static int persist_read_age(double* out, uint32_t version, FILE* f) {
+    if (version == 1) {
+        float v;
+        if (fread(&v, sizeof(v), 1, f) != 1) return -1;
+        *out = v;
+        return 0;
     }
+    return fread(out, sizeof(double), 1, f) == 1 ? 0 : -1;
+}
 
-    FILE* f = fopen(path, "rb");
-    if (!f) {
-        return -1;
+static int persist_read_count(int64_t* out, uint32_t version, FILE* f) {
+    if (version == 1) {
+        int32_t v;
+        if (fread(&v, sizeof(v), 1, f) != 1) return -1;
+        *out = v;
+        return 0;
     }
+    return fread(out, sizeof(int64_t), 1, f) == 1 ? 0 : -1;
+}
 
+/**
+ * @brief Read state from an open stream
+ */
+CR_INTERNAL int cr_persist_read(cr_state_t* st, FILE* f) {
     /* Read and verify header */
     uint32_t magic, version;
     int32_t dim, max_slots;
 
-    if (fread(&magic, sizeof(magic), 1, f) != 1) goto error;
-    if (fread(&version, sizeof(version), 1, f) != 1) goto error;
-    if (fread(&dim, sizeof(dim), 1, f) != 1) goto error;
-    if (fread(&max_slots, sizeof(max_slots), 1, f) != 1) goto error;
+    if (fread(&magic, sizeof(magic), 1, f) != 1) return -1;
+    if (fread(&version, sizeof(version), 1, f) != 1) return -1;
+    if (fread(&dim, sizeof(dim), 1, f) != 1) return -1;
+    if (fread(&max_slots, sizeof(max_slots), 1, f) != 1) return -1;
 
     /* Validate header */
     if (magic != CR_MAGIC) {
-        goto error;  /* Not a MIND state file */
+        return -1;  /* Not a MIND state file */
     }
-    if (version != CR_PERSIST_VERSION) {
-        goto error;  /* Incompatible version */
+    if (version < 1 || version > CR_PERSIST_VERSION) {
+        return -1;  /* Incompatible version */
     }
     if (dim != st->rt->dim || max_slots != st->rt->max_slots) {
-        goto error;  /* Configuration mismatch */
+        return -1;  /* Configuration mismatch */
     }
 
     /* Read state */
-    int32_t slot_count, total_updates, total_reinforcements;
+    int32_t slot_count;
+    int64_t total_updates, total_reinforcements;
 
     if (fread(&slot_count, sizeof(slot_count), 1, f) != 1) goto error;
     if (fread(&st->plasticity, sizeof(float), 1, f) != 1) goto error;
-    if (fread(&st->age, sizeof(float), 1, f) != 1) goto error;
+    if (persist_read_age(&st->age, version, f) != 0) goto error;
     if (fread(&st->plasticity_prev, sizeof(float), 1, f) != 1) goto error;
     if (fread(&st->velocity, sizeof(float), 1, f) != 1) goto error;
-    if (fread(&st->last_reinforcement_age, sizeof(float), 1, f) != 1) goto error;
-    if (fread(&total_updates, sizeof(total_updates), 1, f) != 1) goto error;
-    if (fread(&total_reinforcements, sizeof(total_reinforcements), 1, f) != 1) goto error;
+    if (persist_read_age(&st->last_reinforcement_age, version, f) != 0) goto error;
+    if (persist_read_count(&total_updates, version, f) != 0) goto error;
+    if (persist_read_count(&total_reinforcements, version, f) != 0) goto error;
 
-    st->slot_count = slot_count;
-    st->total_updates = total_updates;
-    st->total_reinforcements = total_reinforcements;
+    if (slot_count < 0 || slot_count > st->rt->max_slots) {
+        goto error;
+    }
+    if (cr_state_reserve(st, slot_count) != 0) {
+        goto error;
+    }
 
-    /* Clear existing slots */
+    /* Clear existing slots (rows past slot_count must stay zero) */
+    for (int i = slot_count; i < st->slot_count; i++) {
+        memset(st->slots[i].vector, 0, sizeof(float) * dim);
+    }
     for (int i = 0; i < st->rt->max_slots; i++) {
         st->slots[i].weight = 0.0f;
+        st->slots[i].reinforced_age = 0.0;
     }
+    cr_recency_clear(st);
+
+    st->slot_count = slot_count;
+    st->total_updates = total_updates;
+    st->total_reinforcements = total_reinforcements;
+    st->weight_log = 0.0;
+    st->weight_scale = 1.0;
 
     /* Read slots */
+    cr_tier_layout(st, slot_count);
     for (int i = 0; i < slot_count; i++) {
         if (fread(st->slots[i].vector, sizeof(float), dim, f) != (size_t)dim) goto error;
         if (fread(&st->slots[i].weight, sizeof(float), 1, f) != 1) goto error;
+        if (version < 3) {
+            st->slots[i].reinforced_age = st->age;
+        } else if (fread(&st->slots[i].reinforced_age, sizeof(double), 1, f) != 1) {
+            goto error;
+        }
     }
 
-    fclose(f);
+    /* Sketches, the slot index and the recency list are derived data */
+    cr_tier_rebuild(st);
+    cr_index_rebuild(st);
+    cr_recency_rebuild(st);
     return 0;
 
 error:
-    fclose(f);
+    cr_tier_rebuild(st);   /* Keep derived data consistent with what was read */
+    cr_index_rebuild(st);
+    cr_recency_rebuild(st);
     return -1;
 }
+
+/**
+ * @brief Save state to file
+ */
+int cr_state_save(cr_state_t* st, const char* path) {
+    if (!st || !path) {
+        return -1;
+    }
+    if (cr_pool_enter(st) != 0) {
+        return -1;
+    }
+
+    int rc = -1;
+    FILE* f = fopen(path, "wb");
+    if (f) {
+        rc = cr_persist_write(st, f);
+        if (fclose(f) != 0) {
+            rc = -1;
+        }
+    }
+
+    cr_pool_leave(st);
+    return rc;
+}
+
+/**
+ * @brief Load state from file
+ */
+int cr_state_load(cr_state_t* st, const char* path) {
+    if (!st || !path) {
+        return -1;
+    }
+    if (cr_pool_enter(st) != 0) {
+        return -1;
+    }
+
+    int rc = -1;
+    FILE* f = fopen(path, "rb");
+    if (f) {
+        rc = cr_persist_read(st, f);
+        fclose(f);
+    }
+    if (rc == 0) {
+        cr_temporal_clear(st);  /* Rolling statistics are not saved */
+        cr_expiry_run(st, st->age);
+    }
+    if (rc == 0 && st->quota) {
+        cr_quota_enforce(st, CR_DEGRADE_EVICT);
+    }
+
+    cr_pool_leave(st);
+    return rc;
+}
+
+/**
+ * @brief Digest of the state as it would be saved
+ */
+int cr_state_digest(cr_state_t* st, unsigned long long* out) {
+    if (!st || !out) {
+        return -1;
+    }
+    if (cr_pool_enter(st) != 0) {
+        return -1;
+    }
+
+    persist_sink_t sink = {NULL, PERSIST_FNV_OFFSET};
+    persist_emit(st, &sink);
+    *out = sink.hash;
+
+    cr_pool_leave(st);
+    return 0;
+}
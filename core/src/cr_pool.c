@@ -0,0 +1,567 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file cr_pool.c
+ * @brief State pools with idle hibernation
+ *
+ * Every pooled state carries a member record. Public calls that touch
+ * slot memory pin the state (cr_pool_enter/cr_pool_leave); the sweep
+ * only hibernates unpinned states idle for at least the TTL.
+ *
+ * Hibernation writes the persistence format (cr_persist.c) to an
+ * open_memstream() image or a file, then frees slots, arena and index.
+ * The first caller to pin a hibernated state revives it outside the
+ * member lock while later callers wait on the member condition, so a
+ * burst of calls costs one revival.
+ *
+ * Lock order: pool lock, then member lock. Revival takes the pool lock
+ * only after releasing the member lock.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include "cr.h"
+#include "cr_internal.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+struct cr_pool_member {
+    cr_pool_t* pool;
+    cr_state_t* st;
+    cr_pool_member_t* prev;
+    cr_pool_member_t* next;
+
+    pthread_mutex_t lock;
+    pthread_cond_t revived;     /**< Signalled when a revival finishes */
+    int pins;                   /**< Public calls in progress */
+    int hibernated;
+    int reviving;               /**< A caller is reviving the state */
+    double last_used;           /**< Monotonic seconds */
+
+    char* image;                /**< In-memory image, or */
+    size_t image_size;
+    char* path;                 /**< hibernation file */
+    unsigned long long image_bytes;
+};
+
+struct cr_pool {
+    pthread_mutex_t lock;       /**< Member list and counters */
+    double ttl;
+    char* dir;                  /**< NULL: images stay in memory */
+    unsigned long long quota;   /**< 0 = unlimited */
+
+    cr_pool_member_t* head;
+    int members;
+    int hibernated;
+    unsigned long long hibernations;
+    unsigned long long revivals;
+    unsigned long long image_bytes;
+};
+
+static double pool_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/*============================================================================
+ * Hibernation Images
+ *============================================================================*/
+
+static void pool_drop_image(cr_pool_member_t* m) {
+    if (m->path) {
+        remove(m->path);
+        free(m->path);
+        m->path = NULL;
+    }
+    free(m->image);
+    m->image = NULL;
+    m->image_size = 0;
+    m->image_bytes = 0;
+}
+
+static FILE* pool_create_file(cr_pool_t* pool, cr_pool_member_t* m) {
+    size_t len = strlen(pool->dir) + sizeof("/mind-pool-XXXXXX");
+    m->path = malloc(len);
+    if (!m->path) {
+        return NULL;
+    }
+    strcpy(m->path, pool->dir);
+    strcat(m->path, "/mind-pool-XXXXXX");
+
+    int fd = mkstemp(m->path);
+    if (fd < 0) {
+        free(m->path);
+        m->path = NULL;
+        return NULL;
+    }
+    FILE* f = fdopen(fd, "wb");
+    if (!f) {
+        close(fd);
+    }
+    return f;
+}
+
+/* Pool and member locks held */
+static int pool_hibernate(cr_pool_t* pool, cr_pool_member_t* m) {
+    FILE* f = pool->dir ? pool_create_file(pool, m)
+                        : open_memstream(&m->image, &m->image_size);
+
+    int rc = f ? cr_persist_write(m->st, f) : -1;
+    if (f) {
+        long end = ftell(f);
+        if (fclose(f) != 0 || end < 0) {
+            rc = -1;
+        }
+        m->image_bytes = end > 0 ? (unsigned long long)end : 0;
+    }
+    if (rc != 0) {
+        pool_drop_image(m);
+        return -1;
+    }
+
+    cr_state_release(m->st);
+    m->hibernated = 1;
+    pool->hibernated++;
+    pool->hibernations++;
+    pool->image_bytes += m->image_bytes;
+    return 0;
+}
+
+/* No locks held; the member is marked reviving */
+static int pool_revive(cr_pool_member_t* m) {
+    cr_state_t* st = m->st;
+    if (cr_state_alloc(st) != 0) {
+        return -1;
+    }
+
+    FILE* f = m->path ? fopen(m->path, "rb")
+                      : fmemopen(m->image, m->image_size, "rb");
+    int rc = f ? cr_persist_read(st, f) : -1;
+    if (f) {
+        fclose(f);
+    }
+    if (rc != 0) {
+        cr_state_release(st);
+        return -1;
+    }
+
+    cr_pool_t* pool = m->pool;
+    if (pool) {
+        pthread_mutex_lock(&pool->lock);
+        pool->hibernated--;
+        pool->revivals++;
+        pool->image_bytes -= m->image_bytes;
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    pool_drop_image(m);
+    return 0;
+}
+
+/*============================================================================
+ * Pinning
+ *============================================================================*/
+
+static int pool_pin(cr_pool_member_t* m) {
+    pthread_mutex_lock(&m->lock);
+    while (m->reviving) {
+        pthread_cond_wait(&m->revived, &m->lock);
+    }
+    if (m->hibernated) {
+        m->reviving = 1;
+        pthread_mutex_unlock(&m->lock);
+        int rc = pool_revive(m);
+        pthread_mutex_lock(&m->lock);
+
+        m->reviving = 0;
+        if (rc == 0) {
+            m->hibernated = 0;
+        }
+        pthread_cond_broadcast(&m->revived);
+        if (rc != 0) {
+            pthread_mutex_unlock(&m->lock);
+            return -1;  /* Image kept; a later call retries */
+        }
+    }
+    m->pins++;
+    pthread_mutex_unlock(&m->lock);
+
+    return 0;
+}
+
+CR_INTERNAL int cr_pool_enter(cr_state_t* st) {
+    if (st->member && pool_pin(st->member) != 0) {
+        return -1;
+    }
+    cr_monitor_apply(st);
+    return 0;
+}
+
+CR_INTERNAL void cr_pool_leave(cr_state_t* st) {
+    cr_pool_member_t* m = st->member;
+    if (!m) {
+        return;
+    }
+
+    pthread_mutex_lock(&m->lock);
+    m->pins--;
+    m->last_used = pool_now();
+    pthread_mutex_unlock(&m->lock);
+}
+
+/*============================================================================
+ * Membership
+ *============================================================================*/
+
+/* Pool lock held */
+static void pool_link(cr_pool_t* pool, cr_pool_member_t* m) {
+    m->prev = NULL;
+    m->next = pool->head;
+    if (pool->head) {
+        pool->head->prev = m;
+    }
+    pool->head = m;
+    pool->members++;
+}
+
+/* Pool lock held */
+static void pool_unlink(cr_pool_t* pool, cr_pool_member_t* m) {
+    if (m->prev) {
+        m->prev->next = m->next;
+    } else {
+        pool->head = m->next;
+    }
+    if (m->next) {
+        m->next->prev = m->prev;
+    }
+    pool->members--;
+}
+
+static void pool_member_free(cr_pool_member_t* m) {
+    m->st->member = NULL;
+    pool_drop_image(m);
+    pthread_cond_destroy(&m->revived);
+    pthread_mutex_destroy(&m->lock);
+    free(m);
+}
+
+CR_INTERNAL void cr_pool_forget(cr_state_t* st) {
+    cr_pool_member_t* m = st->member;
+    if (!m) {
+        return;
+    }
+
+    cr_pool_t* pool = m->pool;
+    if (pool) {
+        pthread_mutex_lock(&pool->lock);
+        pool_unlink(pool, m);
+        if (m->hibernated) {
+            pool->hibernated--;
+            pool->image_bytes -= m->image_bytes;
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    pool_member_free(m);
+}
+
+int cr_pool_add(cr_pool_t* pool, cr_state_t* st) {
+    if (!pool || !st) {
+        return -1;
+    }
+    /* Left hibernated by cr_pool_destroy(): revive it, then drop the record */
+    if (st->member && !st->member->pool) {
+        if (cr_pool_enter(st) != 0) {
+            return -1;
+        }
+        cr_pool_leave(st);
+        pool_member_free(st->member);
+    }
+    if (st->member || st->tier) {
+        return -1;
+    }
+
+    cr_pool_member_t* m = calloc(1, sizeof(*m));
+    if (!m) {
+        return -1;
+    }
+    if (pthread_mutex_init(&m->lock, NULL) != 0) {
+        free(m);
+        return -1;
+    }
+    if (pthread_cond_init(&m->revived, NULL) != 0) {
+        pthread_mutex_destroy(&m->lock);
+        free(m);
+        return -1;
+    }
+    m->pool = pool;
+    m->st = st;
+    m->last_used = pool_now();
+
+    pthread_mutex_lock(&pool->lock);
+    pool_link(pool, m);
+    st->member = m;
+    pthread_mutex_unlock(&pool->lock);
+
+    return 0;
+}
+
+int cr_pool_remove(cr_pool_t* pool, cr_state_t* st) {
+    if (!pool || !st || !st->member || st->member->pool != pool) {
+        return -1;
+    }
+    cr_pool_member_t* m = st->member;
+
+    /* Unlink first so a concurrent sweep cannot hibernate it again */
+    pthread_mutex_lock(&pool->lock);
+    pool_unlink(pool, m);
+    pthread_mutex_unlock(&pool->lock);
+
+    if (cr_pool_enter(st) != 0) {
+        pthread_mutex_lock(&pool->lock);
+        pool_link(pool, m);
+        pthread_mutex_unlock(&pool->lock);
+        return -1;
+    }
+    cr_pool_leave(st);
+
+    pool_member_free(m);
+    return 0;
+}
+
+/*============================================================================
+ * Lifecycle
+ *============================================================================*/
+
+cr_pool_t* cr_pool_create(double ttl_seconds, const char* dir) {
+    if (!(ttl_seconds >= 0.0)) {
+        return NULL;
+    }
+
+    cr_pool_t* pool = calloc(1, sizeof(*pool));
+    if (!pool) {
+        return NULL;
+    }
+    if (dir) {
+        pool->dir = malloc(strlen(dir) + 1);
+        if (!pool->dir) {
+            free(pool);
+            return NULL;
+        }
+        strcpy(pool->dir, dir);
+    }
+    if (pthread_mutex_init(&pool->lock, NULL) != 0) {
+        free(pool->dir);
+        free(pool);
+        return NULL;
+    }
+    pool->ttl = ttl_seconds;
+
+    return pool;
+}
+
+void cr_pool_destroy(cr_pool_t* pool) {
+    if (!pool) {
+        return;
+    }
+
+    while (pool->head) {
+        cr_pool_member_t* m = pool->head;
+        if (cr_pool_remove(pool, m->st) != 0) {
+            /* Revival failed: detach it still hibernated, with its image,
+             * so its next call retries the revival */
+            pthread_mutex_lock(&pool->lock);
+            pool_unlink(pool, m);
+            pool->hibernated--;
+            pool->image_bytes -= m->image_bytes;
+            m->pool = NULL;
+            pthread_mutex_unlock(&pool->lock);
+        }
+    }
+
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->dir);
+    free(pool);
+}
+
+typedef struct {
+    double last_used;
+    unsigned long long bytes;
+    cr_pool_member_t* m;
+} pool_rank_t;
+
+static int pool_rank_cmp(const void* a, const void* b) {
+    const pool_rank_t* x = a;
+    const pool_rank_t* y = b;
+    return (x->last_used > y->last_used) - (x->last_used < y->last_used);
+}
+
+static int pool_idle(const cr_pool_member_t* m) {
+    return !m->hibernated && !m->reviving && m->pins == 0;
+}
+
+/* Pool lock held: hibernate least recently used members until in quota */
+static int pool_fit_quota(cr_pool_t* pool) {
+    pool_rank_t* rank = malloc(sizeof(pool_rank_t) * (pool->members ? pool->members : 1));
+    if (!rank) {
+        return 0;
+    }
+
+    /* Members in use are not counted: they cannot be hibernated anyway */
+    unsigned long long total = pool->dir ? 0 : pool->image_bytes;
+    int n = 0;
+    for (cr_pool_member_t* m = pool->head; m; m = m->next) {
+        pthread_mutex_lock(&m->lock);
+        if (pool_idle(m)) {
+            rank[n].last_used = m->last_used;
+            rank[n].bytes = cr_quota_bytes(m->st);
+            rank[n].m = m;
+            total += rank[n].bytes;
+            n++;
+        }
+        pthread_mutex_unlock(&m->lock);
+    }
+    qsort(rank, n, sizeof(pool_rank_t), pool_rank_cmp);
+
+    int count = 0;
+    for (int i = 0; i < n && total > pool->quota; i++) {
+        cr_pool_member_t* m = rank[i].m;
+        pthread_mutex_lock(&m->lock);
+        if (pool_idle(m) && pool_hibernate(pool, m) == 0) {
+            total -= rank[i].bytes;
+            if (!pool->dir) {
+                total += m->image_bytes;
+            }
+            count++;
+        }
+        pthread_mutex_unlock(&m->lock);
+    }
+
+    free(rank);
+    return count;
+}
+
+int cr_pool_set_quota(cr_pool_t* pool, unsigned long long bytes) {
+    if (!pool) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->quota = bytes;
+    pthread_mutex_unlock(&pool->lock);
+
+    return 0;
+}
+
+int cr_pool_sweep(cr_pool_t* pool) {
+    if (!pool) {
+        return -1;
+    }
+
+    int count = 0;
+    pthread_mutex_lock(&pool->lock);
+    double now = pool_now();
+    for (cr_pool_member_t* m = pool->head; m; m = m->next) {
+        pthread_mutex_lock(&m->lock);
+        if (pool_idle(m) && now - m->last_used >= pool->ttl &&
+            pool_hibernate(pool, m) == 0) {
+            count++;
+        }
+        pthread_mutex_unlock(&m->lock);
+    }
+    if (pool->quota) {
+        count += pool_fit_quota(pool);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return count;
+}
+
+int cr_pool_stats(cr_pool_t* pool, cr_pool_stats_t* out) {
+    if (!pool || !out) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    out->members = pool->members;
+    out->hibernated = pool->hibernated;
+    out->hibernations = pool->hibernations;
+    out->revivals = pool->revivals;
+    out->image_bytes = pool->image_bytes;
+    pthread_mutex_unlock(&pool->lock);
+
+    return 0;
+}
+
+#else /* Non-POSIX: pools are unavailable, so no state is ever a member */
+
+CR_INTERNAL int cr_pool_enter(cr_state_t* st) {
+    cr_monitor_apply(st);
+    return 0;
+}
+
+CR_INTERNAL void cr_pool_leave(cr_state_t* st) {
+    (void)st;
+}
+
+CR_INTERNAL void cr_pool_forget(cr_state_t* st) {
+    (void)st;
+}
+
+cr_pool_t* cr_pool_create(double ttl_seconds, const char* dir) {
+    (void)ttl_seconds;
+    (void)dir;
+    return NULL;
+}
+
+void cr_pool_destroy(cr_pool_t* pool) {
+    (void)pool;
+}
+
+int cr_pool_add(cr_pool_t* pool, cr_state_t* st) {
+    (void)pool; (void)st;
+    return -1;
+}
+
+int cr_pool_remove(cr_pool_t* pool, cr_state_t* st) {
+    (void)pool; (void)st;
+    return -1;
+}
+
+int cr_pool_set_quota(cr_pool_t* pool, unsigned long long bytes) {
+    (void)pool; (void)bytes;
+    return -1;
+}
+
+int cr_pool_sweep(cr_pool_t* pool) {
+    (void)pool;
+    return -1;
+}
+
+int cr_pool_stats(cr_pool_t* pool, cr_pool_stats_t* out) {
+    (void)pool; (void)out;
+    return -1;
+}
+
+#endif
@@ -44,42 +44,22 @@
  *
  * Crucially: confidence is NEVER asserted, only computed.
  */
-int cr_state_query(
+static void state_hint(
     cr_state_t* st,
     const float* query,
     int dim,
     cr_hint_t* out
 ) {
-    /* Validate inputs */
-    if (!st || !query || !out) {
-        return -1;
-    }
-    if (dim != st->rt->dim) {
-        return -1;
-    }
-
     /* Find closest invariant */
-    cr_slot_t* best = NULL;
-    float best_sim = 0.0f;
-
-    for (int i = 0; i < st->slot_count; i++) {
-        float sim = cr_cosine_similarity(
-            query,
-            st->slots[i].vector,
-            dim
-        );
-        if (sim > best_sim) {
-            best_sim = sim;
-            best = &st->slots[i];
-        }
-    }
+    float best_sim;
+    cr_slot_t* best = cr_index_match(st, query, dim, &best_sim);
 
     /* Handle empty state */
     if (!best) {
         out->vector = NULL;
         out->dim = 0;
         out->confidence = 0.0f;
-        return 0;
+        return;
     }
 
     /*
@@ -96,11 +76,76 @@ int cr_state_query(
      * Final confidence is the product of all three factors.
      */
     float stability = 1.0f - st->plasticity;
-    float weight_factor = best->weight / (best->weight + 1.0f);
+    float weight = cr_slot_weight(st, best);
+    float weight_factor = weight / (weight + 1.0f);
 
     out->vector = best->vector;
     out->dim = dim;
     out->confidence = best_sim * stability * weight_factor;
+}
+
+int cr_state_query(
+    cr_state_t* st,
+    const float* query,
+    int dim,
+    cr_hint_t* out
+) {
+    /* Validate inputs */
+    if (!st || !query || !out) {
+        return -1;
+    }
+    if (dim != st->rt->dim) {
+        return -1;
+    }
+
+    if (cr_pool_enter(st) != 0) {
+        return -1;  /* Hibernated and could not be revived */
+    }
+    state_hint(st, query, dim, out);
+    if (st->quota) {
+        cr_quota_enforce(st, CR_DEGRADE_CACHES);  /* Keeps hint vectors valid */
+    }
+    cr_pool_leave(st);
+
+    return 0;
+}
+
+/**
+ * @brief Query state for a batch of hints
+ *
+ * Queries do not change invariants, so each row is answered against the
+ * same memory. They do move rows between tiers, so slab rows matched
+ * earlier in the batch are pinned until it ends: every hint vector still
+ * shows its own invariant when the call returns.
+ */
+int cr_state_query_batch(
+    cr_state_t* st,
+    const float* queries,
+    int count,
+    int stride,
+    int dim,
+    cr_hint_t* out
+) {
+    /* Validate inputs */
+    if (!st || !out || (!queries && count > 0)) {
+        return -1;
+    }
+    if (dim != st->rt->dim || stride < dim || count < 0) {
+        return -1;
+    }
+
+    if (cr_pool_enter(st) != 0) {
+        return -1;
+    }
+    cr_tier_pin(st);
+    for (int i = 0; i < count; i++) {
+        state_hint(st, queries + (size_t)i * stride, dim, &out[i]);
+    }
+    cr_tier_unpin(st);
+    if (st->quota) {
+        cr_quota_enforce(st, CR_DEGRADE_CACHES);
+    }
+    cr_pool_leave(st);
 
     return 0;
 }
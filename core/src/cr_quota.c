@@ -0,0 +1,323 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file cr_quota.c
+ * @brief Byte quotas and the degradation ladder
+ *
+ * A state's footprint is computed from its shape, not measured, so the
+ * check after every new invariant is O(1). Over quota, the state walks
+ * the ladder and stops at the first step that brings it back under:
+ *
+ *   1 caches    release cached pages of the cold tier
+ *   2 quantize  move slots to the cold tier, where RAM keeps only an
+ *               int8 sketch per slot (tiers untiered states; shrinks
+ *               the hot slab of tiered ones)
+ *   3 index     release the two-level index; lookups scan flat
+ *   4 evict     drop the least reinforced invariants, newest first on
+ *               ties, until 1/16 of the room above the fixed floor is
+ *               free, so the next few new invariants do not evict again
+ *
+ * Steps 2-4 move or drop slot contents, so they only run on the update
+ * path, where hint vectors are already invalidated.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "cr.h"
+#include "cr_internal.h"
+
+/*============================================================================
+ * Accounting
+ *============================================================================*/
+
+CR_INTERNAL unsigned long long cr_quota_bytes(const cr_state_t* st) {
+    const cr_runtime_t* rt = st->rt;
+    unsigned long long row = (unsigned long long)rt->dim * sizeof(float);
+    unsigned long long b = sizeof(cr_state_t);
+
+    if (!st->slots) {
+        return b;  /* Hibernated */
+    }
+    b += (unsigned long long)rt->max_slots * sizeof(cr_slot_t);
+
+    if (st->coarse) {
+        b += (unsigned long long)rt->coarse_slots * (sizeof(cr_coarse_t) + row);
+        b += (unsigned long long)rt->coarse_probe * (sizeof(int) + sizeof(float));
+    }
+
+    const cr_tier_t* t = st->tier;
+    if (t) {
+        b += sizeof(cr_tier_t);
+        b += (unsigned long long)t->hot_slots * (row + sizeof(int));
+        b += (unsigned long long)rt->max_slots * (2 * sizeof(float) + 1);
+        if (t->sketch) {
+            b += (unsigned long long)st->slot_count * rt->dim; /* Sketches */
+        }
+        b += (unsigned long long)t->resident_count * row;      /* Cached cold rows */
+    } else {
+        b += (unsigned long long)st->slot_count * row;         /* Arena rows in use */
+    }
+
+    return b;
+}
+
+static int quota_fits(const cr_state_t* st) {
+    return cr_quota_bytes(st) <= st->quota;
+}
+
+/*
+ * Smallest footprint the ladder can reach while keeping one invariant:
+ * the slot table is sized by max_slots and never shrinks, and a tier,
+ * once made, keeps its bookkeeping and at least one hot row.
+ */
+static unsigned long long quota_floor(const cr_state_t* st) {
+    const cr_runtime_t* rt = st->rt;
+    unsigned long long row = (unsigned long long)rt->dim * sizeof(float);
+    unsigned long long b = sizeof(cr_state_t);
+
+    b += (unsigned long long)rt->max_slots * sizeof(cr_slot_t);
+    if (st->tier) {
+        b += sizeof(cr_tier_t);
+        b += row + sizeof(int);
+        b += (unsigned long long)rt->max_slots * (2 * sizeof(float) + 1);
+        b += (unsigned long long)rt->dim;   /* One sketch */
+    } else {
+        b += row;
+    }
+    return b;
+}
+
+/*============================================================================
+ * Ladder
+ *============================================================================*/
+
+/* Hot rows that fit once everything else is paid for (0 if not even one) */
+static int quota_hot_rows(const cr_state_t* st) {
+    const cr_runtime_t* rt = st->rt;
+    unsigned long long row = (unsigned long long)rt->dim * sizeof(float);
+    unsigned long long fixed = cr_quota_bytes(st);
+
+    /* Footprint of a tiered state with an empty slab and nothing cached */
+    if (st->tier) {
+        fixed -= (unsigned long long)st->tier->hot_slots * (row + sizeof(int));
+        fixed -= (unsigned long long)st->tier->resident_count * row;
+    } else {
+        fixed -= (unsigned long long)st->slot_count * row;
+        fixed += sizeof(cr_tier_t);
+        fixed += (unsigned long long)rt->max_slots * (2 * sizeof(float) + 1);
+        fixed += (unsigned long long)st->slot_count * rt->dim;
+    }
+
+    if (fixed >= st->quota) {
+        return 0;
+    }
+    unsigned long long rows = (st->quota - fixed) / (row + sizeof(int));
+    return rows > (unsigned long long)rt->max_slots ? rt->max_slots : (int)rows;
+}
+
+static int quota_quantize(cr_state_t* st) {
+    int hot = quota_hot_rows(st);
+
+    if (st->tier) {
+        if (hot >= st->tier->hot_slots) {
+            hot = st->tier->hot_slots / 2;
+        }
+        if (hot < 1) {
+            hot = 1;
+        }
+        if (cr_tier_shrink(st, hot) != 0) {
+            return -1;
+        }
+    } else {
+        /* Pooled states hibernate instead of tiering; tiering must leave
+         * room for a hot row, or it only adds bookkeeping */
+        if (st->member || st->slot_count < 2 || hot < 1) {
+            return -1;
+        }
+        if (hot >= st->slot_count) {
+            hot = st->slot_count / 2;
+        }
+        if (cr_state_tier(st, hot, NULL) != 0) {
+            return -1;
+        }
+    }
+
+    /* Demotion wrote the cold rows through the page cache */
+    cr_tier_drop_cache(st);
+    return 0;
+}
+
+typedef struct {
+    float weight;
+    int slot;
+} quota_rank_t;
+
+/* Least reinforced first; among equals, the newest */
+static int quota_rank_cmp(const void* a, const void* b) {
+    const quota_rank_t* x = a;
+    const quota_rank_t* y = b;
+    if (x->weight != y->weight) {
+        return x->weight < y->weight ? -1 : 1;
+    }
+    return y->slot - x->slot;
+}
+
+static int quota_evict(cr_state_t* st) {
+    int count = st->slot_count;
+    int dim = st->rt->dim;
+    if (count == 0) {
+        return -1;
+    }
+
+    /* Enough slots to free 1/16 of what the quota leaves above the
+     * floor; below the floor are fixed costs no eviction can save */
+    unsigned long long bytes = cr_quota_bytes(st);
+    unsigned long long floor = quota_floor(st);
+    unsigned long long target = st->quota > floor
+        ? st->quota - (st->quota - floor) / 16 : floor;
+    unsigned long long per_slot = st->tier ? (unsigned long long)dim
+                                           : (unsigned long long)dim * sizeof(float);
+    unsigned long long over = bytes > target ? bytes - target : 0;
+    unsigned long long need = (over + per_slot - 1) / per_slot;
+    int n = need > (unsigned long long)count - 1 ? count - 1 : (int)need;
+    if (n < 1) {
+        return -1;
+    }
+
+    quota_rank_t* rank = malloc(sizeof(quota_rank_t) * count);
+    unsigned char* gone = calloc(count, 1);
+    if (!rank || !gone) {
+        free(rank);
+        free(gone);
+        return -1;
+    }
+    for (int i = 0; i < count; i++) {
+        rank[i].weight = st->slots[i].weight;
+        rank[i].slot = i;
+    }
+    qsort(rank, count, sizeof(quota_rank_t), quota_rank_cmp);
+    for (int i = 0; i < n; i++) {
+        gone[rank[i].slot] = 1;
+    }
+
+    /* Compact survivors in order, so slot order stays creation order */
+    int w = 0;
+    for (int i = 0; i < count; i++) {
+        if (gone[i]) {
+            continue;
+        }
+        if (w != i) {
+            cr_slot_t* to = &st->slots[w];
+            const cr_slot_t* from = &st->slots[i];
+            memcpy(to->vector, from->vector, sizeof(float) * dim);
+            to->weight = from->weight;
+            to->last_access = from->last_access;
+            to->reinforced_age = from->reinforced_age;
+        }
+        w++;
+    }
+    for (int i = w; i < count; i++) {
+        cr_tier_drop(st, i);
+        if (!st->tier) {
+            memset(st->slots[i].vector, 0, sizeof(float) * dim);
+        }
+        st->slots[i].weight = 0.0f;
+        st->slots[i].last_access = 0;
+        st->slots[i].reinforced_age = 0.0;
+        st->slots[i].newer = -1;
+        st->slots[i].older = -1;
+    }
+    st->slot_count = w;
+    st->quota_evicted += (unsigned long long)n;
+
+    free(rank);
+    free(gone);
+
+    cr_tier_rebuild(st);
+    cr_index_rebuild(st);
+    cr_recency_rebuild(st);
+    cr_tier_drop_cache(st);
+    return 0;
+}
+
+CR_INTERNAL int cr_quota_enforce(cr_state_t* st, int max_step) {
+    if (!st->quota || !st->slots || quota_fits(st)) {
+        return CR_DEGRADE_NONE;
+    }
+
+    int step = CR_DEGRADE_NONE;
+    st->quota_enforcements++;
+
+    if (cr_tier_drop_cache(st) == 0) {
+        step = CR_DEGRADE_CACHES;
+    }
+    if (!quota_fits(st) && max_step >= CR_DEGRADE_QUANTIZE &&
+        quota_quantize(st) == 0) {
+        step = CR_DEGRADE_QUANTIZE;
+    }
+    if (!quota_fits(st) && max_step >= CR_DEGRADE_INDEX && st->coarse) {
+        cr_index_destroy(st);
+        cr_index_clear(st);
+        st->index_dropped = 1;
+        step = CR_DEGRADE_INDEX;
+    }
+    if (!quota_fits(st) && max_step >= CR_DEGRADE_EVICT &&
+        quota_evict(st) == 0) {
+        step = CR_DEGRADE_EVICT;
+    }
+
+    st->quota_step = step;
+    return step;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+int cr_state_set_quota(cr_state_t* st, unsigned long long bytes) {
+    if (!st) {
+        return -1;
+    }
+    if (cr_pool_enter(st) != 0) {
+        return -1;
+    }
+    if (bytes && bytes < quota_floor(st)) {
+        cr_pool_leave(st);
+        return -1;
+    }
+
+    st->quota = bytes;
+    st->quota_step = CR_DEGRADE_NONE;
+    int step = cr_quota_enforce(st, CR_DEGRADE_EVICT);
+
+    cr_pool_leave(st);
+    return step;
+}
+
+int cr_state_quota(const cr_state_t* st, cr_quota_stats_t* out) {
+    if (!st || !out) {
+        return -1;
+    }
+
+    out->quota = st->quota;
+    out->bytes = cr_quota_bytes(st);
+    out->step = st->quota_step;
+    out->enforcements = st->quota_enforcements;
+    out->evicted = st->quota_evicted;
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file cr_recency.c
+ * @brief Slots ordered by when they were last reinforced
+ *
+ * Every creation or reinforcement stamps the slot with the current age,
+ * and age never decreases. So the newest stamp always belongs at the
+ * head, and an intrusive doubly linked list through the slots stays
+ * sorted with O(1) work per update. No wheel or heap is needed:
+ *
+ *   least recently reinforced   recent_tail                 O(1)
+ *   reinforced within T         walk from recent_head       O(answers)
+ *
+ * The list is only rebuilt (by sorting) when slots move: compaction,
+ * load and split.
+ */
+
+#include <stdlib.h>
+#include "cr.h"
+#include "cr_internal.h"
+
+/*============================================================================
+ * List
+ *============================================================================*/
+
+CR_INTERNAL void cr_recency_unlink(cr_state_t* st, int slot) {
+    cr_slot_t* s = &st->slots[slot];
+    if (s->newer >= 0) {
+        st->slots[s->newer].older = s->older;
+    } else if (st->recent_head == slot) {
+        st->recent_head = s->older;
+    } else {
+        return;  /* Not linked */
+    }
+    if (s->older >= 0) {
+        st->slots[s->older].newer = s->newer;
+    } else {
+        st->recent_tail = s->newer;
+    }
+    s->newer = -1;
+    s->older = -1;
+}
+
+static void recency_push(cr_state_t* st, int slot) {
+    cr_slot_t* s = &st->slots[slot];
+    s->newer = -1;
+    s->older = st->recent_head;
+    if (st->recent_head >= 0) {
+        st->slots[st->recent_head].newer = slot;
+    } else {
+        st->recent_tail = slot;
+    }
+    st->recent_head = slot;
+}
+
+CR_INTERNAL void cr_recency_touch(cr_state_t* st, int slot, double age) {
+    cr_recency_unlink(st, slot);
+    st->slots[slot].reinforced_age = age;
+    recency_push(st, slot);
+}
+
+CR_INTERNAL void cr_recency_move(cr_state_t* st, int from, int to) {
+    cr_slot_t* f = &st->slots[from];
+    cr_slot_t* t = &st->slots[to];
+    t->newer = f->newer;
+    t->older = f->older;
+    if (f->newer >= 0) {
+        st->slots[f->newer].older = to;
+    } else if (st->recent_head == from) {
+        st->recent_head = to;
+    }
+    if (f->older >= 0) {
+        st->slots[f->older].newer = to;
+    } else if (st->recent_tail == from) {
+        st->recent_tail = to;
+    }
+    f->newer = -1;
+    f->older = -1;
+}
+
+CR_INTERNAL void cr_recency_clear(cr_state_t* st) {
+    for (int i = 0; i < st->slot_count; i++) {
+        st->slots[i].newer = -1;
+        st->slots[i].older = -1;
+    }
+    st->recent_head = -1;
+    st->recent_tail = -1;
+}
+
+typedef struct {
+    double age;
+    int slot;
+} recency_key_t;
+
+/* Oldest first; equal ages in slot (creation) order */
+static int recency_cmp(const void* a, const void* b) {
+    const recency_key_t* x = a;
+    const recency_key_t* y = b;
+    if (x->age != y->age) {
+        return x->age < y->age ? -1 : 1;
+    }
+    return x->slot - y->slot;
+}
+
+CR_INTERNAL int cr_recency_rebuild(cr_state_t* st) {
+    int n = st->slot_count;
+    cr_recency_clear(st);
+    if (n <= 0) {
+        return 0;
+    }
+
+    recency_key_t* keys = malloc(sizeof(recency_key_t) * (size_t)n);
+    if (!keys) {
+        for (int i = 0; i < n; i++) {
+            recency_push(st, i);  /* Slot order: still a valid list */
+        }
+        return -1;
+    }
+    for (int i = 0; i < n; i++) {
+        keys[i].age = st->slots[i].reinforced_age;
+        keys[i].slot = i;
+    }
+    qsort(keys, n, sizeof(recency_key_t), recency_cmp);
+    for (int i = 0; i < n; i++) {
+        recency_push(st, keys[i].slot);
+    }
+
+    free(keys);
+    return 0;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+static void recency_fill(const cr_state_t* st, int slot, cr_invariant_t* out) {
+    const cr_slot_t* s = &st->slots[slot];
+    out->vector = s->vector;
+    out->dim = st->rt->dim;
+    out->weight = cr_slot_weight(st, s);
+    out->reinforced_age = s->reinforced_age;
+}
+
+int cr_state_recent(cr_state_t* st, double within, cr_invariant_t* out, int max) {
+    if (!st || !(within >= 0.0) || max < 0 || (max > 0 && !out)) {
+        return -1;
+    }
+    if (cr_pool_enter(st) != 0) {
+        return -1;
+    }
+
+    double since = st->age - within;
+    int count = 0;
+    for (int i = st->recent_head; i >= 0 && st->slots[i].reinforced_age >= since;
+         i = st->slots[i].older) {
+        if (count < max) {
+            cr_tier_touch(st, i);  /* The caller may read the row */
+            recency_fill(st, i, &out[count]);
+        }
+        count++;
+    }
+
+    cr_pool_leave(st);
+    return count;
+}
+
+int cr_state_oldest(cr_state_t* st, cr_invariant_t* out) {
+    if (!st || !out) {
+        return -1;
+    }
+    if (cr_pool_enter(st) != 0) {
+        return -1;
+    }
+
+    int slot = st->recent_tail;
+    if (slot >= 0) {
+        cr_tier_touch(st, slot);
+        recency_fill(st, slot, out);
+    }
+
+    cr_pool_leave(st);
+    return slot >= 0 ? 0 : -1;
+}
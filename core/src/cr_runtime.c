@@ -19,6 +19,7 @@
  * @brief Runtime lifecycle and configuration
  */
 
+#include <math.h>
 #include <stdlib.h>
 #include "cr.h"
 #include "cr_internal.h"
@@ -43,6 +44,12 @@ cr_runtime_t* cr_runtime_create(const cr_config_t* cfg) {
     if (cfg->embedding_dim <= 0 || cfg->max_memory_slots <= 0) {
         return NULL;
     }
+    if (cfg->coarse_slots < 0 || cfg->coarse_probe < 0) {
+        return NULL;
+    }
+    if (!(cfg->weight_half_life >= 0.0f)) {
+        return NULL;  /* Negative or NaN */
+    }
 
     cr_runtime_t* rt = calloc(1, sizeof(*rt));
     if (!rt) {
@@ -51,6 +58,13 @@ cr_runtime_t* cr_runtime_create(const cr_config_t* cfg) {
 
     rt->dim = cfg->embedding_dim;
     rt->max_slots = cfg->max_memory_slots;
+    rt->coarse_slots = cfg->coarse_slots;
+    rt->coarse_probe = cfg->coarse_probe > 0 ? cfg->coarse_probe : 1;
+    if (rt->coarse_probe > rt->coarse_slots) {
+        rt->coarse_probe = rt->coarse_slots;
+    }
+    rt->weight_half_life = cfg->weight_half_life;
+    rt->decay_rate = cfg->weight_half_life > 0.0f ? log(2.0) / cfg->weight_half_life : 0.0;
 
     return rt;
 }
@@ -70,6 +84,9 @@ int cr_runtime_config(const cr_runtime_t* rt, cr_config_t* out) {
     out->embedding_dim = rt->dim;
     out->max_memory_slots = rt->max_slots;
     out->initial_plasticity = 1.0f;  /* Default */
+    out->coarse_slots = rt->coarse_slots;
+    out->coarse_probe = rt->coarse_slots > 0 ? rt->coarse_probe : 0;
+    out->weight_half_life = rt->weight_half_life;
 
     return 0;
 }
@@ -0,0 +1,380 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file cr_split.c
+ * @brief Splitting a state into cluster-coherent children
+ *
+ * Spherical k-means over the occupied slots. Each round has two
+ * parallel phases whose outputs are independent of how work is divided:
+ *
+ *   assign   each slot picks its most similar centroid (slot ranges)
+ *   update   each centroid sums its members in slot order (centroid
+ *            ranges), so no cross-thread reduction is needed
+ *
+ * Initialization is farthest-point: the most reinforced slot first, then
+ * repeatedly the slot least similar to every centroid chosen so far.
+ * Ties always go to the lower index.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cr.h"
+#include "cr_internal.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CR_SPLIT_THREADS 1
+#include <pthread.h>
+#endif
+
+#define SPLIT_MAX_ROUNDS 32
+
+typedef struct {
+    const cr_state_t* st;
+    float* centroids;       /**< k × dim */
+    int* assign;            /**< Per slot: centroid */
+    float* nearest;         /**< Per slot: best similarity to chosen centroids */
+    int k;
+    int last;               /**< Init phase: newest centroid */
+    int begin, end;         /**< Slot or centroid range */
+    int changed;            /**< Assign phase: slots that moved */
+} split_job_t;
+
+static const float* split_row(const split_job_t* j, int i) {
+    return j->st->slots[i].vector;
+}
+
+/*============================================================================
+ * Phases
+ *============================================================================*/
+
+static void* split_nearest(void* arg) {
+    split_job_t* j = arg;
+    int dim = j->st->rt->dim;
+    const float* c = j->centroids + (size_t)j->last * dim;
+    for (int i = j->begin; i < j->end; i++) {
+        float sim = cr_cosine_similarity(split_row(j, i), c, dim);
+        if (j->last == 0 || sim > j->nearest[i]) {
+            j->nearest[i] = sim;
+        }
+    }
+    return NULL;
+}
+
+static void* split_assign(void* arg) {
+    split_job_t* j = arg;
+    int dim = j->st->rt->dim;
+    j->changed = 0;
+    for (int i = j->begin; i < j->end; i++) {
+        int best = 0;
+        float best_sim = -2.0f;
+        for (int c = 0; c < j->k; c++) {
+            float sim = cr_cosine_similarity(split_row(j, i),
+                                             j->centroids + (size_t)c * dim, dim);
+            if (sim > best_sim) {
+                best_sim = sim;
+                best = c;
+            }
+        }
+        if (j->assign[i] != best) {
+            j->assign[i] = best;
+            j->changed++;
+        }
+    }
+    return NULL;
+}
+
+static void* split_update(void* arg) {
+    split_job_t* j = arg;
+    int dim = j->st->rt->dim;
+    int n = j->st->slot_count;
+    for (int c = j->begin; c < j->end; c++) {
+        float* sum = j->centroids + (size_t)c * dim;
+        int members = 0;
+        for (int i = 0; i < n; i++) {
+            if (j->assign[i] != c) {
+                continue;
+            }
+            if (members++ == 0) {
+                memset(sum, 0, sizeof(float) * dim);
+            }
+            const float* v = split_row(j, i);
+            float w = j->st->slots[i].weight;
+            for (int d = 0; d < dim; d++) {
+                sum[d] += w * v[d];
+            }
+        }
+
+        /* Empty clusters keep their centroid; all are unit length */
+        float sq = 0.0f;
+        for (int d = 0; d < dim; d++) {
+            sq += sum[d] * sum[d];
+        }
+        if (sq > 0.0f) {
+            float inv = 1.0f / sqrtf(sq);
+            for (int d = 0; d < dim; d++) {
+                sum[d] *= inv;
+            }
+        }
+    }
+    return NULL;
+}
+
+/* Run fn over jobs [0, n), in parallel where threads are available */
+static void split_run(split_job_t* jobs, int n, void* (*fn)(void*)) {
+#ifdef CR_SPLIT_THREADS
+    pthread_t* th = n > 1 ? malloc(sizeof(pthread_t) * (n - 1)) : NULL;
+    int started = 0;
+    if (th) {
+        while (started < n - 1 &&
+               pthread_create(&th[started], NULL, fn, &jobs[started + 1]) == 0) {
+            started++;
+        }
+    }
+    fn(&jobs[0]);
+    for (int t = started + 1; t < n; t++) {
+        fn(&jobs[t]);  /* Threads that could not be started */
+    }
+    for (int t = 0; t < started; t++) {
+        pthread_join(th[t], NULL);
+    }
+    free(th);
+#else
+    for (int t = 0; t < n; t++) {
+        fn(&jobs[t]);
+    }
+#endif
+}
+
+/* Divide [0, total) into n contiguous ranges */
+static void split_ranges(split_job_t* jobs, int n, int total) {
+    for (int t = 0; t < n; t++) {
+        jobs[t].begin = (int)((long long)total * t / n);
+        jobs[t].end = (int)((long long)total * (t + 1) / n);
+    }
+}
+
+/*============================================================================
+ * Clustering
+ *============================================================================*/
+
+static void split_cluster(split_job_t* jobs, int threads) {
+    split_job_t* j = &jobs[0];
+    const cr_state_t* st = j->st;
+    int n = st->slot_count;
+    int dim = st->rt->dim;
+
+    /* Farthest-point initialization */
+    int first = 0;
+    for (int i = 1; i < n; i++) {
+        if (st->slots[i].weight > st->slots[first].weight) {
+            first = i;
+        }
+    }
+    memcpy(j->centroids, split_row(j, first), sizeof(float) * dim);
+    int* chosen = j->assign;  /* Scratch until the first assignment */
+    memset(chosen, 0, sizeof(int) * n);
+    chosen[first] = 1;
+
+    split_ranges(jobs, threads, n);
+    for (int c = 1; c < j->k; c++) {
+        for (int t = 0; t < threads; t++) {
+            jobs[t].last = c - 1;
+        }
+        split_run(jobs, threads, split_nearest);
+
+        int far = -1;
+        for (int i = 0; i < n; i++) {
+            if (!chosen[i] && (far < 0 || j->nearest[i] < j->nearest[far])) {
+                far = i;
+            }
+        }
+        chosen[far] = 1;
+        memcpy(j->centroids + (size_t)c * dim, split_row(j, far), sizeof(float) * dim);
+    }
+
+    /* Lloyd rounds until no slot moves */
+    for (int i = 0; i < n; i++) {
+        j->assign[i] = -1;
+    }
+    for (int round = 0; round < SPLIT_MAX_ROUNDS; round++) {
+        split_ranges(jobs, threads, n);
+        split_run(jobs, threads, split_assign);
+        int changed = 0;
+        for (int t = 0; t < threads; t++) {
+            changed += jobs[t].changed;
+        }
+
+        int workers = threads < j->k ? threads : j->k;
+        split_ranges(jobs, workers, j->k);
+        split_run(jobs, workers, split_update);
+        if (changed == 0) {
+            break;
+        }
+    }
+}
+
+/*============================================================================
+ * Children
+ *============================================================================*/
+
+static int split_fill(const cr_state_t* st, const int* assign, cr_split_t* out) {
+    int dim = st->rt->dim;
+    for (int c = 0; c < out->k; c++) {
+        cr_state_t* child = cr_state_create(st->rt);
+        if (!child) {
+            return -1;
+        }
+        out->children[c] = child;
+
+        child->plasticity = st->plasticity;
+        child->plasticity_prev = st->plasticity_prev;
+        child->velocity = st->velocity;
+        child->age = st->age;
+        child->last_reinforcement_age = st->last_reinforcement_age;
+        child->weight_log = st->weight_log;
+        child->weight_scale = st->weight_scale;
+    }
+
+    /* Slot order is preserved within each child */
+    for (int i = 0; i < st->slot_count; i++) {
+        cr_state_t* child = out->children[assign[i]];
+        cr_slot_t* s = &child->slots[child->slot_count++];
+        memcpy(s->vector, st->slots[i].vector, sizeof(float) * dim);
+        s->weight = st->slots[i].weight;
+        s->reinforced_age = st->slots[i].reinforced_age;
+
+        /* Decayed weights understate the count; every invariant had one */
+        int w = (int)cr_slot_weight(st, &st->slots[i]);
+        if (w < 1) {
+            w = 1;
+        }
+        child->total_updates += w;
+        child->total_reinforcements += w - 1;
+    }
+
+    for (int c = 0; c < out->k; c++) {
+        cr_index_rebuild(out->children[c]);
+        cr_recency_rebuild(out->children[c]);
+    }
+    return 0;
+}
+
+int cr_state_split(cr_state_t* st, int k, int threads, cr_split_t* out) {
+    if (!st || !out || k < 1) {
+        return -1;
+    }
+    memset(out, 0, sizeof(*out));
+    if (cr_pool_enter(st) != 0) {
+        return -1;
+    }
+
+    int n = st->slot_count;
+    int dim = st->rt->dim;
+    int rc = -1;
+    if (threads < 1) {
+        threads = 1;
+    }
+    if (threads > n) {
+        threads = n > 0 ? n : 1;
+    }
+
+    split_job_t* jobs = calloc(threads, sizeof(split_job_t));
+    int* assign = malloc(sizeof(int) * (n > 0 ? n : 1));
+    float* nearest = malloc(sizeof(float) * (n > 0 ? n : 1));
+    out->centroids = calloc((size_t)k * dim, sizeof(float));
+    out->children = calloc(k, sizeof(cr_state_t*));
+    if (k > n || !jobs || !assign || !nearest || !out->centroids || !out->children) {
+        goto done;
+    }
+    out->k = k;
+    out->dim = dim;
+
+    for (int t = 0; t < threads; t++) {
+        jobs[t].st = st;
+        jobs[t].centroids = out->centroids;
+        jobs[t].assign = assign;
+        jobs[t].nearest = nearest;
+        jobs[t].k = k;
+    }
+    split_cluster(jobs, threads);
+    rc = split_fill(st, assign, out);
+
+done:
+    free(jobs);
+    free(assign);
+    free(nearest);
+    if (rc != 0) {
+        cr_split_destroy(out);
+    }
+    cr_pool_leave(st);
+    return rc;
+}
+
+/*============================================================================
+ * Routing
+ *============================================================================*/
+
+int cr_split_route(const cr_split_t* split, const float* embedding, int dim) {
+    if (!split || !split->centroids || !embedding || dim != split->dim) {
+        return -1;
+    }
+
+    int best = 0;
+    float best_sim = -2.0f;
+    for (int c = 0; c < split->k; c++) {
+        float sim = cr_cosine_similarity(embedding, split->centroids + (size_t)c * dim, dim);
+        if (sim > best_sim) {
+            best_sim = sim;
+            best = c;
+        }
+    }
+    return best;
+}
+
+int cr_split_update(cr_split_t* split, const float* embedding, int dim, float delta_t) {
+    int c = cr_split_route(split, embedding, dim);
+    if (c < 0) {
+        return -1;
+    }
+    return cr_state_update(split->children[c], embedding, dim, delta_t);
+}
+
+int cr_split_query(cr_split_t* split, const float* query, int dim, cr_hint_t* out) {
+    int c = cr_split_route(split, query, dim);
+    if (c < 0) {
+        return -1;
+    }
+    return cr_state_query(split->children[c], query, dim, out);
+}
+
+void cr_split_destroy(cr_split_t* split) {
+    if (!split) {
+        return;
+    }
+
+    if (split->children) {
+        for (int c = 0; c < split->k; c++) {
+            cr_state_destroy(split->children[c]);
+        }
+    }
+    free(split->children);
+    free(split->centroids);
+    memset(split, 0, sizeof(*split));
+}
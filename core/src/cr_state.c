@@ -21,6 +21,7 @@
  * This file contains the core learning logic.
  */
 
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 #include "cr.h"
@@ -28,7 +29,7 @@
 #include "mind_vec.h"
 
 /* Core uses foundation for vector math */
-float cr_cosine_similarity(const float* a, const float* b, int dim) {
+CR_INTERNAL float cr_cosine_similarity(const float* a, const float* b, int dim) {
     return mind_vec_cosine(a, b, dim);
 }
 
@@ -36,6 +37,86 @@ float cr_cosine_similarity(const float* a, const float* b, int dim) {
  * State Lifecycle
  *============================================================================*/
 
+CR_INTERNAL int cr_state_alloc(cr_state_t* st) {
+    const cr_runtime_t* rt = st->rt;
+
+    /*
+     * Slot vectors live in one contiguous arena: one allocation instead
+     * of max_slots, and untouched rows of a large state stay unbacked
+     */
+    st->slots = calloc(rt->max_slots, sizeof(cr_slot_t));
+    st->arena = calloc((size_t)rt->max_slots * rt->dim, sizeof(float));
+    if (!st->slots || !st->arena) {
+        cr_state_release(st);
+        return -1;
+    }
+    st->arena_rows = rt->max_slots;
+
+    for (int i = 0; i < rt->max_slots; i++) {
+        st->slots[i].vector = st->arena + (size_t)i * rt->dim;
+        st->slots[i].weight = 0.0f;
+        st->slots[i].coarse = -1;
+        st->slots[i].next = -1;
+        st->slots[i].hot = -1;
+        st->slots[i].last_access = 0;
+        st->slots[i].reinforced_age = 0.0;
+        st->slots[i].newer = -1;
+        st->slots[i].older = -1;
+    }
+    st->recent_head = -1;
+    st->recent_tail = -1;
+
+    if (cr_index_create(st) != 0) {
+        cr_state_release(st);
+        return -1;
+    }
+
+    return 0;
+}
+
+CR_INTERNAL void cr_state_release(cr_state_t* st) {
+    cr_index_destroy(st);
+    cr_tier_destroy(st);
+    free(st->arena);
+    free(st->slots);
+    st->arena = NULL;
+    st->slots = NULL;
+    st->arena_rows = 0;
+    st->pressure_released = 0;  /* cr_state_alloc() starts complete */
+}
+
+/* Point slot vectors at a moved arena; slots past rows have no row */
+static void state_point(cr_state_t* st, float* arena, int rows) {
+    int dim = st->rt->dim;
+    st->arena = arena;
+    st->arena_rows = rows;
+    for (int i = 0; i < st->rt->max_slots; i++) {
+        st->slots[i].vector = i < rows ? arena + (size_t)i * dim : NULL;
+    }
+}
+
+CR_INTERNAL int cr_state_reserve(cr_state_t* st, int rows) {
+    int max_slots = st->rt->max_slots;
+    if (st->tier || rows <= st->arena_rows) {
+        return 0;  /* Tiered rows always exist */
+    }
+    if (rows > max_slots) {
+        return -1;
+    }
+
+    /* Double, so refilling a shrunk state costs amortized O(1) per slot */
+    int cap = st->arena_rows > 0 ? st->arena_rows : 1;
+    while (cap < rows) {
+        cap = cap > max_slots / 2 ? max_slots : cap * 2;
+    }
+    float* arena = realloc(st->arena, sizeof(float) * (size_t)cap * st->rt->dim);
+    if (!arena) {
+        return -1;
+    }
+    state_point(st, arena, cap);
+    return 0;
+}
+
 cr_state_t* cr_state_create(cr_runtime_t* rt) {
     if (!rt) {
         return NULL;
@@ -57,34 +138,20 @@ cr_state_t* cr_state_create(cr_runtime_t* rt) {
     st->slot_count = 0;
     st->total_updates = 0;
     st->total_reinforcements = 0;
+    st->weight_log = 0.0;
+    st->weight_scale = 1.0;
 
     /* Allocate memory slots */
-    st->slots = calloc(rt->max_slots, sizeof(cr_slot_t));
-    if (!st->slots) {
+    if (cr_state_alloc(st) != 0) {
         free(st);
         return NULL;
     }
 
-    /* Allocate vectors for each slot */
-    for (int i = 0; i < rt->max_slots; i++) {
-        st->slots[i].vector = calloc(rt->dim, sizeof(float));
-        if (!st->slots[i].vector) {
-            /* Cleanup on failure */
-            for (int j = 0; j < i; j++) {
-                free(st->slots[j].vector);
-            }
-            free(st->slots);
-            free(st);
-            return NULL;
-        }
-        st->slots[i].weight = 0.0f;
-    }
-
     return st;
 }
 
 void cr_state_reset(cr_state_t* st) {
-    if (!st) {
+    if (!st || cr_pool_enter(st) != 0) {
         return;
     }
 
@@ -94,15 +161,26 @@ void cr_state_reset(cr_state_t* st) {
     st->velocity = 0.0f;
     st->age = 0.0f;
     st->last_reinforcement_age = 0.0f;
-    st->slot_count = 0;
     st->total_updates = 0;
     st->total_reinforcements = 0;
+    st->weight_log = 0.0;
+    st->weight_scale = 1.0;
+    cr_temporal_clear(st);
 
-    /* Clear memory slots */
-    for (int i = 0; i < st->rt->max_slots; i++) {
-        memset(st->slots[i].vector, 0, st->rt->dim * sizeof(float));
+    /* Clear memory slots (rows past slot_count were never written) */
+    cr_index_clear(st);
+    for (int i = 0; i < st->slot_count; i++) {
+        if (!st->tier) {
+            memset(st->slots[i].vector, 0, st->rt->dim * sizeof(float));
+        }
         st->slots[i].weight = 0.0f;
+        st->slots[i].reinforced_age = 0.0;
     }
+    cr_recency_clear(st);
+    cr_tier_clear(st);  /* Cold rows are not read back, so not rewritten */
+    st->slot_count = 0;
+
+    cr_pool_leave(st);
 }
 
 void cr_state_destroy(cr_state_t* st) {
@@ -110,15 +188,44 @@ void cr_state_destroy(cr_state_t* st) {
         return;
     }
 
-    /* Free slot vectors */
-    if (st->slots) {
-        for (int i = 0; i < st->rt->max_slots; i++) {
-            free(st->slots[i].vector);
+    cr_pool_forget(st);
+    cr_state_release(st);
+
+    free(st);
+}
+
+/**
+ * @brief Return storage past the live slots
+ *
+ * Slots are always dense (eviction compacts), so only the tail needs
+ * releasing. The arena is reallocated to slot_count rows; large arenas
+ * are mappings, so the allocator unmaps the tail. Tiered states release
+ * their cold tail instead. Slot indices and contents do not change, so
+ * the index and sketches stay valid as they are.
+ */
+int cr_state_shrink(cr_state_t* st) {
+    if (!st) {
+        return -1;
+    }
+    if (cr_pool_enter(st) != 0) {
+        return -1;
+    }
+
+    int rc = 0;
+    int rows = st->slot_count > 0 ? st->slot_count : 1;
+    if (st->tier) {
+        rc = cr_tier_trim(st);
+    } else if (rows < st->arena_rows) {
+        float* arena = realloc(st->arena, sizeof(float) * (size_t)rows * st->rt->dim);
+        if (arena) {
+            state_point(st, arena, rows);
+        } else {
+            rc = -1;  /* The old arena is intact */
         }
-        free(st->slots);
     }
 
-    free(st);
+    cr_pool_leave(st);
+    return rc;
 }
 
 int cr_state_slot_count(const cr_state_t* st) {
@@ -128,6 +235,39 @@ int cr_state_slot_count(const cr_state_t* st) {
     return st->slot_count;
 }
 
+/*============================================================================
+ * Weight Decay
+ *============================================================================*/
+
+/*
+ * Decaying every weight each update would be O(slots). Instead, time
+ * grows one global scale, e^weight_log, and new reinforcements are
+ * stored multiplied by it: a stored weight divided by the current scale
+ * is exactly its decayed value. Only the scalar moves per update; the
+ * stored weights are divided down once the scale gets large.
+ */
+CR_INTERNAL float cr_slot_weight(const cr_state_t* st, const cr_slot_t* slot) {
+    return (float)(slot->weight / st->weight_scale);
+}
+
+static void state_decay(cr_state_t* st, float delta_t) {
+    double rate = st->rt->decay_rate;
+    if (rate == 0.0) {
+        return;
+    }
+
+    /* The scale must include this step before weights are divided by it */
+    st->weight_log += rate * delta_t;
+    st->weight_scale = exp(st->weight_log);
+    if (st->weight_log > CR_DECAY_RENORM_LOG) {
+        for (int i = 0; i < st->slot_count; i++) {
+            st->slots[i].weight = cr_slot_weight(st, &st->slots[i]);
+        }
+        st->weight_log = 0.0;
+        st->weight_scale = 1.0;
+    }
+}
+
 /*============================================================================
  * Experience Processing
  *============================================================================*/
@@ -138,60 +278,48 @@ int cr_state_slot_count(const cr_state_t* st) {
  * This is the core learning function implementing mercy-based memory.
  *
  * Algorithm:
- * 1. Find the closest existing invariant (by cosine similarity)
+ * 0. Decay existing weights over delta_t (O(1), see state_decay)
+ *    and expire invariants outside the sliding window (cr_expiry.c)
+ * 1. Find the closest existing invariant (by cosine similarity; with
+ *    two-level memory, within the best coarse buckets)
  * 2. If similarity > threshold: REINFORCE
  *    - Interpolate toward new pattern (weighted by plasticity)
- *    - Increase weight
+ *    - Increase weight and move it to the head of the recency list
  *    - Decay plasticity (crystallization)
  * 3. Else if space available: CREATE
- *    - Store as new invariant
+ *    - Store as new invariant (at the head of the recency list)
  *    - Recovery plasticity slightly (preserve openness)
  * 4. Else: IGNORE (memory full)
  * 5. Advance age by delta_t
  * 6. Compute velocity (rate of plasticity change)
+ * 7. Record the outcome in the rolling statistics (O(1))
  *
  * Properties guaranteed:
  * - Plasticity never drops below CR_EPSILON (mercy)
  * - Memory never exceeds max_slots (bounded)
  * - Result is deterministic (no randomness)
  */
-int cr_state_update(
+static void state_experience(
     cr_state_t* st,
     const float* embedding,
     int dim,
     float delta_t
 ) {
-    /* Validate inputs */
-    if (!st || !embedding) {
-        return -1;
-    }
-    if (dim != st->rt->dim) {
-        return -1;
-    }
-    if (delta_t <= 0.0f) {
-        return -1;
-    }
-
     /* Store previous plasticity for velocity calculation */
     st->plasticity_prev = st->plasticity;
 
-    /* Find closest existing invariant */
-    cr_slot_t* best = NULL;
-    float best_sim = 0.0f;
+    /* Existing weights decay over delta_t before this experience counts */
+    state_decay(st, delta_t);
 
-    for (int i = 0; i < st->slot_count; i++) {
-        float sim = cr_cosine_similarity(
-            embedding,
-            st->slots[i].vector,
-            dim
-        );
-        if (sim > best_sim) {
-            best_sim = sim;
-            best = &st->slots[i];
-        }
-    }
+    /* Sliding window: invariants that fall out of it cannot be matched */
+    cr_expiry_run(st, st->age + delta_t);
+
+    /* Find closest existing invariant */
+    float best_sim;
+    cr_slot_t* best = cr_index_match(st, embedding, dim, &best_sim);
 
     int reinforced = 0;
+    int created = 0;
 
     if (best && best_sim > CR_SIM_THRESHOLD) {
         /*
@@ -203,24 +331,37 @@ int cr_state_update(
          * When plastic (=1.0): new = input (full adoption)
          * When stable (=ε):    new ≈ old (minimal change)
          */
+        cr_index_retract(st, best);
         mind_vec_lerp(best->vector, embedding, st->plasticity, best->vector, dim);
-        best->weight += 1.0f;
+        cr_index_commit(st, best);
+        best->weight += (float)st->weight_scale;
+        cr_recency_touch(st, (int)(best - st->slots), st->age + delta_t);
         reinforced = 1;
 
         /* Track temporal landmark */
         st->last_reinforcement_age = st->age + delta_t;
         st->total_reinforcements++;
     }
-    else if (st->slot_count < st->rt->max_slots) {
+    else if (st->slot_count < st->rt->max_slots &&
+             cr_state_reserve(st, st->slot_count + 1) == 0) {
         /*
          * CREATE new invariant
          *
-         * Store the embedding as a new pattern.
+         * Store the embedding as a new pattern. (A shrunk arena that
+         * cannot grow counts as full.)
          */
         cr_slot_t* slot = &st->slots[st->slot_count];
+        cr_tier_place(st, st->slot_count);
         memcpy(slot->vector, embedding, sizeof(float) * dim);
-        slot->weight = 1.0f;
+        slot->weight = (float)st->weight_scale;
+        cr_recency_touch(st, st->slot_count, st->age + delta_t);
+        cr_index_insert(st, st->slot_count);
         st->slot_count++;
+        created = 1;
+
+        if (st->quota) {
+            cr_quota_enforce(st, CR_DEGRADE_EVICT);
+        }
     }
     /* else: memory full, experience silently ignored (bounded) */
 
@@ -261,5 +402,70 @@ int cr_state_update(
      */
     st->velocity = (st->plasticity_prev - st->plasticity) / delta_t;
 
+    cr_temporal_record(st, (reinforced ? CR_EVENT_REINFORCED : 0) |
+                           (created ? CR_EVENT_CREATED : 0));
+}
+
+int cr_state_update(
+    cr_state_t* st,
+    const float* embedding,
+    int dim,
+    float delta_t
+) {
+    /* Validate inputs */
+    if (!st || !embedding) {
+        return -1;
+    }
+    if (dim != st->rt->dim) {
+        return -1;
+    }
+    if (delta_t <= 0.0f) {
+        return -1;
+    }
+
+    if (cr_pool_enter(st) != 0) {
+        return -1;  /* Hibernated and could not be revived */
+    }
+    state_experience(st, embedding, dim, delta_t);
+    cr_pool_leave(st);
+
+    return 0;
+}
+
+/**
+ * @brief Update state with a batch of experiences
+ *
+ * Rows are applied strictly in order, so a batch evolves the state
+ * exactly like the equivalent sequence of cr_state_update() calls.
+ * Validation happens once, up front, which is where the savings over
+ * per-row calls (and per-row FFI crossings) come from.
+ */
+int cr_state_update_batch(
+    cr_state_t* st,
+    const float* embeddings,
+    int count,
+    int stride,
+    int dim,
+    float delta_t
+) {
+    /* Validate inputs */
+    if (!st || (!embeddings && count > 0)) {
+        return -1;
+    }
+    if (dim != st->rt->dim || stride < dim || count < 0) {
+        return -1;
+    }
+    if (delta_t <= 0.0f) {
+        return -1;
+    }
+
+    if (cr_pool_enter(st) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < count; i++) {
+        state_experience(st, embeddings + (size_t)i * stride, dim, delta_t);
+    }
+    cr_pool_leave(st);
+
     return 0;
 }
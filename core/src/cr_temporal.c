@@ -21,9 +21,61 @@
  * This file provides time understanding for server-to-server coevolution.
  */
 
+#include <string.h>
 #include "cr.h"
 #include "cr_internal.h"
 
+/*============================================================================
+ * Rolling Statistics
+ *============================================================================*/
+
+/*
+ * Each update pushes one sample (velocity, reinforced, created). The
+ * EWMAs fold it in with weight 1/horizon, or 1/count while fewer
+ * updates were seen. The windows keep running sums over one shared
+ * ring: a sample enters every window now and leaves window h exactly
+ * horizon[h] pushes later. All of it is O(1) per update.
+ */
+static const int temporal_horizons[CR_ROLLING_HORIZONS] = {16, 64, CR_ROLLING_RING};
+
+CR_INTERNAL void cr_temporal_record(cr_state_t* st, int events) {
+    float sample[3] = {
+        st->velocity,
+        (events & CR_EVENT_REINFORCED) ? 1.0f : 0.0f,
+        (events & CR_EVENT_CREATED) ? 1.0f : 0.0f,
+    };
+    long long n = st->rolling_count;
+    int head = (int)(n % CR_ROLLING_RING);
+
+    for (int h = 0; h < CR_ROLLING_HORIZONS; h++) {
+        int horizon = temporal_horizons[h];
+        float alpha = n + 1 < horizon ? 1.0f / (float)(n + 1) : 1.0f / (float)horizon;
+        for (int k = 0; k < 3; k++) {
+            st->rolling_ewma[h][k] += alpha * (sample[k] - st->rolling_ewma[h][k]);
+        }
+
+        if (n >= horizon) {
+            int old = (head + CR_ROLLING_RING - horizon) % CR_ROLLING_RING;
+            st->rolling_sum[h][0] -= st->rolling_velocity[old];
+            st->rolling_sum[h][1] -= (st->rolling_event[old] & CR_EVENT_REINFORCED) ? 1.0 : 0.0;
+            st->rolling_sum[h][2] -= (st->rolling_event[old] & CR_EVENT_CREATED) ? 1.0 : 0.0;
+        }
+        for (int k = 0; k < 3; k++) {
+            st->rolling_sum[h][k] += sample[k];
+        }
+    }
+
+    st->rolling_velocity[head] = st->velocity;
+    st->rolling_event[head] = (unsigned char)events;
+    st->rolling_count = n + 1;
+}
+
+CR_INTERNAL void cr_temporal_clear(cr_state_t* st) {
+    st->rolling_count = 0;
+    memset(st->rolling_ewma, 0, sizeof(st->rolling_ewma));
+    memset(st->rolling_sum, 0, sizeof(st->rolling_sum));
+}
+
 /**
  * @brief Get basic epistemic state
  */
@@ -66,7 +118,7 @@ int cr_state_temporal(
     out->age = st->age;
     out->plasticity = st->plasticity;
     out->velocity = st->velocity;
-    out->maturity = st->age * stability;
+    out->maturity = st->age * (double)stability;
     out->last_reinforcement_age = st->last_reinforcement_age;
     out->time_since_reinforcement = st->age - st->last_reinforcement_age;
     out->total_updates = st->total_updates;
@@ -105,18 +157,53 @@ int cr_state_calibration(
 
     float stability = 1.0f - st->plasticity;
 
-    out->age = st->age;
+    /* The signal stays float32 on the wire */
+    out->age = (float)st->age;
     out->plasticity = st->plasticity;
     out->velocity = st->velocity;
-    out->maturity = st->age * stability;
+    out->maturity = (float)(st->age * (double)stability);
 
     /* Reinforcement ratio: repetition vs novelty */
     if (st->total_updates > 0) {
         out->reinforcement_ratio =
-            (float)st->total_reinforcements / (float)st->total_updates;
+            (float)((double)st->total_reinforcements / (double)st->total_updates);
     } else {
         out->reinforcement_ratio = 0.0f;
     }
 
     return 0;
 }
+
+/**
+ * @brief Get rolling temporal statistics
+ */
+int cr_state_rolling(
+    const cr_state_t* st,
+    cr_rolling_t* out
+) {
+    if (!st || !out) {
+        return -1;
+    }
+
+    for (int h = 0; h < CR_ROLLING_HORIZONS; h++) {
+        int horizon = temporal_horizons[h];
+        long long n = st->rolling_count;
+
+        cr_rolling_stat_t* e = &out->ewma[h];
+        e->horizon = horizon;
+        e->updates = n < horizon ? (int)n : horizon;
+        e->velocity = st->rolling_ewma[h][0];
+        e->reinforcement_ratio = st->rolling_ewma[h][1];
+        e->create_rate = st->rolling_ewma[h][2];
+
+        cr_rolling_stat_t* w = &out->window[h];
+        w->horizon = horizon;
+        w->updates = e->updates;
+        double inv = w->updates > 0 ? 1.0 / w->updates : 0.0;
+        w->velocity = (float)(st->rolling_sum[h][0] * inv);
+        w->reinforcement_ratio = (float)(st->rolling_sum[h][1] * inv);
+        w->create_rate = (float)(st->rolling_sum[h][2] * inv);
+    }
+
+    return 0;
+}
@@ -0,0 +1,579 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file cr_tier.c
+ * @brief Hot/cold slot tiering
+ *
+ * A tiered state stores slot vectors in two places:
+ *
+ *   hot   in-RAM slab of hot_slots rows; slot.hot is the row
+ *   cold  MAP_SHARED file mapping; slot i always owns file row i
+ *
+ * slot.vector points at whichever copy is current, so everything that
+ * reads vectors (persistence, hints, two-level summaries) is unchanged.
+ *
+ * Cold slots also carry an int8 sketch (symmetric, per-slot scale) and
+ * their norm. Lookups estimate cold similarities from the sketch, read
+ * only the most promising cold rows, and promote the winner. Placing a
+ * slot in a full slab demotes the least recently matched hot slot.
+ *
+ * Recency is a per-state lookup clock, not wall time, so tiering is a
+ * pure function of the update/query sequence.
+ *
+ * Under memory pressure (cr_monitor.c) the sketches can be released;
+ * lookups then compare against cold rows directly until they return.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cr.h"
+#include "cr_internal.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CR_TIER_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/*============================================================================
+ * Rows and Sketches
+ *============================================================================*/
+
+static float* tier_cold_row(const cr_state_t* st, int slot) {
+    return st->tier->cold + (size_t)slot * st->rt->dim;
+}
+
+static float* tier_hot_row(const cr_state_t* st, int row) {
+    return st->tier->slab + (size_t)row * st->rt->dim;
+}
+
+static void tier_sketch(cr_state_t* st, int slot) {
+    cr_tier_t* t = st->tier;
+    int dim = st->rt->dim;
+    if (!t->sketch) {
+        cr_tier_touch(st, slot);  /* Released under memory pressure */
+        return;
+    }
+
+    const float* v = st->slots[slot].vector;
+    signed char* q = t->sketch + (size_t)slot * dim;
+
+    float max_abs = 0.0f;
+    float sq = 0.0f;
+    for (int i = 0; i < dim; i++) {
+        float a = fabsf(v[i]);
+        if (a > max_abs) {
+            max_abs = a;
+        }
+        sq += v[i] * v[i];
+    }
+
+    float inv = max_abs > 0.0f ? 127.0f / max_abs : 0.0f;
+    for (int i = 0; i < dim; i++) {
+        q[i] = (signed char)lrintf(v[i] * inv);
+    }
+    t->sketch_scale[slot] = max_abs / 127.0f;
+    t->sketch_norm[slot] = sqrtf(sq);
+    cr_tier_touch(st, slot);
+}
+
+CR_INTERNAL void cr_tier_touch(cr_state_t* st, int slot) {
+    cr_tier_t* t = st->tier;
+    if (t && !t->resident[slot]) {
+        t->resident[slot] = 1;
+        t->resident_count++;
+    }
+}
+
+CR_INTERNAL float cr_tier_estimate(const cr_state_t* st, int slot,
+                                   const float* embedding, float embedding_norm) {
+    const cr_tier_t* t = st->tier;
+    int dim = st->rt->dim;
+    const signed char* q = t->sketch + (size_t)slot * dim;
+
+    float norm = t->sketch_norm[slot];
+    if (norm == 0.0f || embedding_norm == 0.0f) {
+        return 0.0f;
+    }
+
+    float dot = 0.0f;
+    for (int i = 0; i < dim; i++) {
+        dot += embedding[i] * (float)q[i];
+    }
+    return dot * t->sketch_scale[slot] / (embedding_norm * norm);
+}
+
+/*============================================================================
+ * Placement
+ *============================================================================*/
+
+static void tier_demote(cr_state_t* st, int slot) {
+    cr_slot_t* s = &st->slots[slot];
+    float* row = tier_cold_row(st, slot);
+
+    memcpy(row, s->vector, sizeof(float) * st->rt->dim);
+    s->vector = row;
+    s->hot = -1;
+    tier_sketch(st, slot);
+    st->tier->demotions++;
+}
+
+/*
+ * Free slab row, demoting the least recently used hot slot if needed.
+ * Pinned slots are never demoted; -1 if every row is pinned.
+ */
+static int tier_take_row(cr_state_t* st) {
+    cr_tier_t* t = st->tier;
+    if (t->hot_used < t->hot_slots) {
+        return t->hot_used++;
+    }
+
+    int victim = -1;
+    for (int r = 0; r < t->hot_slots; r++) {
+        unsigned long long used = st->slots[t->hot_owner[r]].last_access;
+        if (t->pin_from && used >= t->pin_from) {
+            continue;
+        }
+        if (victim < 0 || used < st->slots[t->hot_owner[victim]].last_access) {
+            victim = r;
+        }
+    }
+    if (victim >= 0) {
+        tier_demote(st, t->hot_owner[victim]);
+    }
+    return victim;
+}
+
+static void tier_assign(cr_state_t* st, int slot, int row) {
+    cr_slot_t* s = &st->slots[slot];
+    st->tier->hot_owner[row] = slot;
+    s->hot = row;
+    s->vector = tier_hot_row(st, row);
+}
+
+CR_INTERNAL void cr_tier_place(cr_state_t* st, int slot) {
+    if (!st->tier) {
+        return;
+    }
+    tier_assign(st, slot, tier_take_row(st));
+    st->slots[slot].last_access = st->tier->clock;
+}
+
+CR_INTERNAL void cr_tier_promote(cr_state_t* st, int slot) {
+    if (!st->tier || st->slots[slot].hot >= 0) {
+        return;
+    }
+
+    /* The promoted slot is cold, so it is never its own victim */
+    int row = tier_take_row(st);
+    if (row < 0) {
+        return;  /* Slab pinned: read the cold row, which queries never rewrite */
+    }
+    memcpy(tier_hot_row(st, row), st->slots[slot].vector,
+           sizeof(float) * st->rt->dim);
+    tier_assign(st, slot, row);
+    st->tier->promotions++;
+}
+
+CR_INTERNAL void cr_tier_drop(cr_state_t* st, int slot) {
+    cr_tier_t* t = st->tier;
+    cr_slot_t* s = &st->slots[slot];
+    if (!t || s->hot < 0) {
+        return;
+    }
+
+    /* Fill the hole with the last slab row so rows stay dense */
+    int row = s->hot;
+    int last = --t->hot_used;
+    if (row != last) {
+        memcpy(tier_hot_row(st, row), tier_hot_row(st, last),
+               sizeof(float) * st->rt->dim);
+        tier_assign(st, t->hot_owner[last], row);
+    }
+    memset(tier_hot_row(st, last), 0, sizeof(float) * st->rt->dim);
+    s->vector = tier_cold_row(st, slot);
+    s->hot = -1;
+}
+
+CR_INTERNAL void cr_tier_move(cr_state_t* st, int from, int to) {
+    cr_tier_t* t = st->tier;
+    if (!t) {
+        return;
+    }
+
+    cr_slot_t* f = &st->slots[from];
+    int dim = st->rt->dim;
+    if (f->hot >= 0) {
+        /* The slab row changes owner; to's cold row is rewritten on demotion */
+        int row = f->hot;
+        tier_assign(st, to, row);
+        f->hot = -1;
+    } else {
+        memcpy(tier_cold_row(st, to), f->vector, sizeof(float) * dim);
+        st->slots[to].vector = tier_cold_row(st, to);
+        if (t->sketch) {
+            memcpy(t->sketch + (size_t)to * dim, t->sketch + (size_t)from * dim, dim);
+            t->sketch_scale[to] = t->sketch_scale[from];
+            t->sketch_norm[to] = t->sketch_norm[from];
+        }
+        cr_tier_touch(st, from);
+        cr_tier_touch(st, to);
+    }
+    f->vector = tier_cold_row(st, from);
+}
+
+/*
+ * Batch queries: a hint points at its slot's row, so a later row of the
+ * same batch must not demote that slot and reuse the slab row.
+ */
+CR_INTERNAL void cr_tier_pin(cr_state_t* st) {
+    if (st->tier) {
+        st->tier->pin_from = st->tier->clock + 1;
+    }
+}
+
+CR_INTERNAL void cr_tier_unpin(cr_state_t* st) {
+    if (st->tier) {
+        st->tier->pin_from = 0;
+    }
+}
+
+CR_INTERNAL unsigned long long cr_tier_tick(cr_state_t* st) {
+    return st->tier ? ++st->tier->clock : 0;
+}
+
+CR_INTERNAL void cr_tier_clear(cr_state_t* st) {
+    cr_tier_t* t = st->tier;
+    if (!t) {
+        return;
+    }
+
+    for (int i = 0; i < st->rt->max_slots; i++) {
+        st->slots[i].vector = tier_cold_row(st, i);
+        st->slots[i].hot = -1;
+        st->slots[i].last_access = 0;
+    }
+    memset(t->slab, 0, sizeof(float) * (size_t)t->hot_used * st->rt->dim);
+    t->hot_used = 0;
+    t->clock = 0;
+}
+
+CR_INTERNAL void cr_tier_release_sketch(cr_state_t* st) {
+    if (st->tier) {
+        free(st->tier->sketch);
+        st->tier->sketch = NULL;
+    }
+}
+
+CR_INTERNAL int cr_tier_restore_sketch(cr_state_t* st) {
+    cr_tier_t* t = st->tier;
+    if (!t || t->sketch) {
+        return 0;
+    }
+    t->sketch = calloc((size_t)st->rt->max_slots * st->rt->dim, 1);
+    if (!t->sketch) {
+        return -1;
+    }
+    cr_tier_rebuild(st);
+    return 0;
+}
+
+CR_INTERNAL int cr_tier_shrink(cr_state_t* st, int hot_slots) {
+    cr_tier_t* t = st->tier;
+    if (!t || hot_slots < 1 || hot_slots >= t->hot_slots) {
+        return -1;
+    }
+
+    size_t row_bytes = sizeof(float) * st->rt->dim;
+    float* slab = calloc(hot_slots, row_bytes);
+    int* owner = calloc(hot_slots, sizeof(int));
+    if (!slab || !owner) {
+        free(slab);
+        free(owner);
+        return -1;
+    }
+
+    /* Everything goes cold; matches promote slots back */
+    for (int r = 0; r < t->hot_used; r++) {
+        tier_demote(st, t->hot_owner[r]);
+    }
+    free(t->slab);
+    free(t->hot_owner);
+    t->slab = slab;
+    t->hot_owner = owner;
+    t->hot_slots = hot_slots;
+    t->hot_used = 0;
+
+    return 0;
+}
+
+CR_INTERNAL void cr_tier_layout(cr_state_t* st, int count) {
+    if (!st->tier) {
+        return;
+    }
+
+    cr_tier_clear(st);
+    for (int i = 0; i < count && i < st->tier->hot_slots; i++) {
+        tier_assign(st, i, st->tier->hot_used++);
+    }
+}
+
+CR_INTERNAL void cr_tier_rebuild(cr_state_t* st) {
+    if (!st->tier) {
+        return;
+    }
+    for (int i = 0; i < st->slot_count; i++) {
+        if (st->slots[i].hot < 0) {
+            tier_sketch(st, i);
+        }
+    }
+}
+
+/*============================================================================
+ * Lifecycle
+ *============================================================================*/
+
+CR_INTERNAL void cr_tier_destroy(cr_state_t* st) {
+    cr_tier_t* t = st->tier;
+    if (!t) {
+        return;
+    }
+
+#ifdef CR_TIER_MMAP
+    if (t->cold) {
+        munmap(t->cold, (size_t)t->cold_bytes);
+    }
+    if (t->fd >= 0) {
+        close(t->fd);
+    }
+#endif
+    free(t->slab);
+    free(t->hot_owner);
+    free(t->sketch);
+    free(t->sketch_scale);
+    free(t->sketch_norm);
+    free(t->resident);
+    free(t);
+    st->tier = NULL;
+}
+
+#ifdef CR_TIER_MMAP
+
+static int tier_open(const char* path) {
+    if (path) {
+        return open(path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+    }
+
+    const char* dir = getenv("TMPDIR");
+    if (!dir || !*dir) {
+        dir = "/tmp";
+    }
+    size_t len = strlen(dir) + sizeof("/mind-cold-XXXXXX");
+    char* tmpl = malloc(len);
+    if (!tmpl) {
+        return -1;
+    }
+    strcpy(tmpl, dir);
+    strcat(tmpl, "/mind-cold-XXXXXX");
+
+    int fd = mkstemp(tmpl);
+    if (fd >= 0) {
+        unlink(tmpl);
+    }
+    free(tmpl);
+    return fd;
+}
+
+CR_INTERNAL int cr_tier_drop_cache(cr_state_t* st) {
+    cr_tier_t* t = st->tier;
+    if (!t || t->resident_count == 0) {
+        return -1;
+    }
+
+    /*
+     * Write back, then map the file again over itself: the new mapping
+     * has no pages, and slot pointers stay valid. Finally ask the kernel
+     * to drop the now unmapped pages from the page cache.
+     */
+    if (msync(t->cold, (size_t)t->cold_bytes, MS_SYNC) != 0) {
+        return -1;
+    }
+    void* map = mmap(t->cold, (size_t)t->cold_bytes, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_FIXED, t->fd, 0);
+    if (map == MAP_FAILED) {
+        return -1;
+    }
+#ifdef POSIX_FADV_DONTNEED
+    posix_fadvise(t->fd, 0, (off_t)t->cold_bytes, POSIX_FADV_DONTNEED);
+#endif
+    memset(t->resident, 0, (size_t)st->rt->max_slots);
+    t->resident_count = 0;
+
+    return 0;
+}
+
+CR_INTERNAL int cr_tier_trim(cr_state_t* st) {
+    cr_tier_t* t = st->tier;
+    if (!t) {
+        return -1;
+    }
+
+    cr_tier_drop_cache(st);
+
+    /*
+     * Cut the file after the page holding the last live row and extend
+     * it again: the tail's blocks are freed (pages, on tmpfs) and read
+     * back as zeros, while the mapping keeps its size and address.
+     */
+    long page = sysconf(_SC_PAGESIZE);
+    unsigned long long live = (unsigned long long)st->slot_count * st->rt->dim * sizeof(float);
+    if (page > 0) {
+        live = (live + (unsigned long long)page - 1) / (unsigned long long)page * (unsigned long long)page;
+    }
+    if (live >= t->cold_bytes) {
+        return 0;
+    }
+    if (ftruncate(t->fd, (off_t)live) != 0 ||
+        ftruncate(t->fd, (off_t)t->cold_bytes) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+int cr_state_tier(cr_state_t* st, int hot_slots, const char* cold_path) {
+    if (!st || st->tier || st->member) {
+        return -1;
+    }
+    if (hot_slots < 1 || hot_slots > st->rt->max_slots) {
+        return -1;
+    }
+
+    int dim = st->rt->dim;
+    int max_slots = st->rt->max_slots;
+    size_t rows = (size_t)max_slots * dim;
+
+    cr_tier_t* t = calloc(1, sizeof(*t));
+    if (!t) {
+        return -1;
+    }
+    t->fd = -1;
+    st->tier = t;
+
+    t->hot_slots = hot_slots;
+    t->slab = calloc((size_t)hot_slots * dim, sizeof(float));
+    t->hot_owner = calloc(hot_slots, sizeof(int));
+    t->sketch = calloc(rows, 1);
+    t->sketch_scale = calloc(max_slots, sizeof(float));
+    t->sketch_norm = calloc(max_slots, sizeof(float));
+    t->resident = calloc(max_slots, 1);
+    if (!t->slab || !t->hot_owner || !t->sketch || !t->sketch_scale ||
+        !t->sketch_norm || !t->resident) {
+        goto error;
+    }
+
+    t->fd = tier_open(cold_path);
+    if (t->fd < 0) {
+        goto error;
+    }
+    t->cold_bytes = (unsigned long long)rows * sizeof(float);
+    if (ftruncate(t->fd, (off_t)t->cold_bytes) != 0) {
+        goto error;
+    }
+    void* map = mmap(NULL, (size_t)t->cold_bytes, PROT_READ | PROT_WRITE,
+                     MAP_SHARED, t->fd, 0);
+    if (map == MAP_FAILED) {
+        goto error;
+    }
+    t->cold = map;
+
+    /* Move existing rows out of the arena: first hot_slots stay hot */
+    for (int i = 0; i < max_slots; i++) {
+        cr_slot_t* s = &st->slots[i];
+        float* from = s->vector;
+        if (i < st->slot_count && i < hot_slots) {
+            tier_assign(st, i, t->hot_used++);
+            memcpy(s->vector, from, sizeof(float) * dim);
+        } else {
+            s->vector = tier_cold_row(st, i);
+            s->hot = -1;
+            if (i < st->slot_count) {
+                memcpy(s->vector, from, sizeof(float) * dim);
+                tier_sketch(st, i);
+            }
+        }
+        s->last_access = 0;
+    }
+
+    free(st->arena);
+    st->arena = NULL;
+    st->arena_rows = 0;
+    return 0;
+
+error:
+    cr_tier_destroy(st);
+    return -1;
+}
+
+#else /* !CR_TIER_MMAP */
+
+CR_INTERNAL int cr_tier_drop_cache(cr_state_t* st) {
+    (void)st;
+    return -1;
+}
+
+CR_INTERNAL int cr_tier_trim(cr_state_t* st) {
+    (void)st;
+    return -1;
+}
+
+int cr_state_tier(cr_state_t* st, int hot_slots, const char* cold_path) {
+    (void)st;
+    (void)hot_slots;
+    (void)cold_path;
+    return -1;
+}
+
+#endif /* CR_TIER_MMAP */
+
+int cr_state_tier_stats(const cr_state_t* st, cr_tier_stats_t* out) {
+    if (!st || !out) {
+        return -1;
+    }
+
+    memset(out, 0, sizeof(*out));
+    const cr_tier_t* t = st->tier;
+    if (!t) {
+        return 0;
+    }
+
+    out->hot_slots = t->hot_slots;
+    for (int i = 0; i < st->slot_count; i++) {
+        if (st->slots[i].hot >= 0) {
+            out->hot_count++;
+        } else {
+            out->cold_count++;
+        }
+    }
+    out->promotions = t->promotions;
+    out->demotions = t->demotions;
+
+    return 0;
+}
@@ -139,8 +139,8 @@ int main(void) {
     printf("Maturity:                 %.2f\n", temporal.maturity);
     printf("Last reinforcement at:    %.2f\n", temporal.last_reinforcement_age);
     printf("Time since reinforcement: %.2f\n", temporal.time_since_reinforcement);
-    printf("Total updates:            %d\n", temporal.total_updates);
-    printf("Total reinforcements:     %d\n", temporal.total_reinforcements);
+    printf("Total updates:            %lld\n", temporal.total_updates);
+    printf("Total reinforcements:     %lld\n", temporal.total_reinforcements);
 
     /*========================================================================
      * S2S Calibration: Export signal
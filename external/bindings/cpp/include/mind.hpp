@@ -0,0 +1,341 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file mind.hpp
+ * @brief Header-only C++20 wrapper for the MIND public API
+ *
+ * Move-only RAII owners for cr_runtime_t/cr_state_t. Inputs are taken as
+ * std::span (or a strided batch_view) and handed to the C calls as-is:
+ * nothing is copied, and every member is a thin inline forwarder. Errors
+ * (the C functions returning -1) are reported as mind::error.
+ */
+
+#ifndef MIND_HPP
+#define MIND_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __has_include(<mdspan>)
+#include <mdspan>
+#endif
+
+#include "cr.h"
+
+namespace mind {
+
+/**
+ * @brief Raised when a C call reports failure
+ */
+class error : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+namespace detail {
+
+inline void check(int rc, const char* what) {
+    if (rc != 0) {
+        throw error(what);
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Non-owning view of a row-major batch with a row stride
+ *
+ * Row i starts at data() + i * stride(). Rows may be padded
+ * (stride > dim), so views over aligned or sliced buffers need no copy.
+ */
+template <class T>
+class batch_view {
+public:
+    constexpr batch_view() noexcept = default;
+
+    constexpr batch_view(T* data, std::size_t rows, std::size_t dim,
+                         std::size_t stride) noexcept
+        : data_(data), rows_(rows), dim_(dim), stride_(stride) {}
+
+    /** Densely packed rows */
+    constexpr batch_view(std::span<T> flat, std::size_t dim) noexcept
+        : data_(flat.data()),
+          rows_(dim ? flat.size() / dim : 0),
+          dim_(dim),
+          stride_(dim) {}
+
+    /** Mutable to const conversion */
+    template <class U>
+        requires std::is_convertible_v<U (*)[], T (*)[]>
+    constexpr batch_view(const batch_view<U>& other) noexcept
+        : data_(other.data()), rows_(other.rows()),
+          dim_(other.dim()), stride_(other.stride()) {}
+
+#if defined(__cpp_lib_mdspan)
+    /** Any 2D mdspan whose rows are contiguous (layout_right or layout_stride) */
+    template <class U, class Extents, class Layout, class Accessor>
+        requires(Extents::rank() == 2 &&
+                 std::is_convertible_v<U (*)[], T (*)[]>)
+    batch_view(const std::mdspan<U, Extents, Layout, Accessor>& m)
+        : data_(m.data_handle()), rows_(m.extent(0)), dim_(m.extent(1)),
+          stride_(m.stride(0)) {
+        if (m.extent(1) > 1 && m.stride(1) != 1) {
+            throw error("batch_view: rows must be contiguous");
+        }
+    }
+#endif
+
+    constexpr T* data() const noexcept { return data_; }
+    constexpr std::size_t rows() const noexcept { return rows_; }
+    constexpr std::size_t dim() const noexcept { return dim_; }
+    constexpr std::size_t stride() const noexcept { return stride_; }
+    constexpr bool empty() const noexcept { return rows_ == 0; }
+
+    constexpr std::span<T> operator[](std::size_t i) const noexcept {
+        return {data_ + i * stride_, dim_};
+    }
+
+private:
+    T* data_ = nullptr;
+    std::size_t rows_ = 0;
+    std::size_t dim_ = 0;
+    std::size_t stride_ = 0;
+};
+
+/**
+ * @brief Query result
+ *
+ * vector views the invariant inside the state; it stays valid until the
+ * next update, reset, load or destruction of that state.
+ */
+struct hint {
+    std::span<const float> vector;
+    float confidence = 0.0f;
+
+    static hint from(const cr_hint_t& h) noexcept {
+        return {{h.vector, static_cast<std::size_t>(h.vector ? h.dim : 0)},
+                h.confidence};
+    }
+};
+
+/**
+ * @brief Owning runtime handle
+ */
+class runtime {
+public:
+    explicit runtime(const cr_config_t& cfg)
+        : rt_(cr_runtime_create(&cfg)) {
+        if (!rt_) {
+            throw error("cr_runtime_create failed");
+        }
+    }
+
+    runtime(int dim, int max_slots, float initial_plasticity = 1.0f)
+        : runtime(make_config(dim, max_slots, initial_plasticity)) {}
+
+    runtime(const runtime&) = delete;
+    runtime& operator=(const runtime&) = delete;
+
+    runtime(runtime&& other) noexcept
+        : rt_(std::exchange(other.rt_, nullptr)) {}
+
+    runtime& operator=(runtime&& other) noexcept {
+        if (this != &other) {
+            cr_runtime_destroy(rt_);
+            rt_ = std::exchange(other.rt_, nullptr);
+        }
+        return *this;
+    }
+
+    ~runtime() { cr_runtime_destroy(rt_); }
+
+    cr_config_t config() const {
+        cr_config_t cfg{};
+        detail::check(cr_runtime_config(rt_, &cfg), "cr_runtime_config failed");
+        return cfg;
+    }
+
+    cr_runtime_t* get() const noexcept { return rt_; }
+    explicit operator bool() const noexcept { return rt_ != nullptr; }
+
+    /** Configuration with every optional field zero (default) */
+    static cr_config_t make_config(int dim, int max_slots,
+                                   float initial_plasticity = 1.0f) {
+        cr_config_t cfg{};
+        cfg.embedding_dim = dim;
+        cfg.max_memory_slots = max_slots;
+        cfg.initial_plasticity = initial_plasticity;
+        return cfg;
+    }
+
+private:
+    cr_runtime_t* rt_;
+};
+
+/**
+ * @brief Owning state handle
+ *
+ * The runtime must outlive the state (as with the C API).
+ */
+class state {
+public:
+    explicit state(runtime& rt) : st_(cr_state_create(rt.get())) {
+        if (!st_) {
+            throw error("cr_state_create failed");
+        }
+        dim_ = rt.config().embedding_dim;
+    }
+
+    state(const state&) = delete;
+    state& operator=(const state&) = delete;
+
+    state(state&& other) noexcept
+        : st_(std::exchange(other.st_, nullptr)), dim_(other.dim_) {}
+
+    state& operator=(state&& other) noexcept {
+        if (this != &other) {
+            cr_state_destroy(st_);
+            st_ = std::exchange(other.st_, nullptr);
+            dim_ = other.dim_;
+        }
+        return *this;
+    }
+
+    ~state() { cr_state_destroy(st_); }
+
+    /*------------------------------------------------------------------------
+     * Experience
+     *------------------------------------------------------------------------*/
+
+    void update(std::span<const float> embedding, float delta_t = 1.0f) {
+        detail::check(cr_state_update(st_, embedding.data(),
+                                      static_cast<int>(embedding.size()),
+                                      delta_t),
+                      "cr_state_update failed");
+    }
+
+    void update(batch_view<const float> rows, float delta_t = 1.0f) {
+        detail::check(cr_state_update_batch(st_, rows.data(),
+                                            static_cast<int>(rows.rows()),
+                                            static_cast<int>(rows.stride()),
+                                            static_cast<int>(rows.dim()),
+                                            delta_t),
+                      "cr_state_update_batch failed");
+    }
+
+    /*------------------------------------------------------------------------
+     * Query
+     *------------------------------------------------------------------------*/
+
+    hint query(std::span<const float> q) {
+        cr_hint_t h;
+        detail::check(cr_state_query(st_, q.data(),
+                                     static_cast<int>(q.size()), &h),
+                      "cr_state_query failed");
+        return hint::from(h);
+    }
+
+    /** Write one cr_hint_t per row into out (out.size() >= rows.rows()) */
+    void query(batch_view<const float> rows, std::span<cr_hint_t> out) {
+        if (out.size() < rows.rows()) {
+            throw error("query: output span too small");
+        }
+        detail::check(cr_state_query_batch(st_, rows.data(),
+                                           static_cast<int>(rows.rows()),
+                                           static_cast<int>(rows.stride()),
+                                           static_cast<int>(rows.dim()),
+                                           out.data()),
+                      "cr_state_query_batch failed");
+    }
+
+    /**
+     * One hint per row. The whole batch is one cr_state_query_batch()
+     * call: on a tiered state, rows hinted early in a batch stay put only
+     * until that call returns.
+     */
+    std::vector<hint> query(batch_view<const float> rows) {
+        std::vector<cr_hint_t> raw(rows.rows());
+        query(rows, std::span<cr_hint_t>(raw));
+        std::vector<hint> out(rows.rows());
+        for (std::size_t i = 0; i < raw.size(); i++) {
+            out[i] = hint::from(raw[i]);
+        }
+        return out;
+    }
+
+    /*------------------------------------------------------------------------
+     * Epistemic state
+     *------------------------------------------------------------------------*/
+
+    cr_plasticity_t plasticity() const {
+        cr_plasticity_t out;
+        detail::check(cr_state_plasticity(st_, &out), "cr_state_plasticity failed");
+        return out;
+    }
+
+    cr_temporal_t temporal() const {
+        cr_temporal_t out;
+        detail::check(cr_state_temporal(st_, &out), "cr_state_temporal failed");
+        return out;
+    }
+
+    cr_calibration_t calibration() const {
+        cr_calibration_t out;
+        detail::check(cr_state_calibration(st_, &out), "cr_state_calibration failed");
+        return out;
+    }
+
+    cr_rolling_t rolling() const {
+        cr_rolling_t out;
+        detail::check(cr_state_rolling(st_, &out), "cr_state_rolling failed");
+        return out;
+    }
+
+    int slot_count() const noexcept { return cr_state_slot_count(st_); }
+    int dim() const noexcept { return dim_; }
+
+    /*------------------------------------------------------------------------
+     * Lifecycle and persistence
+     *------------------------------------------------------------------------*/
+
+    void reset() noexcept { cr_state_reset(st_); }
+
+    void save(const std::string& path) {
+        detail::check(cr_state_save(st_, path.c_str()), "cr_state_save failed");
+    }
+
+    void load(const std::string& path) {
+        detail::check(cr_state_load(st_, path.c_str()), "cr_state_load failed");
+    }
+
+    cr_state_t* get() const noexcept { return st_; }
+    explicit operator bool() const noexcept { return st_ != nullptr; }
+
+private:
+    cr_state_t* st_;
+    int dim_ = 0;
+};
+
+}  // namespace mind
+
+#endif /* MIND_HPP */
@@ -0,0 +1,344 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file mind_async.hpp
+ * @brief C++20 coroutine interface on the submission queue
+ *
+ * mind::basic_async_state attaches a cr_queue_t to a mind::state and
+ * exposes awaitable update/query/save operations:
+ *
+ *     mind::async_state a(st);
+ *     co_await a.update(embedding);
+ *     mind::query_result r = co_await a.query(embedding);
+ *     co_await a.save("memory.state");
+ *
+ * Completion model: the queue's worker thread completes each operation
+ * and hands the suspended coroutine to an Executor, any callable taking
+ * std::coroutine_handle<>. The default inline_executor resumes it right
+ * there on the worker; pass e.g. a lambda that posts to an asio strand or
+ * a thread pool to resume elsewhere. No thread blocks per request.
+ *
+ * Operations execute in the order they are awaited. When the queue is
+ * full, operations wait in an overflow list that is drained as earlier
+ * ones complete, so awaiting never fails for lack of capacity.
+ */
+
+#ifndef MIND_ASYNC_HPP
+#define MIND_ASYNC_HPP
+
+#include <coroutine>
+#include <cstddef>
+#include <mutex>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mind.hpp"
+
+namespace mind {
+
+/**
+ * @brief Resume the coroutine on the thread that completed it
+ */
+struct inline_executor {
+    void operator()(std::coroutine_handle<> h) const { h.resume(); }
+};
+
+/**
+ * @brief Owned result of an asynchronous query
+ *
+ * The vector is a snapshot taken on the worker, unaffected by later updates.
+ */
+struct query_result {
+    std::vector<float> vector;  /**< Empty if the state held no invariants */
+    float confidence = 0.0f;
+};
+
+namespace async_detail {
+
+/**
+ * @brief One queued operation; lives in the awaiting coroutine's frame
+ */
+struct operation {
+    int op = 0;
+    const float* data = nullptr;
+    int count = 0;
+    int stride = 0;
+    int dim = 0;
+    float delta_t = 0.0f;
+    cr_hint_t* hints = nullptr;
+    float* vectors = nullptr;
+    std::string path;
+
+    int status = 0;
+    std::coroutine_handle<> handle;
+    operation* next = nullptr;  /**< Overflow list link */
+
+    int submit(cr_queue_t* q) {
+        auto tag = reinterpret_cast<unsigned long long>(this);
+        switch (op) {
+        case CR_OP_UPDATE:
+            return cr_queue_submit_update(q, data, count, stride, dim, delta_t, tag);
+        case CR_OP_QUERY:
+            return cr_queue_submit_query(q, data, count, stride, dim,
+                                         hints, vectors, tag);
+        case CR_OP_SAVE:
+            return cr_queue_submit_save(q, path.c_str(), tag);
+        default:
+            return -1;
+        }
+    }
+};
+
+}  // namespace async_detail
+
+template <class Executor = inline_executor>
+class basic_async_state {
+    using operation = async_detail::operation;
+
+public:
+    /**
+     * @brief Attach a queue to st (which must outlive this object)
+     *
+     * While attached, st must only be used through this object. Every
+     * awaited operation must complete before destruction, and destruction
+     * must not run on the queue worker (with inline_executor, a coroutine
+     * resumed by an await must hand teardown to another thread).
+     */
+    explicit basic_async_state(state& st, int capacity = 256,
+                               Executor executor = Executor())
+        : executor_(std::move(executor)),
+          queue_(cr_queue_create(st.get(), capacity)),
+          dim_(st.dim()) {
+        if (!queue_) {
+            throw error("cr_queue_create failed");
+        }
+        cr_queue_set_notify(queue_, &basic_async_state::on_complete, this);
+    }
+
+    basic_async_state(const basic_async_state&) = delete;
+    basic_async_state& operator=(const basic_async_state&) = delete;
+
+    ~basic_async_state() { cr_queue_destroy(queue_); }
+
+    /*------------------------------------------------------------------------
+     * Awaitables
+     *------------------------------------------------------------------------*/
+
+    class [[nodiscard]] awaiter_base {
+    public:
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> h) {
+            op_.handle = h;
+            /* Once queued, another thread may resume h: do not touch this */
+            return owner_->enqueue(&op_);
+        }
+
+    protected:
+        awaiter_base(basic_async_state* owner) : owner_(owner) {}
+
+        void check() const {
+            if (op_.status != 0) {
+                throw error("mind: asynchronous operation failed");
+            }
+        }
+
+        basic_async_state* owner_;
+        operation op_;
+    };
+
+    class [[nodiscard]] update_awaiter : public awaiter_base {
+    public:
+        update_awaiter(basic_async_state* owner, batch_view<const float> rows,
+                       float delta_t)
+            : awaiter_base(owner) {
+            this->op_.op = CR_OP_UPDATE;
+            this->op_.data = rows.data();
+            this->op_.count = static_cast<int>(rows.rows());
+            this->op_.stride = static_cast<int>(rows.stride());
+            this->op_.dim = static_cast<int>(rows.dim());
+            this->op_.delta_t = delta_t;
+        }
+
+        void await_resume() const { this->check(); }
+    };
+
+    class [[nodiscard]] query_awaiter : public awaiter_base {
+    public:
+        query_awaiter(basic_async_state* owner, std::span<const float> q)
+            : awaiter_base(owner), vector_(q.size()) {
+            this->op_.op = CR_OP_QUERY;
+            this->op_.data = q.data();
+            this->op_.count = 1;
+            this->op_.stride = static_cast<int>(q.size());
+            this->op_.dim = static_cast<int>(q.size());
+            this->op_.hints = &hint_;
+            this->op_.vectors = vector_.data();
+        }
+
+        query_result await_resume() {
+            this->check();
+            if (!hint_.vector) {
+                vector_.clear();
+            }
+            return {std::move(vector_), hint_.confidence};
+        }
+
+    private:
+        cr_hint_t hint_{};
+        std::vector<float> vector_;
+    };
+
+    class [[nodiscard]] query_batch_awaiter : public awaiter_base {
+    public:
+        query_batch_awaiter(basic_async_state* owner,
+                            batch_view<const float> rows,
+                            std::span<cr_hint_t> out_hints,
+                            std::span<float> out_vectors)
+            : awaiter_base(owner) {
+            this->op_.op = CR_OP_QUERY;
+            this->op_.data = rows.data();
+            this->op_.count = static_cast<int>(rows.rows());
+            this->op_.stride = static_cast<int>(rows.stride());
+            this->op_.dim = static_cast<int>(rows.dim());
+            this->op_.hints = out_hints.data();
+            this->op_.vectors = out_vectors.data();
+            if (out_hints.size() < rows.rows() ||
+                (!out_vectors.empty() &&
+                 out_vectors.size() < rows.rows() * rows.dim())) {
+                this->op_.op = 0;  /* Fails without being queued */
+            }
+        }
+
+        void await_resume() const { this->check(); }
+    };
+
+    class [[nodiscard]] save_awaiter : public awaiter_base {
+    public:
+        save_awaiter(basic_async_state* owner, std::string path)
+            : awaiter_base(owner) {
+            this->op_.op = CR_OP_SAVE;
+            this->op_.path = std::move(path);
+        }
+
+        void await_resume() const { this->check(); }
+    };
+
+    /** Rows and embedding must stay valid until the await completes */
+    update_awaiter update(std::span<const float> embedding, float delta_t = 1.0f) {
+        return {this, batch_view<const float>(embedding.data(), 1,
+                                              embedding.size(), embedding.size()),
+                delta_t};
+    }
+
+    update_awaiter update(batch_view<const float> rows, float delta_t = 1.0f) {
+        return {this, rows, delta_t};
+    }
+
+    query_awaiter query(std::span<const float> q) { return {this, q}; }
+
+    /**
+     * @brief Batch query into caller buffers
+     *
+     * out_vectors (rows × dim floats) receives hint snapshots; pass an
+     * empty span to keep hints pointing into the state instead.
+     */
+    query_batch_awaiter query(batch_view<const float> rows,
+                              std::span<cr_hint_t> out_hints,
+                              std::span<float> out_vectors = {}) {
+        return {this, rows, out_hints, out_vectors};
+    }
+
+    save_awaiter save(std::string path) { return {this, std::move(path)}; }
+
+    int dim() const noexcept { return dim_; }
+
+private:
+    /* Returns false if the operation failed without being queued */
+    bool enqueue(operation* op) {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (!overflow_head_) {
+            if (op->submit(queue_) == 0) {
+                pending_++;
+                return true;
+            }
+            if (pending_ == 0) {
+                op->status = -1;  /* Invalid arguments, not back-pressure */
+                return false;
+            }
+        }
+        op->next = nullptr;
+        if (overflow_tail_) {
+            overflow_tail_->next = op;
+        } else {
+            overflow_head_ = op;
+        }
+        overflow_tail_ = op;
+        return true;
+    }
+
+    static void on_complete(void* ctx, const cr_completion_t* c) {
+        auto* self = static_cast<basic_async_state*>(ctx);
+        auto* op = reinterpret_cast<operation*>(c->tag);
+        op->status = c->status;
+
+        std::vector<operation*> failed;
+        {
+            std::lock_guard<std::mutex> guard(self->lock_);
+            self->pending_--;
+            while (operation* next = self->overflow_head_) {
+                if (next->submit(self->queue_) != 0) {
+                    if (self->pending_ > 0) {
+                        break;  /* Still full: retry on the next completion */
+                    }
+                    next->status = -1;
+                    failed.push_back(next);
+                } else {
+                    self->pending_++;
+                }
+                self->overflow_head_ = next->next;
+                if (!self->overflow_head_) {
+                    self->overflow_tail_ = nullptr;
+                }
+            }
+        }
+
+        /* Resuming may end the last await and destroy *self */
+        Executor executor = self->executor_;
+        executor(op->handle);
+        for (operation* f : failed) {
+            executor(f->handle);
+        }
+    }
+
+    Executor executor_;
+    cr_queue_t* queue_;
+    int dim_;
+
+    std::mutex lock_;
+    int pending_ = 0;  /**< Operations handed to the queue, not yet completed */
+    operation* overflow_head_ = nullptr;
+    operation* overflow_tail_ = nullptr;
+};
+
+using async_state = basic_async_state<inline_executor>;
+
+}  // namespace mind
+
+#endif /* MIND_ASYNC_HPP */
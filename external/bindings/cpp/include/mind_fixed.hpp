@@ -0,0 +1,329 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file mind_fixed.hpp
+ * @brief Compile-time fixed-dimension states (C++20)
+ *
+ * mind::basic_state<Dim, Storage> is a cr_state_t whose embedding
+ * dimension is fixed at compile time:
+ *
+ * - Inputs are std::span<const float, Dim>; a wrong size does not compile.
+ * - Every update and query is the C call on the underlying state, so a
+ *   fixed state makes exactly the decisions cr_state_t makes, including
+ *   weight decay, expiry, the two-level index, tiering and quotas
+ *   (configure those through cr_config_t or get()).
+ * - The Storage policy selects how rows read back with row() are encoded:
+ *   storage::fp32, storage::fp16 (IEEE binary16) or storage::int8
+ *   (symmetric, per-row scale). The state itself keeps fp32 rows.
+ */
+
+#ifndef MIND_FIXED_HPP
+#define MIND_FIXED_HPP
+
+#include <array>
+#include <climits>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+#include "cr.h"
+#include "mind.hpp"
+
+namespace mind {
+
+namespace fixed_detail {
+
+/* IEEE 754 binary16 <-> binary32, round to nearest even */
+inline std::uint16_t float_to_half(float f) {
+    std::uint32_t x;
+    std::memcpy(&x, &f, sizeof(x));
+    std::uint32_t sign = (x >> 16) & 0x8000u;
+    std::uint32_t mag = x & 0x7FFFFFFFu;
+
+    if (mag >= 0x7F800000u) {                      /* Inf / NaN */
+        return static_cast<std::uint16_t>(
+            sign | 0x7C00u | (mag > 0x7F800000u ? 0x200u : 0u));
+    }
+    if (mag >= 0x477FF000u) {                      /* Overflow -> Inf */
+        return static_cast<std::uint16_t>(sign | 0x7C00u);
+    }
+    if (mag < 0x38800000u) {                       /* Subnormal / zero */
+        if (mag < 0x33000000u) {
+            return static_cast<std::uint16_t>(sign);
+        }
+        std::uint32_t m = (mag & 0x7FFFFFu) | 0x800000u;
+        int shift = 126 - static_cast<int>(mag >> 23);
+        std::uint32_t half = m >> (shift + 1);
+        std::uint32_t rem = m & ((1u << (shift + 1)) - 1u);
+        std::uint32_t mid = 1u << shift;
+        if (rem > mid || (rem == mid && (half & 1u))) {
+            half++;
+        }
+        return static_cast<std::uint16_t>(sign | half);
+    }
+    std::uint32_t h = ((mag >> 13) - (112u << 10));
+    std::uint32_t rem = mag & 0x1FFFu;
+    if (rem > 0x1000u || (rem == 0x1000u && (h & 1u))) {
+        h++;
+    }
+    return static_cast<std::uint16_t>(sign | h);
+}
+
+inline float half_to_float(std::uint16_t h) {
+    std::uint32_t sign = static_cast<std::uint32_t>(h & 0x8000u) << 16;
+    std::uint32_t exp = (h >> 10) & 0x1Fu;
+    std::uint32_t man = h & 0x3FFu;
+    std::uint32_t x;
+
+    if (exp == 0) {
+        if (man == 0) {
+            x = sign;
+        } else {                                   /* Renormalize subnormal */
+            exp = 113;
+            while (!(man & 0x400u)) {
+                man <<= 1;
+                exp--;
+            }
+            x = sign | (exp << 23) | ((man & 0x3FFu) << 13);
+        }
+    } else if (exp == 0x1F) {
+        x = sign | 0x7F800000u | (man << 13);
+    } else {
+        x = sign | ((exp + 112u) << 23) | (man << 13);
+    }
+
+    float f;
+    std::memcpy(&f, &x, sizeof(f));
+    return f;
+}
+
+}  // namespace fixed_detail
+
+/*============================================================================
+ * Storage policies
+ *============================================================================*/
+
+namespace storage {
+
+/**
+ * @brief Full precision rows (4 bytes per element)
+ */
+struct fp32 {
+    template <std::size_t Dim>
+    struct alignas(64) row {
+        float v[Dim];
+
+        float get(std::size_t i) const { return v[i]; }
+        void set(const float* in) { std::memcpy(v, in, sizeof(v)); }
+    };
+};
+
+/**
+ * @brief IEEE binary16 rows (2 bytes per element)
+ */
+struct fp16 {
+    template <std::size_t Dim>
+    struct alignas(64) row {
+        std::uint16_t h[Dim];
+
+        float get(std::size_t i) const { return fixed_detail::half_to_float(h[i]); }
+        void set(const float* in) {
+            for (std::size_t i = 0; i < Dim; i++) {
+                h[i] = fixed_detail::float_to_half(in[i]);
+            }
+        }
+    };
+};
+
+/**
+ * @brief Symmetric int8 rows with a per-row scale (1 byte per element)
+ */
+struct int8 {
+    template <std::size_t Dim>
+    struct alignas(64) row {
+        std::int8_t q[Dim];
+        float scale;
+
+        float get(std::size_t i) const { return static_cast<float>(q[i]) * scale; }
+        void set(const float* in) {
+            float max_abs = 0.0f;
+            for (std::size_t i = 0; i < Dim; i++) {
+                max_abs = std::fmax(max_abs, std::fabs(in[i]));
+            }
+            scale = max_abs > 0.0f ? max_abs / 127.0f : 0.0f;
+            for (std::size_t i = 0; i < Dim; i++) {
+                q[i] = scale > 0.0f
+                    ? static_cast<std::int8_t>(std::lrint(in[i] / scale))
+                    : 0;
+            }
+        }
+    };
+};
+
+}  // namespace storage
+
+/**
+ * @brief Requirements on a Storage policy for dimension Dim
+ */
+template <class S, std::size_t Dim>
+concept storage_policy = requires(typename S::template row<Dim> r,
+                                  const typename S::template row<Dim> cr,
+                                  const float* in, std::size_t i) {
+    { cr.get(i) } -> std::same_as<float>;
+    r.set(in);
+};
+
+/**
+ * @brief Result of basic_state::query()
+ *
+ * vector points at the matched invariant inside the state (nullptr if
+ * the state is empty); it stays valid until the next update, reset, load
+ * or destruction of that state.
+ */
+template <std::size_t Dim>
+struct basic_hint {
+    const float* vector = nullptr;
+    float confidence = 0.0f;  /**< Derived confidence in [0, 1] */
+
+    explicit operator bool() const noexcept { return vector != nullptr; }
+
+    /** The invariant (the hint must not be empty) */
+    std::span<const float, Dim> view() const noexcept {
+        return std::span<const float, Dim>(vector, Dim);
+    }
+};
+
+/*============================================================================
+ * basic_state
+ *============================================================================*/
+
+template <std::size_t Dim, class Storage = storage::fp32>
+class basic_state {
+    static_assert(Dim > 0, "mind::basic_state: Dim must be positive");
+    static_assert(Dim <= static_cast<std::size_t>(INT_MAX),
+                  "mind::basic_state: Dim exceeds INT_MAX");
+    static_assert(storage_policy<Storage, Dim>,
+                  "mind::basic_state: Storage is not a storage policy");
+
+public:
+    static constexpr std::size_t dim = Dim;
+    using storage_type = Storage;
+    using row_type = typename Storage::template row<Dim>;
+    using vector_type = std::array<float, Dim>;
+    using hint = basic_hint<Dim>;
+
+    explicit basic_state(std::size_t max_slots)
+        : basic_state(runtime::make_config(static_cast<int>(Dim), slots(max_slots))) {}
+
+    /** Optional fields of cfg apply as for cr_runtime_create(); embedding_dim is Dim */
+    explicit basic_state(cr_config_t cfg)
+        : rt_(with_dim(cfg)), st_(rt_) {}
+
+    /*------------------------------------------------------------------------
+     * Experience
+     *------------------------------------------------------------------------*/
+
+    void update(std::span<const float, Dim> e, float delta_t = 1.0f) {
+        st_.update(e, delta_t);
+    }
+
+    /*------------------------------------------------------------------------
+     * Query
+     *------------------------------------------------------------------------*/
+
+    hint query(std::span<const float, Dim> q) {
+        cr_hint_t h;
+        detail::check(cr_state_query(st_.get(), q.data(), static_cast<int>(Dim), &h),
+                      "cr_state_query failed");
+        return {h.vector, h.confidence};
+    }
+
+    /** Copy of the invariant a hint points at (zeros for an empty hint) */
+    vector_type invariant(const hint& h) const {
+        vector_type out{};
+        if (h) {
+            std::memcpy(out.data(), h.vector, sizeof(out));
+        }
+        return out;
+    }
+
+    /** The invariant encoded with the Storage policy */
+    row_type row(const hint& h) const {
+        vector_type v = invariant(h);
+        row_type r;
+        r.set(v.data());
+        return r;
+    }
+
+    /*------------------------------------------------------------------------
+     * Epistemic state
+     *------------------------------------------------------------------------*/
+
+    cr_plasticity_t plasticity() const { return st_.plasticity(); }
+    cr_temporal_t temporal() const { return st_.temporal(); }
+    cr_calibration_t calibration() const { return st_.calibration(); }
+    cr_rolling_t rolling() const { return st_.rolling(); }
+
+    std::size_t slot_count() const noexcept {
+        return static_cast<std::size_t>(st_.slot_count());
+    }
+    std::size_t max_slots() const {
+        return static_cast<std::size_t>(rt_.config().max_memory_slots);
+    }
+
+    /*------------------------------------------------------------------------
+     * Lifecycle and persistence
+     *------------------------------------------------------------------------*/
+
+    void reset() noexcept { st_.reset(); }
+
+    /** Files are interchangeable with any cr_state_t of dimension Dim */
+    void save(const std::string& path) { st_.save(path); }
+    void load(const std::string& path) { st_.load(path); }
+
+    /** Underlying state, for the rest of the C API */
+    cr_state_t* get() const noexcept { return st_.get(); }
+
+private:
+    static int slots(std::size_t max_slots) {
+        if (max_slots == 0 || max_slots > static_cast<std::size_t>(INT_MAX)) {
+            throw std::invalid_argument("mind::basic_state: invalid max_slots");
+        }
+        return static_cast<int>(max_slots);
+    }
+
+    static cr_config_t with_dim(cr_config_t cfg) {
+        cfg.embedding_dim = static_cast<int>(Dim);
+        return cfg;
+    }
+
+    runtime rt_;  /* Declared first: outlives st_ */
+    state st_;
+};
+
+/** Full-precision fixed-dimension state */
+template <std::size_t Dim>
+using fixed_state = basic_state<Dim, storage::fp32>;
+
+}  // namespace mind
+
+#endif /* MIND_FIXED_HPP */
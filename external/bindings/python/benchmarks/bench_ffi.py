@@ -0,0 +1,177 @@
+# Copyright 2026 The MIND Contributors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+FFI overhead microbenchmarks for the MIND Python bindings.
+
+Measures per-call latency of update/query through ctypes (single and
+batched, list and numpy inputs) and reports it against the raw C
+baseline produced by bench/mind_bench.c on the same workload.
+
+The workload is steady state: a fixed set of random patterns is learned
+once and then cycled, so every timed call scans the same number of slots
+on both sides.
+
+Usage (from the repository root, after `make shared bench`):
+    MIND_LIB_PATH=build/libmind.so PYTHONPATH=external/bindings/python \\
+        python3 external/bindings/python/benchmarks/bench_ffi.py
+
+numpy is optional; numpy rows are skipped when it is not installed.
+"""
+
+import argparse
+import json
+import os
+import random
+import subprocess
+import sys
+import time
+from pathlib import Path
+
+from mind import MindState
+
+try:
+    import numpy
+except ImportError:  # pragma: no cover - optional
+    numpy = None
+
+
+def _default_c_bench() -> Path:
+    root = Path(__file__).resolve().parents[4]
+    return root / "build" / "mind_bench"
+
+
+def run_c_baseline(path, dim, patterns, iterations):
+    """Run the C harness and parse its "key value" lines."""
+    if not path or not Path(path).exists():
+        return {}
+    out = subprocess.run(
+        [str(path), str(dim), str(patterns), str(iterations)],
+        check=True,
+        capture_output=True,
+        text=True,
+    ).stdout
+    result = {}
+    for line in out.splitlines():
+        key, _, value = line.partition(" ")
+        try:
+            result[key] = float(value)
+        except ValueError:
+            pass
+    return result
+
+
+def time_per_call(fn, calls):
+    """Nanoseconds per call for fn(i) over `calls` iterations."""
+    start = time.perf_counter_ns()
+    for i in range(calls):
+        fn(i)
+    return (time.perf_counter_ns() - start) / calls
+
+
+def time_per_row(fn, rounds, rows):
+    """Nanoseconds per row for a batched fn() called `rounds` times."""
+    start = time.perf_counter_ns()
+    for _ in range(rounds):
+        fn()
+    return (time.perf_counter_ns() - start) / (rounds * rows)
+
+
+def run_python(dim, patterns, iterations, seed=0x4D494E44):
+    rng = random.Random(seed)
+    data = [[rng.uniform(-1.0, 1.0) for _ in range(dim)] for _ in range(patterns)]
+    rounds = max(1, iterations // patterns)
+
+    state = MindState(dim=dim, slots=patterns)
+    state.update_batch(data)
+
+    results = {}
+    results["update_list"] = time_per_call(
+        lambda i: state.update(data[i % patterns]), iterations)
+    results["query_list"] = time_per_call(
+        lambda i: state.query(data[i % patterns]), iterations)
+    results["update_batch_list"] = time_per_row(
+        lambda: state.update_batch(data), rounds, patterns)
+    results["query_batch_list"] = time_per_row(
+        lambda: state.query_batch(data), rounds, patterns)
+
+    if numpy is not None:
+        arr = numpy.asarray(data, dtype=numpy.float32)
+        rows = [arr[i] for i in range(patterns)]
+        results["update_numpy"] = time_per_call(
+            lambda i: state.update(rows[i % patterns]), iterations)
+        results["query_numpy"] = time_per_call(
+            lambda i: state.query(rows[i % patterns]), iterations)
+        results["update_batch_numpy"] = time_per_row(
+            lambda: state.update_batch(arr), rounds, patterns)
+        results["query_batch_numpy"] = time_per_row(
+            lambda: state.query_batch(arr), rounds, patterns)
+
+    return results
+
+
+# Which C measurement each Python path is compared against
+_BASELINE = {
+    "update_list": "update_ns",
+    "update_numpy": "update_ns",
+    "update_batch_list": "update_batch_ns",
+    "update_batch_numpy": "update_batch_ns",
+    "query_list": "query_ns",
+    "query_numpy": "query_ns",
+    "query_batch_list": "query_batch_ns",
+    "query_batch_numpy": "query_batch_ns",
+}
+
+
+def report(py, c):
+    print(f"{'path':<22}{'ns/call':>12}{'raw C':>12}{'overhead':>12}{'ratio':>8}")
+    print("-" * 66)
+    for name, ns in py.items():
+        base = c.get(_BASELINE[name])
+        if base:
+            print(f"{name:<22}{ns:>12.1f}{base:>12.1f}"
+                  f"{ns - base:>12.1f}{ns / base:>8.2f}")
+        else:
+            print(f"{name:<22}{ns:>12.1f}{'n/a':>12}{'n/a':>12}{'n/a':>8}")
+    if numpy is None:
+        print("\n(numpy not installed: numpy rows skipped)")
+    if not c:
+        print("\n(C baseline not found: build it with `make bench`)")
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("--dim", type=int, default=768)
+    parser.add_argument("--patterns", type=int, default=64)
+    parser.add_argument("--iterations", type=int, default=20000)
+    parser.add_argument("--c-bench", default=os.environ.get(
+        "MIND_BENCH_PATH", str(_default_c_bench())))
+    parser.add_argument("--json", action="store_true",
+                        help="emit machine-readable results")
+    args = parser.parse_args(argv)
+
+    c = run_c_baseline(args.c_bench, args.dim, args.patterns, args.iterations)
+    py = run_python(args.dim, args.patterns, args.iterations)
+
+    if args.json:
+        json.dump({"config": vars(args), "python_ns": py, "c_ns": c},
+                  sys.stdout, indent=2)
+        print()
+    else:
+        report(py, c)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -19,15 +19,19 @@ Pure Python bindings using ctypes. Zero dependencies.
 """
 
 from mind._ffi import MindState, MindConfig, load_library
-from mind._ffi import Hint, Plasticity, Temporal, Calibration
+from mind._ffi import Hint, Plasticity, Temporal, Calibration, Rolling, RollingStat
+from mind.aio import AsyncMindState
 
 __version__ = "0.1.0"
 __all__ = [
     "MindState",
+    "AsyncMindState",
     "MindConfig",
     "Hint",
     "Plasticity",
     "Temporal",
     "Calibration",
+    "Rolling",
+    "RollingStat",
     "load_library",
 ]
@@ -37,6 +37,9 @@ class _CrConfig(ctypes.Structure):
         ("embedding_dim", ctypes.c_int),
         ("max_memory_slots", ctypes.c_int),
         ("initial_plasticity", ctypes.c_float),
+        ("coarse_slots", ctypes.c_int),
+        ("coarse_probe", ctypes.c_int),
+        ("weight_half_life", ctypes.c_float),
     ]
 
 
@@ -54,21 +57,21 @@ class _CrPlasticity(ctypes.Structure):
     _fields_ = [
         ("plasticity", ctypes.c_float),
         ("stability", ctypes.c_float),
-        ("age", ctypes.c_float),
+        ("age", ctypes.c_double),
     ]
 
 
 class _CrTemporal(ctypes.Structure):
     """Maps to cr_temporal_t"""
     _fields_ = [
-        ("age", ctypes.c_float),
+        ("age", ctypes.c_double),
         ("plasticity", ctypes.c_float),
         ("velocity", ctypes.c_float),
-        ("maturity", ctypes.c_float),
-        ("last_reinforcement_age", ctypes.c_float),
-        ("time_since_reinforcement", ctypes.c_float),
-        ("total_updates", ctypes.c_int),
-        ("total_reinforcements", ctypes.c_int),
+        ("maturity", ctypes.c_double),
+        ("last_reinforcement_age", ctypes.c_double),
+        ("time_since_reinforcement", ctypes.c_double),
+        ("total_updates", ctypes.c_longlong),
+        ("total_reinforcements", ctypes.c_longlong),
     ]
 
 
@@ -83,9 +86,41 @@ class _CrCalibration(ctypes.Structure):
     ]
 
 
+_CR_ROLLING_HORIZONS = 3
+
+
+class _CrRollingStat(ctypes.Structure):
+    """Maps to cr_rolling_stat_t"""
+    _fields_ = [
+        ("horizon", ctypes.c_int),
+        ("updates", ctypes.c_int),
+        ("velocity", ctypes.c_float),
+        ("reinforcement_ratio", ctypes.c_float),
+        ("create_rate", ctypes.c_float),
+    ]
+
+
+class _CrRolling(ctypes.Structure):
+    """Maps to cr_rolling_t"""
+    _fields_ = [
+        ("ewma", _CrRollingStat * _CR_ROLLING_HORIZONS),
+        ("window", _CrRollingStat * _CR_ROLLING_HORIZONS),
+    ]
+
+
+class _CrCompletion(ctypes.Structure):
+    """Maps to cr_completion_t"""
+    _fields_ = [
+        ("tag", ctypes.c_ulonglong),
+        ("op", ctypes.c_int),
+        ("status", ctypes.c_int),
+    ]
+
+
 # Opaque pointers
 _CrRuntime = ctypes.c_void_p
 _CrState = ctypes.c_void_p
+_CrQueue = ctypes.c_void_p
 
 # =============================================================================
 # Python Data Classes (Pythonic interface)
@@ -138,6 +173,23 @@ class Calibration:
     reinforcement_ratio: float
 
 
+@dataclass
+class RollingStat:
+    """Smoothed statistics over one horizon (in updates)."""
+    horizon: int
+    updates: int
+    velocity: float
+    reinforcement_ratio: float
+    create_rate: float
+
+
+@dataclass
+class Rolling:
+    """Rolling temporal statistics: EWMAs and exact windows per horizon."""
+    ewma: List[RollingStat]
+    window: List[RollingStat]
+
+
 # =============================================================================
 # Library Loading
 # =============================================================================
@@ -270,6 +322,28 @@ def _setup_functions(lib: ctypes.CDLL) -> None:
     ]
     lib.cr_state_query.restype = ctypes.c_int
 
+    # cr_state_update_batch
+    lib.cr_state_update_batch.argtypes = [
+        _CrState,
+        ctypes.POINTER(ctypes.c_float),
+        ctypes.c_int,
+        ctypes.c_int,
+        ctypes.c_int,
+        ctypes.c_float,
+    ]
+    lib.cr_state_update_batch.restype = ctypes.c_int
+
+    # cr_state_query_batch
+    lib.cr_state_query_batch.argtypes = [
+        _CrState,
+        ctypes.POINTER(ctypes.c_float),
+        ctypes.c_int,
+        ctypes.c_int,
+        ctypes.c_int,
+        ctypes.POINTER(_CrHint),
+    ]
+    lib.cr_state_query_batch.restype = ctypes.c_int
+
     # cr_state_plasticity
     lib.cr_state_plasticity.argtypes = [_CrState, ctypes.POINTER(_CrPlasticity)]
     lib.cr_state_plasticity.restype = ctypes.c_int
@@ -282,6 +356,10 @@ def _setup_functions(lib: ctypes.CDLL) -> None:
     lib.cr_state_calibration.argtypes = [_CrState, ctypes.POINTER(_CrCalibration)]
     lib.cr_state_calibration.restype = ctypes.c_int
 
+    # cr_state_rolling
+    lib.cr_state_rolling.argtypes = [_CrState, ctypes.POINTER(_CrRolling)]
+    lib.cr_state_rolling.restype = ctypes.c_int
+
     # cr_state_save
     lib.cr_state_save.argtypes = [_CrState, ctypes.c_char_p]
     lib.cr_state_save.restype = ctypes.c_int
@@ -290,6 +368,51 @@ def _setup_functions(lib: ctypes.CDLL) -> None:
     lib.cr_state_load.argtypes = [_CrState, ctypes.c_char_p]
     lib.cr_state_load.restype = ctypes.c_int
 
+    # cr_queue_create
+    lib.cr_queue_create.argtypes = [_CrState, ctypes.c_int]
+    lib.cr_queue_create.restype = _CrQueue
+
+    # cr_queue_destroy
+    lib.cr_queue_destroy.argtypes = [_CrQueue]
+    lib.cr_queue_destroy.restype = None
+
+    # cr_queue_fd
+    lib.cr_queue_fd.argtypes = [_CrQueue]
+    lib.cr_queue_fd.restype = ctypes.c_int
+
+    # cr_queue_submit_update
+    lib.cr_queue_submit_update.argtypes = [
+        _CrQueue,
+        ctypes.POINTER(ctypes.c_float),
+        ctypes.c_int,
+        ctypes.c_int,
+        ctypes.c_int,
+        ctypes.c_float,
+        ctypes.c_ulonglong,
+    ]
+    lib.cr_queue_submit_update.restype = ctypes.c_int
+
+    # cr_queue_submit_query
+    lib.cr_queue_submit_query.argtypes = [
+        _CrQueue,
+        ctypes.POINTER(ctypes.c_float),
+        ctypes.c_int,
+        ctypes.c_int,
+        ctypes.c_int,
+        ctypes.POINTER(_CrHint),
+        ctypes.POINTER(ctypes.c_float),
+        ctypes.c_ulonglong,
+    ]
+    lib.cr_queue_submit_query.restype = ctypes.c_int
+
+    # cr_queue_submit_save
+    lib.cr_queue_submit_save.argtypes = [_CrQueue, ctypes.c_char_p, ctypes.c_ulonglong]
+    lib.cr_queue_submit_save.restype = ctypes.c_int
+
+    # cr_queue_poll
+    lib.cr_queue_poll.argtypes = [_CrQueue, ctypes.POINTER(_CrCompletion), ctypes.c_int]
+    lib.cr_queue_poll.restype = ctypes.c_int
+
 
 # =============================================================================
 # MindState Class
@@ -315,6 +438,10 @@ class MindState:
         slots: int,
         initial_plasticity: float = 1.0,
         lib_path: Optional[str] = None,
+        *,
+        coarse_slots: int = 0,
+        coarse_probe: int = 0,
+        weight_half_life: float = 0.0,
     ):
         """
         Create a new MIND state.
@@ -324,6 +451,10 @@ class MindState:
             slots: Maximum memory slots.
             initial_plasticity: Starting plasticity (default 1.0).
             lib_path: Optional path to libmind.
+            coarse_slots: Two-level memory summaries (0 = flat scan).
+            coarse_probe: Coarse buckets searched per lookup (0 = 1).
+            weight_half_life: Age over which invariant weights halve
+                (0 = no decay).
         """
         self._lib = load_library(lib_path)
         self._dim = dim
@@ -333,6 +464,9 @@ class MindState:
             embedding_dim=dim,
             max_memory_slots=slots,
             initial_plasticity=initial_plasticity,
+            coarse_slots=coarse_slots,
+            coarse_probe=coarse_probe,
+            weight_half_life=weight_half_life,
         )
 
         # Create runtime
@@ -386,6 +520,42 @@ class MindState:
         arr = (ctypes.c_float * len(embedding))(*embedding)
         return arr
 
+    def _to_float_rows(
+        self,
+        embeddings: Union[List[List[float]], "numpy.ndarray"],
+    ):
+        """
+        Convert a batch to (pointer, count, stride) without per-row calls.
+
+        A C-contiguous float32 numpy array is passed through as-is; any
+        row stride numpy reports is forwarded to C. Lists are flattened
+        into a single ctypes buffer.
+        """
+        if hasattr(embeddings, "ctypes") and hasattr(embeddings, "strides"):
+            if embeddings.ndim != 2 or embeddings.shape[1] != self._dim:
+                raise ValueError(
+                    f"Batch shape {embeddings.shape} doesn't match "
+                    f"(n, {self._dim})"
+                )
+            dtype = embeddings.dtype
+            if (dtype.kind != "f" or dtype.itemsize != 4 or not dtype.isnative
+                    or embeddings.strides[1] != 4):
+                raise ValueError("Batch must be float32 with contiguous rows")
+            stride = embeddings.strides[0] // 4
+            ptr = embeddings.ctypes.data_as(ctypes.POINTER(ctypes.c_float))
+            return ptr, embeddings.shape[0], stride
+
+        count = len(embeddings)
+        flat = (ctypes.c_float * (count * self._dim))()
+        for i, row in enumerate(embeddings):
+            if len(row) != self._dim:
+                raise ValueError(
+                    f"Embedding dimension {len(row)} doesn't match "
+                    f"configured dimension {self._dim}"
+                )
+            flat[i * self._dim:(i + 1) * self._dim] = row
+        return flat, count, self._dim
+
     def update(
         self,
         embedding: Union[List[float], "numpy.ndarray"],
@@ -420,6 +590,39 @@ class MindState:
         if result != 0:
             raise RuntimeError("Failed to update state")
 
+    def update_batch(
+        self,
+        embeddings: Union[List[List[float]], "numpy.ndarray"],
+        delta_t: float = 1.0,
+    ) -> None:
+        """
+        Update state with a batch of experiences in a single C call.
+
+        Equivalent to calling update() once per row, in order.
+
+        Args:
+            embeddings: Sequence of vectors or 2D float32 numpy array.
+            delta_t: Time increment per row (must be positive).
+
+        Raises:
+            ValueError: If a row dimension doesn't match or delta_t <= 0.
+            RuntimeError: If update fails.
+        """
+        if delta_t <= 0:
+            raise ValueError("delta_t must be positive")
+
+        rows, count, stride = self._to_float_rows(embeddings)
+        result = self._lib.cr_state_update_batch(
+            self._state,
+            rows,
+            count,
+            stride,
+            self._dim,
+            ctypes.c_float(delta_t),
+        )
+        if result != 0:
+            raise RuntimeError("Failed to update state")
+
     def query(
         self,
         embedding: Union[List[float], "numpy.ndarray"],
@@ -466,6 +669,46 @@ class MindState:
             confidence=hint.confidence,
         )
 
+    def query_batch(
+        self,
+        embeddings: Union[List[List[float]], "numpy.ndarray"],
+    ) -> List[Hint]:
+        """
+        Query state for a batch of hints in a single C call.
+
+        Args:
+            embeddings: Sequence of vectors or 2D float32 numpy array.
+
+        Returns:
+            One Hint per row.
+
+        Raises:
+            ValueError: If a row dimension doesn't match.
+            RuntimeError: If query fails.
+        """
+        rows, count, stride = self._to_float_rows(embeddings)
+        hints = (_CrHint * count)()
+
+        result = self._lib.cr_state_query_batch(
+            self._state,
+            rows,
+            count,
+            stride,
+            self._dim,
+            hints,
+        )
+        if result != 0:
+            raise RuntimeError("Failed to query state")
+
+        return [
+            Hint(
+                vector=h.vector[:h.dim] if h.vector and h.dim > 0 else None,
+                dim=h.dim,
+                confidence=h.confidence,
+            )
+            for h in hints
+        ]
+
     def plasticity(self) -> Plasticity:
         """Get basic epistemic state."""
         p = _CrPlasticity()
@@ -512,6 +755,27 @@ class MindState:
             reinforcement_ratio=c.reinforcement_ratio,
         )
 
+    def rolling(self) -> Rolling:
+        """Get rolling temporal statistics."""
+        r = _CrRolling()
+        result = self._lib.cr_state_rolling(self._state, ctypes.byref(r))
+        if result != 0:
+            raise RuntimeError("Failed to get rolling statistics")
+
+        def convert(stats) -> List[RollingStat]:
+            return [
+                RollingStat(
+                    horizon=s.horizon,
+                    updates=s.updates,
+                    velocity=s.velocity,
+                    reinforcement_ratio=s.reinforcement_ratio,
+                    create_rate=s.create_rate,
+                )
+                for s in stats
+            ]
+
+        return Rolling(ewma=convert(r.ewma), window=convert(r.window))
+
     def reset(self) -> None:
         """Reset state to initial condition."""
         self._lib.cr_state_reset(self._state)
@@ -0,0 +1,283 @@
+# Copyright 2026 The MIND Contributors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+asyncio interface to MIND.
+
+Operations are submitted to the C-side queue (cr_queue_*) and executed
+by its worker thread in submission order. Completion is signalled on the
+queue's readiness descriptor (an eventfd on Linux), which is registered
+with the running event loop, so awaiting never blocks the loop and no
+Python thread pool is involved.
+"""
+
+import asyncio
+import ctypes
+import itertools
+from pathlib import Path
+from typing import List, Optional, Union
+
+from mind._ffi import MindState, Hint, _CrHint, _CrCompletion
+
+_POLL_BATCH = 64
+
+
+class AsyncMindState:
+    """
+    MIND state driven from asyncio.
+
+    Example:
+        >>> async with AsyncMindState(dim=768, slots=128) as state:
+        ...     await state.update(embedding)
+        ...     hint = await state.query(embedding)
+
+    While operations are in flight the underlying state belongs to the
+    queue worker; use `await flush()` before reading `state` directly.
+    """
+
+    def __init__(
+        self,
+        dim: int,
+        slots: int,
+        initial_plasticity: float = 1.0,
+        capacity: int = 256,
+        lib_path: Optional[str] = None,
+    ):
+        """
+        Create a new state with an attached submission queue.
+
+        Args:
+            dim: Embedding dimension.
+            slots: Maximum memory slots.
+            initial_plasticity: Starting plasticity (default 1.0).
+            capacity: Maximum operations in flight.
+            lib_path: Optional path to libmind.
+        """
+        self._sync = MindState(dim, slots, initial_plasticity, lib_path)
+        self._lib = self._sync._lib
+        self._dim = dim
+
+        self._queue = self._lib.cr_queue_create(self._sync._state, capacity)
+        if not self._queue:
+            raise RuntimeError("Failed to create MIND submission queue")
+
+        self._fd = self._lib.cr_queue_fd(self._queue)
+        self._loop: Optional[asyncio.AbstractEventLoop] = None
+        self._tags = itertools.count(1)
+        self._pending = {}
+        self._space: Optional[asyncio.Future] = None
+        self._completions = (_CrCompletion * _POLL_BATCH)()
+
+    @property
+    def dim(self) -> int:
+        """Embedding dimension."""
+        return self._dim
+
+    @property
+    def state(self) -> MindState:
+        """Synchronous view; only safe when nothing is in flight."""
+        return self._sync
+
+    # -------------------------------------------------------------------------
+    # Event loop integration
+    # -------------------------------------------------------------------------
+
+    def _attach(self) -> asyncio.AbstractEventLoop:
+        loop = asyncio.get_running_loop()
+        if self._loop is None:
+            loop.add_reader(self._fd, self._on_readable)
+            self._loop = loop
+        elif self._loop is not loop:
+            raise RuntimeError("AsyncMindState is bound to another event loop")
+        return loop
+
+    def _on_readable(self) -> None:
+        while True:
+            n = self._lib.cr_queue_poll(
+                self._queue, self._completions, _POLL_BATCH)
+            if n <= 0:
+                break
+            for c in self._completions[:n]:
+                fut, _keep, decode = self._pending.pop(c.tag)
+                if fut.done():
+                    continue  # Awaiter was cancelled
+                if c.status != 0:
+                    fut.set_exception(RuntimeError("MIND operation failed"))
+                else:
+                    fut.set_result(decode() if decode else None)
+
+        if self._space is not None and not self._space.done():
+            self._space.set_result(None)
+
+    async def _submit(self, submit, keep, decode=None):
+        if self._queue is None:
+            raise RuntimeError("AsyncMindState is closed")
+
+        loop = self._attach()
+        tag = next(self._tags)
+        fut = loop.create_future()
+        self._pending[tag] = (fut, keep, decode)
+
+        while submit(tag) != 0:
+            if len(self._pending) <= 1:
+                # Nothing else in flight, so the queue cannot be full
+                del self._pending[tag]
+                raise RuntimeError("Failed to submit MIND operation")
+            if self._space is None or self._space.done():
+                self._space = loop.create_future()
+            try:
+                await asyncio.shield(self._space)
+            except asyncio.CancelledError:
+                # Never submitted, so no completion will ever remove it
+                del self._pending[tag]
+                raise
+
+        return await fut
+
+    def _check_dim(self, embedding) -> None:
+        if len(embedding) != self._dim:
+            raise ValueError(
+                f"Embedding dimension {len(embedding)} doesn't match "
+                f"configured dimension {self._dim}"
+            )
+
+    # -------------------------------------------------------------------------
+    # Operations
+    # -------------------------------------------------------------------------
+
+    async def update(
+        self,
+        embedding: Union[List[float], "numpy.ndarray"],
+        delta_t: float = 1.0,
+    ) -> None:
+        """Update state with new experience (see MindState.update)."""
+        self._check_dim(embedding)
+        if delta_t <= 0:
+            raise ValueError("delta_t must be positive")
+
+        arr = self._sync._to_float_array(embedding)
+        await self._submit(
+            lambda tag: self._lib.cr_queue_submit_update(
+                self._queue, arr, 1, self._dim, self._dim,
+                ctypes.c_float(delta_t), tag),
+            keep=(embedding, arr),
+        )
+
+    async def update_batch(
+        self,
+        embeddings: Union[List[List[float]], "numpy.ndarray"],
+        delta_t: float = 1.0,
+    ) -> None:
+        """Update state with a batch of experiences (see MindState.update_batch)."""
+        if delta_t <= 0:
+            raise ValueError("delta_t must be positive")
+
+        rows, count, stride = self._sync._to_float_rows(embeddings)
+        await self._submit(
+            lambda tag: self._lib.cr_queue_submit_update(
+                self._queue, rows, count, stride, self._dim,
+                ctypes.c_float(delta_t), tag),
+            keep=(embeddings, rows),
+        )
+
+    async def query(
+        self,
+        embedding: Union[List[float], "numpy.ndarray"],
+    ) -> Hint:
+        """Query state for a hint (see MindState.query)."""
+        self._check_dim(embedding)
+        arr = self._sync._to_float_array(embedding)
+        return (await self._query_rows(embedding, arr, 1, self._dim))[0]
+
+    async def query_batch(
+        self,
+        embeddings: Union[List[List[float]], "numpy.ndarray"],
+    ) -> List[Hint]:
+        """Query state for a batch of hints (see MindState.query_batch)."""
+        rows, count, stride = self._sync._to_float_rows(embeddings)
+        return await self._query_rows(embeddings, rows, count, stride)
+
+    async def _query_rows(self, source, rows, count, stride) -> List[Hint]:
+        hints = (_CrHint * count)()
+        vectors = (ctypes.c_float * (count * self._dim))()
+
+        def decode():
+            return [
+                Hint(
+                    vector=h.vector[:h.dim] if h.vector and h.dim > 0 else None,
+                    dim=h.dim,
+                    confidence=h.confidence,
+                )
+                for h in hints
+            ]
+
+        return await self._submit(
+            lambda tag: self._lib.cr_queue_submit_query(
+                self._queue, rows, count, stride, self._dim,
+                hints, vectors, tag),
+            keep=(source, rows, hints, vectors),
+            decode=decode,
+        )
+
+    async def save(self, path: Union[str, Path]) -> None:
+        """Save state to file after all previously submitted operations."""
+        path_bytes = str(path).encode("utf-8")
+        try:
+            await self._submit(
+                lambda tag: self._lib.cr_queue_submit_save(
+                    self._queue, path_bytes, tag),
+                keep=None,
+            )
+        except RuntimeError as e:
+            raise RuntimeError(f"Failed to save state to {path}") from e
+
+    async def flush(self) -> None:
+        """Wait until every previously submitted operation has completed."""
+        await self._submit(
+            lambda tag: self._lib.cr_queue_submit_update(
+                self._queue, None, 0, self._dim, self._dim,
+                ctypes.c_float(1.0), tag),
+            keep=None,
+        )
+
+    # -------------------------------------------------------------------------
+    # Lifecycle
+    # -------------------------------------------------------------------------
+
+    async def aclose(self) -> None:
+        """Wait for in-flight operations, then release the queue."""
+        if self._queue is None:
+            return
+        pending = [fut for fut, _, _ in self._pending.values()]
+        if pending:
+            await asyncio.gather(*pending, return_exceptions=True)
+        if self._loop is not None:
+            self._loop.remove_reader(self._fd)
+            self._loop = None
+        self._lib.cr_queue_destroy(self._queue)
+        self._queue = None
+
+    async def __aenter__(self):
+        return self
+
+    async def __aexit__(self, exc_type, exc_val, exc_tb):
+        await self.aclose()
+        return False
+
+    def __del__(self):
+        if getattr(self, "_queue", None):
+            if self._loop is not None and not self._loop.is_closed():
+                self._loop.remove_reader(self._fd)
+            self._lib.cr_queue_destroy(self._queue)
+            self._queue = None
@@ -19,6 +19,7 @@ Can run with pytest or standalone:
     python -m mind.tests.test_basic
 """
 
+import asyncio
 import sys
 import tempfile
 from pathlib import Path
@@ -90,9 +91,55 @@ def test_temporal():
     assert t.total_updates == 10
     assert t.maturity > 0
 
+    # Ages are double precision: still advancing past 2**24
+    state.update(pattern, delta_t=2.0 ** 24)
+    state.update(pattern, delta_t=1.0)
+    assert state.temporal().age == 2.0 ** 24 + 11.0
+
     print("PASS: temporal")
 
 
+def test_rolling():
+    """Test rolling temporal statistics."""
+    from mind import MindState
+
+    state = MindState(dim=4, slots=8)
+    pattern = [1.0, 0.0, 0.0, 0.0]
+
+    state.update([0.0, 1.0, 0.0, 0.0])
+    for _ in range(20):
+        state.update(pattern)
+
+    r = state.rolling()
+    assert [w.horizon for w in r.window] == [16, 64, 256]
+    assert r.window[0].updates == 16
+    assert r.window[0].reinforcement_ratio == 1.0
+    assert r.window[1].updates == 21
+    assert abs(r.window[1].create_rate - 2.0 / 21.0) < 1e-6
+
+    print("PASS: rolling")
+
+
+def test_weight_decay():
+    """Test that decayed weights lower confidence."""
+    from mind import MindState
+
+    plain = MindState(dim=4, slots=8)
+    decaying = MindState(dim=4, slots=8, weight_half_life=4.0)
+    pattern = [1.0, 0.0, 0.0, 0.0]
+    other = [0.0, 1.0, 0.0, 0.0]
+
+    for state in (plain, decaying):
+        for _ in range(10):
+            state.update(pattern)
+        for _ in range(8):
+            state.update(other)
+
+    assert decaying.query(pattern).confidence < plain.query(pattern).confidence
+
+    print("PASS: weight_decay")
+
+
 def test_calibration():
     """Test S2S calibration signal."""
     from mind import MindState
@@ -161,6 +208,123 @@ def test_determinism():
     print("PASS: determinism")
 
 
+def test_batch_matches_sequential():
+    """Test batch update/query evolve state like per-row calls."""
+    from mind import MindState
+
+    patterns = [
+        [1.0, 0.0, 0.0, 0.0],
+        [0.0, 1.0, 0.0, 0.0],
+        [0.5, 0.5, 0.0, 0.0],
+    ] * 10
+
+    single = MindState(dim=4, slots=16)
+    for p in patterns:
+        single.update(p, delta_t=1.0)
+
+    batched = MindState(dim=4, slots=16)
+    batched.update_batch(patterns, delta_t=1.0)
+
+    assert single.temporal() == batched.temporal(), "Batch diverged"
+
+    hints = batched.query_batch(patterns[:3])
+    assert len(hints) == 3
+    for p, h in zip(patterns[:3], hints):
+        assert h.confidence == single.query(p).confidence
+
+    print("PASS: batch_matches_sequential")
+
+
+def test_batch_rejects_non_float32():
+    """Test 4-byte integer arrays are not reinterpreted as float32 rows."""
+    from mind import MindState
+
+    class _Dtype:
+        def __init__(self, kind, itemsize=4, isnative=True):
+            self.kind, self.itemsize, self.isnative = kind, itemsize, isnative
+
+    class _Array:
+        """The parts of a numpy array the batch path reads."""
+        ctypes = None
+        ndim = 2
+        shape = (1, 4)
+        strides = (16, 4)
+
+        def __init__(self, dtype):
+            self.dtype = dtype
+
+    state = MindState(dim=4, slots=8)
+    for dtype in (_Dtype("i"), _Dtype("u"), _Dtype("f", isnative=False)):
+        try:
+            state.update_batch(_Array(dtype))
+        except ValueError:
+            pass
+        else:
+            raise AssertionError(f"kind {dtype.kind!r} accepted as float32")
+    assert state.slot_count == 0
+
+    print("PASS: batch_rejects_non_float32")
+
+
+def test_async_matches_sync():
+    """Test asyncio interface evolves state like synchronous calls."""
+    from mind import AsyncMindState, MindState
+
+    patterns = [
+        [1.0, 0.0, 0.0, 0.0],
+        [0.0, 1.0, 0.0, 0.0],
+        [0.5, 0.5, 0.0, 0.0],
+    ]
+
+    sync = MindState(dim=4, slots=16)
+    for i in range(60):
+        sync.update(patterns[i % 3], delta_t=1.0)
+
+    async def run():
+        # Small capacity exercises back-pressure
+        async with AsyncMindState(dim=4, slots=16, capacity=4) as state:
+            await asyncio.gather(*(
+                state.update(patterns[i % 3], delta_t=1.0) for i in range(30)
+            ))
+            await state.update_batch([patterns[i % 3] for i in range(30)])
+            hint = await state.query(patterns[0])
+            await state.flush()
+            return hint, state.state.temporal()
+
+    hint, temporal = asyncio.run(run())
+    assert temporal == sync.temporal(), "Async diverged from sync"
+    assert hint.confidence == sync.query(patterns[0]).confidence
+
+    print("PASS: async_matches_sync")
+
+
+def test_async_cancel_while_full():
+    """Test an update cancelled while waiting for queue space leaves nothing pending."""
+    from mind import AsyncMindState
+
+    async def run():
+        async with AsyncMindState(dim=4, slots=16, capacity=1) as state:
+            first = asyncio.ensure_future(state.update([1.0, 0.0, 0.0, 0.0]))
+            blocked = asyncio.ensure_future(state.update([0.0, 1.0, 0.0, 0.0]))
+            await asyncio.sleep(0)  # first is queued, blocked waits for space
+            blocked.cancel()
+            try:
+                await blocked
+            except asyncio.CancelledError:
+                pass
+            else:
+                raise AssertionError("blocked update was not cancelled")
+            await first
+            await state.flush()
+            return len(state._pending), state.state.slot_count
+
+    pending, slots = asyncio.run(run())
+    assert pending == 0, f"{pending} cancelled operations leaked"
+    assert slots == 1, "Cancelled update must not reach the state"
+
+    print("PASS: async_cancel_while_full")
+
+
 def test_context_manager():
     """Test context manager interface."""
     from mind import MindState
@@ -182,9 +346,15 @@ def run_all():
         test_update_and_query,
         test_plasticity_bounds,
         test_temporal,
+        test_rolling,
+        test_weight_decay,
         test_calibration,
         test_persistence,
         test_determinism,
+        test_batch_matches_sequential,
+        test_batch_rejects_non_float32,
+        test_async_matches_sync,
+        test_async_cancel_while_full,
         test_context_manager,
     ]
 
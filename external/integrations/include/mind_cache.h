@@ -0,0 +1,143 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file mind_cache.h
+ * @brief Content-addressed embedding cache
+ *
+ * Maps a text to its embedding row. Texts are found by a 64-bit hash
+ * and confirmed by their length and a second, independent 64-bit hash
+ * before a row is returned. The cache sits in front of a provider
+ * (mind_cache_embedder()): texts seen before are answered from the
+ * cache, and only the rest reach the provider, in one batch. Repeated
+ * input never pays for embedding twice.
+ *
+ * Storage is a fixed number of rows in one memory-mapped file, so the
+ * cache survives restarts and costs no load time. An open-addressing
+ * index finds rows; when every row is used, CLOCK (second chance)
+ * eviction replaces a row that has not been hit since the hand last
+ * passed it.
+ *
+ * A cache is keyed by content only. The tag given at open identifies
+ * the provider and its configuration; a file written under another tag,
+ * dim or capacity (or not closed cleanly) is emptied on open.
+ *
+ * A cache file is open in one handle at a time: the handle holds an
+ * exclusive lock on it, and opening the file again, from this process
+ * or another, fails until it is closed.
+ *
+ * Not thread-safe: use one cache from one thread at a time. POSIX only
+ * (mmap).
+ */
+
+#ifndef MIND_CACHE_H
+#define MIND_CACHE_H
+
+#include <stddef.h>
+#include "mind_embed.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Opaque cache handle
+ */
+typedef struct mind_cache mind_cache_t;
+
+/**
+ * @brief Cache statistics (since open)
+ */
+typedef struct {
+    unsigned long long hits;        /**< Lookups answered from the cache */
+    unsigned long long misses;      /**< Lookups that were not */
+    unsigned long long evictions;   /**< Rows replaced by CLOCK */
+    int entries;                    /**< Rows in use (including ones loaded from the file) */
+    int capacity;                   /**< Rows */
+    int dim;                        /**< Floats per row */
+} mind_cache_stats_t;
+
+/**
+ * @brief Open or create a cache
+ *
+ * @param path Cache file, or NULL for a cache in memory
+ * @param dim Floats per row
+ * @param capacity Rows
+ * @param tag Provider identity (e.g. mind_cache_hash() of its configuration)
+ * @return Cache, or NULL on error (including a file already open elsewhere)
+ */
+mind_cache_t* mind_cache_open(const char* path, int dim, int capacity, unsigned long long tag);
+
+/**
+ * @brief Flush and close a cache
+ *
+ * Marks the file clean; the next open keeps its rows.
+ *
+ * @param c Cache (may be NULL)
+ */
+void mind_cache_close(mind_cache_t* c);
+
+/**
+ * @brief Look up a text
+ *
+ * @param c Cache
+ * @param text Bytes
+ * @param len Byte length
+ * @param out Receives dim floats on a hit
+ * @return 1 on a hit, 0 on a miss, -1 on error
+ */
+int mind_cache_get(mind_cache_t* c, const char* text, size_t len, float* out);
+
+/**
+ * @brief Store the row of a text
+ *
+ * Replaces the row if the text is cached, else takes a free row or
+ * evicts one.
+ *
+ * @return 0 on success, -1 on error
+ */
+int mind_cache_put(mind_cache_t* c, const char* text, size_t len, const float* row);
+
+/**
+ * @brief Provider that answers from c and forwards misses to inner
+ *
+ * Misses are embedded by inner in one call per batch and stored. The
+ * cache (and inner's context) must outlive the handle.
+ *
+ * @param c Cache
+ * @param inner Provider with the cache's dim
+ * @param out Receives the caching provider
+ * @return 0 on success, -1 if inner does not match the cache
+ */
+int mind_cache_embedder(mind_cache_t* c, const mind_embedder_t* inner, mind_embedder_t* out);
+
+/**
+ * @brief Get statistics
+ *
+ * @return 0 on success, -1 on NULL arguments
+ */
+int mind_cache_stats(const mind_cache_t* c, mind_cache_stats_t* out);
+
+/**
+ * @brief 64-bit FNV-1a hash (the cache key of a text; also handy for tags)
+ */
+unsigned long long mind_cache_hash(const void* data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MIND_CACHE_H */
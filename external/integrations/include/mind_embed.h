@@ -0,0 +1,66 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file mind_embed.h
+ * @brief Embedding provider interface for integrations
+ *
+ * A provider turns a batch of texts into rows of floats. Every provider
+ * (local or remote) is called through the same function type, so the
+ * layers in front of MIND can be stacked without knowing which provider
+ * sits at the bottom.
+ */
+
+#ifndef MIND_EMBED_H
+#define MIND_EMBED_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Embed a batch of texts
+ *
+ * Row r is written to out + r × stride, dim floats; the rows go to
+ * cr_state_update_batch() as they are.
+ *
+ * @param ctx Provider context
+ * @param texts Texts (not necessarily NUL-terminated when lens is given)
+ * @param lens Byte length of each text, or NULL for NUL-terminated texts
+ * @param count Number of texts
+ * @param out Output rows
+ * @param stride Floats between row starts (>= dim)
+ * @return 0 on success, -1 on error
+ */
+typedef int (*mind_embed_fn)(void* ctx, const char* const* texts, const size_t* lens,
+                             int count, float* out, int stride);
+
+/**
+ * @brief Provider handle
+ */
+typedef struct {
+    mind_embed_fn embed;    /**< Batch function */
+    void* ctx;              /**< Passed to embed */
+    int dim;                /**< Floats per row */
+} mind_embedder_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MIND_EMBED_H */
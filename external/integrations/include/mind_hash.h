@@ -0,0 +1,104 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file mind_hash.h
+ * @brief Deterministic local embedder (hashed character n-grams)
+ *
+ * Feature hashing: every byte n-gram of the text (with start and end
+ * markers) is hashed to one of dim buckets and adds +1 or -1 there,
+ * then the row is L2-normalized. Texts that share n-grams get similar
+ * rows, so the output behaves like a (weak) embedding: good enough to
+ * drive MIND end to end, at millions of texts per second, with no model
+ * server. The same text, configuration and seed give the same bits on
+ * every platform.
+ *
+ * Stands in for a real provider in load tests and offline pipelines.
+ * It is not a semantic model.
+ */
+
+#ifndef MIND_HASH_H
+#define MIND_HASH_H
+
+#include <stddef.h>
+#include "mind_embed.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Longest supported n-gram */
+#define MIND_HASH_MAX_N 8
+
+/** Fold ASCII letters to lower case before hashing */
+#define MIND_HASH_LOWER 0x1
+
+/** Leave rows unnormalized (signed n-gram counts) */
+#define MIND_HASH_RAW 0x2
+
+/**
+ * @brief Embedder configuration
+ *
+ * Plain values; one configuration may be used from any number of
+ * threads at once.
+ */
+typedef struct {
+    int dim;                /**< Floats per row */
+    int min_n;              /**< Shortest n-gram (>= 1) */
+    int max_n;              /**< Longest n-gram (<= MIND_HASH_MAX_N) */
+    unsigned int seed;      /**< Selects an independent hash family */
+    int flags;              /**< MIND_HASH_LOWER | MIND_HASH_RAW */
+} mind_hash_t;
+
+/**
+ * @brief Default configuration: 3- to 5-grams, seed 0, case folded
+ *
+ * @param h Configuration to fill
+ * @param dim Floats per row
+ */
+void mind_hash_init(mind_hash_t* h, int dim);
+
+/**
+ * @brief Embed one text
+ *
+ * A text too short to hold any n-gram gives a zero row.
+ *
+ * @param h Configuration
+ * @param text Bytes (need not be NUL-terminated)
+ * @param len Byte length
+ * @param out Receives dim floats
+ * @return 0 on success, -1 on invalid configuration or arguments
+ */
+int mind_hash_embed(const mind_hash_t* h, const char* text, size_t len, float* out);
+
+/**
+ * @brief Embed a batch of texts (mind_embed_fn, ctx is a mind_hash_t*)
+ */
+int mind_hash_embed_batch(void* ctx, const char* const* texts, const size_t* lens,
+                          int count, float* out, int stride);
+
+/**
+ * @brief Provider handle for h
+ *
+ * h must outlive the handle.
+ */
+mind_embedder_t mind_hash_embedder(const mind_hash_t* h);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MIND_HASH_H */
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file mind_pipeline.h
+ * @brief Pipelined text → embedding → state ingestion
+ *
+ * Two stages run at once: the calling thread embeds batch N+1 while the
+ * worker of a submission queue (cr_queue_t) ingests batch N with
+ * cr_state_update_batch(). Batches are embedded straight into a ring of
+ * aligned buffers (two by default) and the queue reads them in place;
+ * a buffer is refilled only after its update has completed. The queue
+ * holds at most one batch per buffer, which bounds the work in flight
+ * and makes the embedding stage wait when ingestion falls behind.
+ *
+ * The resulting state is the same as embedding and updating every batch
+ * synchronously, in order.
+ *
+ * While a pipeline exists the state must only be touched through it.
+ * One thread at a time per pipeline. POSIX only (cr_queue_t).
+ */
+
+#ifndef MIND_PIPELINE_H
+#define MIND_PIPELINE_H
+
+#include <stddef.h>
+#include "cr.h"
+#include "mind_embed.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Opaque pipeline handle
+ */
+typedef struct mind_pipeline mind_pipeline_t;
+
+/**
+ * @brief Pipeline statistics (since create)
+ */
+typedef struct {
+    unsigned long long texts;       /**< Texts embedded and submitted */
+    unsigned long long batches;     /**< Batches submitted */
+    unsigned long long failed;      /**< Batches whose update failed */
+    double embed_seconds;           /**< Time in the provider */
+    double stall_seconds;           /**< Time waiting for a free buffer (ingestion behind) */
+} mind_pipeline_stats_t;
+
+/**
+ * @brief Create a pipeline into a state
+ *
+ * Each buffer holds batch rows of the provider's dim, padded to a
+ * 64-byte row stride.
+ *
+ * @param st State (must outlive the pipeline; a dim mismatch fails the first feed)
+ * @param embedder Provider (its context must outlive the pipeline)
+ * @param batch Rows per batch
+ * @param buffers Batch buffers, 2 or more (2 = double buffering)
+ * @return Pipeline, or NULL on error
+ */
+mind_pipeline_t* mind_pipeline_create(cr_state_t* st, const mind_embedder_t* embedder,
+                                      int batch, int buffers);
+
+/**
+ * @brief Flush and destroy a pipeline
+ *
+ * @param p Pipeline (may be NULL)
+ */
+void mind_pipeline_destroy(mind_pipeline_t* p);
+
+/**
+ * @brief Embed and ingest texts
+ *
+ * texts is cut into batches of up to batch rows; each is embedded on
+ * the calling thread and queued for ingestion. Returns once the last
+ * batch is queued: the texts may be released, ingestion may still be
+ * running.
+ *
+ * @param p Pipeline
+ * @param texts Texts
+ * @param lens Byte lengths, or NULL for NUL-terminated texts
+ * @param count Number of texts
+ * @param delta_t Time step of every row
+ * @return 0 on success, -1 if the provider or a submission failed
+ */
+int mind_pipeline_feed(mind_pipeline_t* p, const char* const* texts, const size_t* lens,
+                       int count, float delta_t);
+
+/**
+ * @brief Wait until every queued batch is ingested
+ *
+ * @return 0 on success, -1 if an update failed since the last flush
+ */
+int mind_pipeline_flush(mind_pipeline_t* p);
+
+/**
+ * @brief Get statistics
+ *
+ * @return 0 on success, -1 on NULL arguments
+ */
+int mind_pipeline_stats(const mind_pipeline_t* p, mind_pipeline_stats_t* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MIND_PIPELINE_H */
@@ -0,0 +1,455 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file mind_cache.c
+ * @brief Content-addressed embedding cache
+ *
+ * File layout (native byte order, every section 64-byte aligned):
+ *
+ *   header   cache_header_t
+ *   meta     capacity × cache_meta_t      key, check, text length, CLOCK bit
+ *   index    index_size × uint32          row + 1, 0 = empty
+ *   rows     capacity × dim × float32
+ *
+ * The index is linear probing over a power of two at least twice the
+ * capacity, with backward-shift deletion, so no tombstones build up
+ * under eviction. Rows never move: an evicted row is reused in place
+ * and only its 4-byte index entry is touched.
+ *
+ * The key (FNV-1a) places a text in the index; a hit also needs an equal
+ * length and an equal check, a second 64-bit hash built differently, so
+ * a key collision alone never returns another text's row.
+ *
+ * An open cache holds an exclusive flock() on its file, taken before the
+ * header is read, so a second opener can never truncate a file that is
+ * mapped elsewhere.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE     /* flock() */
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "mind_cache.h"
+
+#define CACHE_MAGIC "MINDEC\r\n"
+#define CACHE_VERSION 2
+#define CACHE_ALIGN 64
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t dim;
+    uint32_t capacity;
+    uint32_t index_size;
+    uint32_t count;         /* Rows handed out so far */
+    uint32_t hand;          /* CLOCK hand */
+    uint32_t clean;         /* 1 after mind_cache_close() */
+    uint32_t reserved;
+    uint64_t tag;
+} cache_header_t;
+
+typedef struct {
+    uint64_t key;
+    uint64_t check;         /* Second hash of the text, verified on lookup */
+    uint32_t len;
+    uint32_t ref;           /* Hit since the hand last passed */
+} cache_meta_t;
+
+_Static_assert(sizeof(cache_header_t) == 48, "cache header layout");
+_Static_assert(sizeof(cache_meta_t) == 24, "cache meta layout");
+
+struct mind_cache {
+    void* base;             /* Mapping, or heap block without a file */
+    size_t size;
+    int fd;                 /* Locked cache file, -1 without one */
+
+    cache_header_t* hdr;
+    cache_meta_t* meta;
+    uint32_t* index;
+    float* rows;
+    uint32_t mask;
+    int shift;
+    int dim;
+
+    mind_embedder_t inner;
+    const char** miss_text;
+    size_t* miss_len;
+    int* miss_row;
+    float* miss_out;
+    int miss_cap;
+
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long evictions;
+};
+
+static size_t cache_round(size_t n) {
+    return (n + CACHE_ALIGN - 1) / CACHE_ALIGN * CACHE_ALIGN;
+}
+
+/*============================================================================
+ * Index
+ *============================================================================*/
+
+/* Key 0 marks nothing, so no text may hash to it */
+static uint64_t cache_key(const char* text, size_t len) {
+    uint64_t k = mind_cache_hash(text, len);
+    return k ? k : 1;
+}
+
+/* Multiply-add over bytes with a murmur finalizer: unrelated to FNV-1a */
+static uint64_t cache_check(const char* text, size_t len) {
+    const unsigned char* p = (const unsigned char*)text;
+    uint64_t h = 0x27d4eb2f165667c5ull ^ (uint64_t)len;
+    for (size_t i = 0; i < len; i++) {
+        h = (h + p[i]) * 0xff51afd7ed558ccdull;
+        h ^= h >> 29;
+    }
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+/* Fibonacci hashing: the high bits of key × 2^64/φ */
+static uint32_t cache_home(const mind_cache_t* c, uint64_t key) {
+    return (uint32_t)((key * 0x9e3779b97f4a7c15ull) >> c->shift);
+}
+
+/* Index position of key, or of the empty entry ending its probe */
+static uint32_t cache_find(const mind_cache_t* c, uint64_t key, uint64_t check, size_t len) {
+    uint32_t i = cache_home(c, key);
+    while (c->index[i]) {
+        const cache_meta_t* m = &c->meta[c->index[i] - 1];
+        if (m->key == key && m->check == check && m->len == len) {
+            break;
+        }
+        i = (i + 1) & c->mask;
+    }
+    return i;
+}
+
+/* Empty position i and pull later entries of the run back over it */
+static void cache_unlink(mind_cache_t* c, uint32_t i) {
+    uint32_t j = i;
+    c->index[i] = 0;
+    for (;;) {
+        j = (j + 1) & c->mask;
+        if (!c->index[j]) {
+            return;
+        }
+        uint32_t home = cache_home(c, c->meta[c->index[j] - 1].key);
+        /* The entry at j may fill the hole unless its home lies in (i, j] */
+        int stays = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+        if (!stays) {
+            c->index[i] = c->index[j];
+            c->index[j] = 0;
+            i = j;
+        }
+    }
+}
+
+/* A free row, or the first row CLOCK finds unreferenced */
+static uint32_t cache_victim(mind_cache_t* c) {
+    cache_header_t* h = c->hdr;
+    if (h->count < h->capacity) {
+        return h->count++;
+    }
+    for (;;) {
+        uint32_t r = h->hand;
+        h->hand = (h->hand + 1) % h->capacity;
+        if (c->meta[r].ref) {
+            c->meta[r].ref = 0;
+            continue;
+        }
+        cache_unlink(c, cache_find(c, c->meta[r].key, c->meta[r].check, c->meta[r].len));
+        c->evictions++;
+        return r;
+    }
+}
+
+/*============================================================================
+ * Open / close
+ *============================================================================*/
+
+/* Section offsets; returns the total size */
+static size_t cache_offsets(int dim, int capacity, uint32_t index_size, size_t off[3]) {
+    off[0] = cache_round(sizeof(cache_header_t));
+    off[1] = off[0] + cache_round(sizeof(cache_meta_t) * (size_t)capacity);
+    off[2] = off[1] + cache_round(sizeof(uint32_t) * index_size);
+    return off[2] + sizeof(float) * (size_t)dim * (size_t)capacity;
+}
+
+static int cache_matches(const cache_header_t* h, int dim, int capacity, uint32_t index_size,
+                         uint64_t tag) {
+    return memcmp(h->magic, CACHE_MAGIC, 8) == 0 && h->version == CACHE_VERSION &&
+           h->dim == (uint32_t)dim && h->capacity == (uint32_t)capacity &&
+           h->index_size == index_size && h->tag == tag && h->clean == 1 &&
+           h->count <= h->capacity && h->hand < h->capacity;
+}
+
+mind_cache_t* mind_cache_open(const char* path, int dim, int capacity, unsigned long long tag) {
+    if (dim <= 0 || capacity <= 0 || capacity > (1 << 28) ||
+        (size_t)dim > SIZE_MAX / sizeof(float) / (size_t)capacity / 2) {
+        return NULL;
+    }
+    mind_cache_t* c = calloc(1, sizeof(*c));
+    if (!c) {
+        return NULL;
+    }
+    c->fd = -1;
+
+    uint32_t index_size = 2;
+    c->shift = 63;
+    while (index_size < 2u * (uint32_t)capacity) {
+        index_size <<= 1;
+        c->shift--;
+    }
+    size_t off[3];
+    size_t size = cache_offsets(dim, capacity, index_size, off);
+
+    if (!path) {
+        if (posix_memalign(&c->base, CACHE_ALIGN, size) != 0) {
+            free(c);
+            return NULL;
+        }
+        memset(c->base, 0, size);
+    } else {
+        int fd = open(path, O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            free(c);
+            return NULL;
+        }
+        /* Held until close; fails if another handle has the file open */
+        if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+            close(fd);
+            free(c);
+            return NULL;
+        }
+        struct stat sb;
+        cache_header_t old;
+        int keep = fstat(fd, &sb) == 0 && (size_t)sb.st_size == size &&
+                   pread(fd, &old, sizeof(old), 0) == (ssize_t)sizeof(old) &&
+                   cache_matches(&old, dim, capacity, index_size, tag);
+        /* Anything else starts over from a zero-filled file */
+        if (!keep && (ftruncate(fd, 0) != 0 || ftruncate(fd, (off_t)size) != 0)) {
+            close(fd);
+            free(c);
+            return NULL;
+        }
+        c->base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (c->base == MAP_FAILED) {
+            close(fd);
+            free(c);
+            return NULL;
+        }
+        c->fd = fd;
+    }
+    unsigned char* p = c->base;
+    c->size = size;
+    c->hdr = (cache_header_t*)p;
+    c->meta = (cache_meta_t*)(p + off[0]);
+    c->index = (uint32_t*)(p + off[1]);
+    c->rows = (float*)(p + off[2]);
+    c->mask = index_size - 1;
+    c->dim = dim;
+
+    cache_header_t* h = c->hdr;
+    if (memcmp(h->magic, CACHE_MAGIC, 8) != 0) {
+        memcpy(h->magic, CACHE_MAGIC, 8);
+        h->version = CACHE_VERSION;
+        h->dim = (uint32_t)dim;
+        h->capacity = (uint32_t)capacity;
+        h->index_size = index_size;
+        h->tag = tag;
+    }
+    h->clean = 0;   /* Until close: a crash leaves the file to be emptied */
+    return c;
+}
+
+void mind_cache_close(mind_cache_t* c) {
+    if (!c) {
+        return;
+    }
+    if (c->fd >= 0) {
+        msync(c->base, c->size, MS_SYNC);
+        c->hdr->clean = 1;
+        msync(c->base, CACHE_ALIGN, MS_SYNC);
+        munmap(c->base, c->size);
+        close(c->fd);   /* Releases the lock */
+    } else {
+        free(c->base);
+    }
+    free(c->miss_text);
+    free(c->miss_len);
+    free(c->miss_row);
+    free(c->miss_out);
+    free(c);
+}
+
+/*============================================================================
+ * Lookup
+ *============================================================================*/
+
+int mind_cache_get(mind_cache_t* c, const char* text, size_t len, float* out) {
+    if (!c || (!text && len > 0) || !out || len > UINT32_MAX) {
+        return -1;
+    }
+    uint32_t i = cache_find(c, cache_key(text, len), cache_check(text, len), len);
+    if (!c->index[i]) {
+        c->misses++;
+        return 0;
+    }
+    uint32_t r = c->index[i] - 1;
+    c->meta[r].ref = 1;
+    memcpy(out, c->rows + (size_t)r * (size_t)c->dim, sizeof(float) * (size_t)c->dim);
+    c->hits++;
+    return 1;
+}
+
+int mind_cache_put(mind_cache_t* c, const char* text, size_t len, const float* row) {
+    if (!c || (!text && len > 0) || !row || len > UINT32_MAX) {
+        return -1;
+    }
+    uint64_t key = cache_key(text, len);
+    uint64_t check = cache_check(text, len);
+    uint32_t i = cache_find(c, key, check, len);
+    uint32_t r;
+    if (c->index[i]) {
+        r = c->index[i] - 1;
+    } else {
+        r = cache_victim(c);
+        c->meta[r].key = key;
+        c->meta[r].check = check;
+        c->meta[r].len = (uint32_t)len;
+        c->meta[r].ref = 0;
+        c->index[cache_find(c, key, check, len)] = r + 1;  /* Eviction may have moved the slot */
+    }
+    memcpy(c->rows + (size_t)r * (size_t)c->dim, row, sizeof(float) * (size_t)c->dim);
+    return 0;
+}
+
+int mind_cache_stats(const mind_cache_t* c, mind_cache_stats_t* out) {
+    if (!c || !out) {
+        return -1;
+    }
+    out->hits = c->hits;
+    out->misses = c->misses;
+    out->evictions = c->evictions;
+    out->entries = (int)c->hdr->count;
+    out->capacity = (int)c->hdr->capacity;
+    out->dim = c->dim;
+    return 0;
+}
+
+unsigned long long mind_cache_hash(const void* data, size_t len) {
+    const unsigned char* p = data;
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < len; i++) {
+        h = (h ^ p[i]) * 0x100000001b3ull;
+    }
+    return h;
+}
+
+/*============================================================================
+ * Caching provider
+ *============================================================================*/
+
+static int cache_reserve(mind_cache_t* c, int count) {
+    if (count <= c->miss_cap) {
+        return 0;
+    }
+    const char** text = realloc(c->miss_text, sizeof(*text) * (size_t)count);
+    if (text) {
+        c->miss_text = text;
+    }
+    size_t* len = realloc(c->miss_len, sizeof(*len) * (size_t)count);
+    if (len) {
+        c->miss_len = len;
+    }
+    int* row = realloc(c->miss_row, sizeof(*row) * (size_t)count);
+    if (row) {
+        c->miss_row = row;
+    }
+    float* out = realloc(c->miss_out, sizeof(*out) * (size_t)count * (size_t)c->dim);
+    if (out) {
+        c->miss_out = out;
+    }
+    if (!text || !len || !row || !out) {
+        return -1;
+    }
+    c->miss_cap = count;
+    return 0;
+}
+
+static int cache_embed(void* ctx, const char* const* texts, const size_t* lens, int count,
+                       float* out, int stride) {
+    mind_cache_t* c = ctx;
+    if (!c || !texts || !out || count < 0 || stride < c->dim || cache_reserve(c, count) != 0) {
+        return -1;
+    }
+
+    int misses = 0;
+    for (int r = 0; r < count; r++) {
+        if (!texts[r]) {
+            return -1;
+        }
+        size_t len = lens ? lens[r] : strlen(texts[r]);
+        int rc = mind_cache_get(c, texts[r], len, out + (size_t)r * (size_t)stride);
+        if (rc < 0) {
+            return -1;
+        }
+        if (rc == 0) {
+            c->miss_text[misses] = texts[r];
+            c->miss_len[misses] = len;
+            c->miss_row[misses] = r;
+            misses++;
+        }
+    }
+    if (misses == 0) {
+        return 0;
+    }
+
+    if (c->inner.embed(c->inner.ctx, c->miss_text, c->miss_len, misses, c->miss_out,
+                       c->dim) != 0) {
+        return -1;
+    }
+    for (int m = 0; m < misses; m++) {
+        const float* row = c->miss_out + (size_t)m * (size_t)c->dim;
+        memcpy(out + (size_t)c->miss_row[m] * (size_t)stride, row, sizeof(float) * (size_t)c->dim);
+        mind_cache_put(c, c->miss_text[m], c->miss_len[m], row);
+    }
+    return 0;
+}
+
+int mind_cache_embedder(mind_cache_t* c, const mind_embedder_t* inner, mind_embedder_t* out) {
+    if (!c || !inner || !inner->embed || inner->dim != c->dim || !out) {
+        return -1;
+    }
+    c->inner = *inner;
+    out->embed = cache_embed;
+    out->ctx = c;
+    out->dim = c->dim;
+    return 0;
+}
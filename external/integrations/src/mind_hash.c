@@ -0,0 +1,199 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file mind_hash.c
+ * @brief Deterministic local embedder (hashed character n-grams)
+ *
+ * The text is processed in chunks of HASH_CHUNK start positions. For a
+ * chunk, the n-gram hashes of every length are built together: step n
+ * extends all the (n-1)-gram hashes by one byte. Positions are
+ * independent, so each step is written as fixed blocks of HASH_LANES
+ * 32-bit xor/multiply lanes (as in mind_vec.c) that the compiler turns
+ * into vector code at -O2; the bucket and sign of every emitted n-gram
+ * are computed the same way. Only the final scatter into the row is
+ * scalar. Nothing is allocated.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include "mind_hash.h"
+
+#define HASH_CHUNK 256
+#define HASH_LANES 8
+
+/* Boundary markers (control bytes that do not occur in text) */
+#define HASH_BOS 0x02u
+#define HASH_EOS 0x03u
+
+#define HASH_BASIS 0x811c9dc5u      /* FNV-1a 32 */
+#define HASH_PRIME 0x01000193u
+
+/* murmur3 finalizer: spreads every input bit over the whole word */
+static inline uint32_t hash_mix(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x85ebca6bu;
+    x ^= x >> 13;
+    x *= 0xc2b2ae35u;
+    x ^= x >> 16;
+    return x;
+}
+
+static int hash_valid(const mind_hash_t* h) {
+    return h && h->dim > 0 && h->min_n >= 1 && h->min_n <= h->max_n &&
+           h->max_n <= MIND_HASH_MAX_N;
+}
+
+/* Add the signed n-gram counts of BOS text EOS to out */
+static void hash_accumulate(const mind_hash_t* h, const unsigned char* text, size_t len,
+                            float* out) {
+    uint32_t bytes[HASH_CHUNK + MIND_HASH_MAX_N - 1];
+    uint32_t acc[HASH_CHUNK];
+    uint32_t bucket[HASH_CHUNK];
+    float sign[HASH_CHUNK];
+
+    const size_t total = len + 2;
+    const uint32_t basis = HASH_BASIS ^ (h->seed * 0x9e3779b9u);
+    const uint64_t dim = (uint64_t)h->dim;
+    const int lower = h->flags & MIND_HASH_LOWER;
+
+    for (size_t s = 0; s + (size_t)h->min_n <= total; s += HASH_CHUNK) {
+        int count = total - s < HASH_CHUNK ? (int)(total - s) : HASH_CHUNK;
+        int lanes = (count + HASH_LANES - 1) / HASH_LANES * HASH_LANES;
+
+        /* Bytes at positions s .. s + lanes + max_n - 2, zero past EOS */
+        int span = lanes + h->max_n - 1;
+        for (int i = 0; i < span; i++) {
+            size_t p = s + (size_t)i;
+            uint32_t c = 0;
+            if (p == 0) {
+                c = HASH_BOS;
+            } else if (p <= len) {
+                c = text[p - 1];
+                if (lower && c - 'A' < 26u) {
+                    c += 'a' - 'A';
+                }
+            } else if (p == len + 1) {
+                c = HASH_EOS;
+            }
+            bytes[i] = c;
+        }
+
+        for (int i = 0; i < lanes; i++) {
+            acc[i] = basis;
+        }
+        for (int n = 1; n <= h->max_n; n++) {
+            const uint32_t* b = bytes + n - 1;
+            for (int i = 0; i < lanes; i += HASH_LANES) {
+                for (int l = 0; l < HASH_LANES; l++) {
+                    acc[i + l] = (acc[i + l] ^ b[i + l]) * HASH_PRIME;
+                }
+            }
+            if (n < h->min_n) {
+                continue;
+            }
+
+            /* n-grams starting at s + i that end inside the text */
+            size_t room = total - s;
+            if (room < (size_t)n) {
+                break;
+            }
+            int emit = room - (size_t)n + 1 < (size_t)count ? (int)(room - (size_t)n + 1) : count;
+
+            /* Bucket from the high bits (multiply-shift range), sign from bit 0 */
+            for (int i = 0; i < lanes; i += HASH_LANES) {
+                for (int l = 0; l < HASH_LANES; l++) {
+                    uint32_t x = hash_mix(acc[i + l]);
+                    bucket[i + l] = (uint32_t)(((uint64_t)x * dim) >> 32);
+                    sign[i + l] = 1.0f - 2.0f * (float)(x & 1u);
+                }
+            }
+            for (int i = 0; i < emit; i++) {
+                out[bucket[i]] += sign[i];
+            }
+        }
+    }
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+void mind_hash_init(mind_hash_t* h, int dim) {
+    if (!h) {
+        return;
+    }
+    h->dim = dim;
+    h->min_n = 3;
+    h->max_n = 5;
+    h->seed = 0;
+    h->flags = MIND_HASH_LOWER;
+}
+
+int mind_hash_embed(const mind_hash_t* h, const char* text, size_t len, float* out) {
+    if (!hash_valid(h) || (!text && len > 0) || !out) {
+        return -1;
+    }
+
+    memset(out, 0, sizeof(float) * (size_t)h->dim);
+    hash_accumulate(h, (const unsigned char*)text, len, out);
+    if (h->flags & MIND_HASH_RAW) {
+        return 0;
+    }
+
+    /* Fixed lane order, so the norm is the same bits on every target */
+    float lane[HASH_LANES] = {0.0f};
+    int body = h->dim - h->dim % HASH_LANES;
+    for (int i = 0; i < body; i += HASH_LANES) {
+        for (int l = 0; l < HASH_LANES; l++) {
+            lane[l] += out[i + l] * out[i + l];
+        }
+    }
+    for (int i = body; i < h->dim; i++) {
+        lane[i - body] += out[i] * out[i];
+    }
+    float sum = ((lane[0] + lane[1]) + (lane[2] + lane[3])) +
+                ((lane[4] + lane[5]) + (lane[6] + lane[7]));
+    if (sum > 0.0f) {
+        float inv = 1.0f / sqrtf(sum);
+        for (int i = 0; i < h->dim; i++) {
+            out[i] *= inv;
+        }
+    }
+    return 0;
+}
+
+int mind_hash_embed_batch(void* ctx, const char* const* texts, const size_t* lens,
+                          int count, float* out, int stride) {
+    const mind_hash_t* h = ctx;
+    if (!hash_valid(h) || !texts || !out || count < 0 || stride < h->dim) {
+        return -1;
+    }
+    for (int r = 0; r < count; r++) {
+        if (!texts[r]) {
+            return -1;
+        }
+        size_t len = lens ? lens[r] : strlen(texts[r]);
+        mind_hash_embed(h, texts[r], len, out + (size_t)r * (size_t)stride);
+    }
+    return 0;
+}
+
+mind_embedder_t mind_hash_embedder(const mind_hash_t* h) {
+    mind_embedder_t e = {mind_hash_embed_batch, (void*)h, h ? h->dim : 0};
+    return e;
+}
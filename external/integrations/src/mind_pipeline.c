@@ -0,0 +1,189 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file mind_pipeline.c
+ * @brief Pipelined text → embedding → state ingestion
+ *
+ * Batch s is tagged s and lives in buffer s % buffers. Completions come
+ * back in submission order, so before batch s is embedded the pipeline
+ * reaps completions until batch s - buffers is done; nothing else is
+ * tracked per buffer.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <poll.h>
+#include <stdlib.h>
+#include <time.h>
+#include "mind_pipeline.h"
+
+#define PIPELINE_ALIGN 64
+#define PIPELINE_ROW_ALIGN (PIPELINE_ALIGN / (int)sizeof(float))
+
+struct mind_pipeline {
+    cr_queue_t* queue;
+    mind_embedder_t embedder;
+    int batch;
+    int buffers;
+    int stride;             /* Floats between rows, a multiple of 64 bytes */
+    float** buf;
+
+    unsigned long long submitted;
+    unsigned long long reaped;
+    int failed;             /* An update failed since the last flush */
+    mind_pipeline_stats_t stats;
+};
+
+static double pipeline_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Reap completions until at most `pending` batches are in flight */
+static int pipeline_drain(mind_pipeline_t* p, unsigned long long pending) {
+    cr_completion_t done[16];
+    struct pollfd pfd = {cr_queue_fd(p->queue), POLLIN, 0};
+    while (p->submitted - p->reaped > pending) {
+        int got = cr_queue_poll(p->queue, done, 16);
+        if (got < 0) {
+            return -1;
+        }
+        if (got == 0) {
+            poll(&pfd, 1, -1);
+            continue;
+        }
+        for (int k = 0; k < got; k++) {
+            if (done[k].status != 0) {
+                p->failed = 1;
+                p->stats.failed++;
+            }
+        }
+        p->reaped += (unsigned long long)got;
+    }
+    return 0;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+mind_pipeline_t* mind_pipeline_create(cr_state_t* st, const mind_embedder_t* embedder,
+                                      int batch, int buffers) {
+    if (!st || !embedder || !embedder->embed || embedder->dim <= 0 || batch <= 0 ||
+        buffers < 2) {
+        return NULL;
+    }
+    mind_pipeline_t* p = calloc(1, sizeof(*p));
+    if (!p) {
+        return NULL;
+    }
+    p->embedder = *embedder;
+    p->batch = batch;
+    p->buffers = buffers;
+    p->stride = (embedder->dim + PIPELINE_ROW_ALIGN - 1) / PIPELINE_ROW_ALIGN * PIPELINE_ROW_ALIGN;
+    p->buf = calloc((size_t)buffers, sizeof(float*));
+    if (!p->buf) {
+        free(p);
+        return NULL;
+    }
+    size_t bytes = sizeof(float) * (size_t)p->stride * (size_t)batch;
+    for (int b = 0; b < buffers; b++) {
+        void* mem;
+        if (posix_memalign(&mem, PIPELINE_ALIGN, bytes) != 0) {
+            mind_pipeline_destroy(p);
+            return NULL;
+        }
+        p->buf[b] = mem;
+    }
+
+    /* One queue slot per buffer: the queue never holds more than the ring */
+    p->queue = cr_queue_create(st, buffers);
+    if (!p->queue) {
+        mind_pipeline_destroy(p);
+        return NULL;
+    }
+    return p;
+}
+
+void mind_pipeline_destroy(mind_pipeline_t* p) {
+    if (!p) {
+        return;
+    }
+    cr_queue_destroy(p->queue);     /* Runs every queued update first */
+    if (p->buf) {
+        for (int b = 0; b < p->buffers; b++) {
+            free(p->buf[b]);
+        }
+        free(p->buf);
+    }
+    free(p);
+}
+
+int mind_pipeline_feed(mind_pipeline_t* p, const char* const* texts, const size_t* lens,
+                       int count, float delta_t) {
+    if (!p || !texts || count < 0) {
+        return -1;
+    }
+
+    for (int first = 0; first < count; first += p->batch) {
+        int n = count - first < p->batch ? count - first : p->batch;
+
+        /* Wait until the buffer's previous batch is ingested */
+        double t0 = pipeline_now();
+        if (pipeline_drain(p, (unsigned long long)p->buffers - 1) != 0) {
+            return -1;
+        }
+        double t1 = pipeline_now();
+
+        float* rows = p->buf[p->submitted % (unsigned long long)p->buffers];
+        int rc = p->embedder.embed(p->embedder.ctx, texts + first, lens ? lens + first : NULL,
+                                   n, rows, p->stride);
+        double t2 = pipeline_now();
+        p->stats.stall_seconds += t1 - t0;
+        p->stats.embed_seconds += t2 - t1;
+        if (rc != 0) {
+            return -1;
+        }
+
+        if (cr_queue_submit_update(p->queue, rows, n, p->stride, p->embedder.dim, delta_t,
+                                   p->submitted) != 0) {
+            return -1;
+        }
+        p->submitted++;
+        p->stats.batches++;
+        p->stats.texts += (unsigned long long)n;
+    }
+    return 0;
+}
+
+int mind_pipeline_flush(mind_pipeline_t* p) {
+    if (!p || pipeline_drain(p, 0) != 0) {
+        return -1;
+    }
+    int failed = p->failed;
+    p->failed = 0;
+    return failed ? -1 : 0;
+}
+
+int mind_pipeline_stats(const mind_pipeline_t* p, mind_pipeline_stats_t* out) {
+    if (!p || !out) {
+        return -1;
+    }
+    *out = p->stats;
+    return 0;
+}
@@ -17,6 +17,11 @@
 extern "C" {
 #endif
 
+/* Linkage of the kernels; the amalgamation makes them static inline */
+#ifndef MIND_VEC_API
+#define MIND_VEC_API
+#endif
+
 /**
  * @brief Cosine similarity between two vectors
  *
@@ -25,17 +30,17 @@ extern "C" {
  * @param dim Dimension
  * @return Similarity in [-1, 1], or 0 if either vector is zero
  */
-float mind_vec_cosine(const float* a, const float* b, int dim);
+MIND_VEC_API float mind_vec_cosine(const float* a, const float* b, int dim);
 
 /**
  * @brief Dot product of two vectors
  */
-float mind_vec_dot(const float* a, const float* b, int dim);
+MIND_VEC_API float mind_vec_dot(const float* a, const float* b, int dim);
 
 /**
  * @brief L2 norm of a vector
  */
-float mind_vec_norm(const float* v, int dim);
+MIND_VEC_API float mind_vec_norm(const float* v, int dim);
 
 /**
  * @brief Interpolate between two vectors
@@ -48,7 +53,7 @@ float mind_vec_norm(const float* v, int dim);
  * @param out Output vector (must be pre-allocated)
  * @param dim Dimension
  */
-void mind_vec_lerp(const float* a, const float* b, float t, float* out, int dim);
+MIND_VEC_API void mind_vec_lerp(const float* a, const float* b, float t, float* out, int dim);
 
 #ifdef __cplusplus
 }
@@ -8,12 +8,92 @@
  * @brief Foundation Layer: Vector Operations
  *
  * Pure math. No semantics. Never changes.
+ *
+ * Reductions sum sequentially, in index order. Multiversioned builds
+ * (MIND_VEC_MULTIVERSION) instead accumulate in a fixed eight-lane
+ * order (element i goes to lane i % 8, lanes are summed pairwise). That
+ * order is spelled out in source, so the compiler may vectorize it but
+ * never reassociate it: every clone produces bit-identical results,
+ * which may differ in the low bits from the sequential sums.
  */
 
 #include <math.h>
 #include "mind_vec.h"
 
-float mind_vec_dot(const float* a, const float* b, int dim) {
+/*
+ * With MIND_VEC_MULTIVERSION (set by the build after a compile check),
+ * hot kernels are cloned per x86-64 micro-architecture level and the
+ * dynamic loader picks one per host through an ifunc resolver. The
+ * amalgamation inlines the kernels into their callers instead.
+ */
+#if defined(MIND_VEC_MULTIVERSION) && defined(__x86_64__) && !defined(MIND_AMALGAMATION)
+#define MIND_VEC_KERNEL \
+    __attribute__((target_clones("default", "arch=x86-64-v2", \
+                                 "arch=x86-64-v3", "arch=x86-64-v4")))
+#else
+#define MIND_VEC_KERNEL
+#endif
+
+#if defined(MIND_VEC_MULTIVERSION)
+
+#define VEC_LANES 8
+
+static inline float vec_reduce(const float acc[VEC_LANES]) {
+    return ((acc[0] + acc[1]) + (acc[2] + acc[3])) +
+           ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+}
+
+MIND_VEC_KERNEL
+MIND_VEC_API float mind_vec_dot(const float* a, const float* b, int dim) {
+    float acc[VEC_LANES] = {0.0f};
+    int body = dim - dim % VEC_LANES;
+
+    for (int i = 0; i < body; i += VEC_LANES) {
+        for (int l = 0; l < VEC_LANES; l++) {
+            acc[l] += a[i + l] * b[i + l];
+        }
+    }
+    for (int i = body; i < dim; i++) {
+        acc[i - body] += a[i] * b[i];
+    }
+
+    return vec_reduce(acc);
+}
+
+MIND_VEC_KERNEL
+MIND_VEC_API float mind_vec_cosine(const float* a, const float* b, int dim) {
+    float acc_dot[VEC_LANES] = {0.0f};
+    float acc_a[VEC_LANES] = {0.0f};
+    float acc_b[VEC_LANES] = {0.0f};
+    int body = dim - dim % VEC_LANES;
+
+    for (int i = 0; i < body; i += VEC_LANES) {
+        for (int l = 0; l < VEC_LANES; l++) {
+            acc_dot[l] += a[i + l] * b[i + l];
+            acc_a[l] += a[i + l] * a[i + l];
+            acc_b[l] += b[i + l] * b[i + l];
+        }
+    }
+    for (int i = body; i < dim; i++) {
+        acc_dot[i - body] += a[i] * b[i];
+        acc_a[i - body] += a[i] * a[i];
+        acc_b[i - body] += b[i] * b[i];
+    }
+
+    float dot = vec_reduce(acc_dot);
+    float norm_a = vec_reduce(acc_a);
+    float norm_b = vec_reduce(acc_b);
+
+    if (norm_a == 0.0f || norm_b == 0.0f) {
+        return 0.0f;
+    }
+
+    return dot / (sqrtf(norm_a) * sqrtf(norm_b));
+}
+
+#else
+
+MIND_VEC_API float mind_vec_dot(const float* a, const float* b, int dim) {
     float sum = 0.0f;
     for (int i = 0; i < dim; i++) {
         sum += a[i] * b[i];
@@ -21,11 +101,7 @@ float mind_vec_dot(const float* a, const float* b, int dim) {
     return sum;
 }
 
-float mind_vec_norm(const float* v, int dim) {
-    return sqrtf(mind_vec_dot(v, v, dim));
-}
-
-float mind_vec_cosine(const float* a, const float* b, int dim) {
+MIND_VEC_API float mind_vec_cosine(const float* a, const float* b, int dim) {
     float dot = 0.0f;
     float norm_a = 0.0f;
     float norm_b = 0.0f;
@@ -43,7 +119,14 @@ float mind_vec_cosine(const float* a, const float* b, int dim) {
     return dot / (sqrtf(norm_a) * sqrtf(norm_b));
 }
 
-void mind_vec_lerp(const float* a, const float* b, float t, float* out, int dim) {
+#endif /* MIND_VEC_MULTIVERSION */
+
+MIND_VEC_API float mind_vec_norm(const float* v, int dim) {
+    return sqrtf(mind_vec_dot(v, v, dim));
+}
+
+MIND_VEC_KERNEL
+MIND_VEC_API void mind_vec_lerp(const float* a, const float* b, float t, float* out, int dim) {
     float one_minus_t = 1.0f - t;
     for (int i = 0; i < dim; i++) {
         out[i] = a[i] * one_minus_t + b[i] * t;
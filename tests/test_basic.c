@@ -21,10 +21,18 @@
  * These tests verify core invariants.
  */
 
+#define _POSIX_C_SOURCE 200809L     /* nanosleep(), poll(), mkdtemp() */
+
 #include <stdio.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <dirent.h>
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
 #include "cr.h"
 
 #define ASSERT(cond, msg) do { \
@@ -41,7 +49,7 @@
  *============================================================================*/
 
 static int test_lifecycle(void) {
-    cr_config_t cfg = {4, 8, 1.0f};
+    cr_config_t cfg = {.embedding_dim = 4, .max_memory_slots = 8, .initial_plasticity = 1.0f};
 
     cr_runtime_t* rt = cr_runtime_create(&cfg);
     ASSERT(rt != NULL, "runtime creation");
@@ -61,7 +69,7 @@ static int test_lifecycle(void) {
  *============================================================================*/
 
 static int test_plasticity_bounds(void) {
-    cr_config_t cfg = {4, 8, 1.0f};
+    cr_config_t cfg = {.embedding_dim = 4, .max_memory_slots = 8, .initial_plasticity = 1.0f};
     cr_runtime_t* rt = cr_runtime_create(&cfg);
     cr_state_t* st = cr_state_create(rt);
 
@@ -91,7 +99,7 @@ static int test_plasticity_bounds(void) {
  *============================================================================*/
 
 static int test_determinism(void) {
-    cr_config_t cfg = {4, 16, 1.0f};
+    cr_config_t cfg = {.embedding_dim = 4, .max_memory_slots = 16, .initial_plasticity = 1.0f};
 
     float patterns[3][4] = {
         {1.0f, 0.0f, 0.0f, 0.0f},
@@ -135,7 +143,7 @@ static int test_determinism(void) {
  *============================================================================*/
 
 static int test_bounded_memory(void) {
-    cr_config_t cfg = {4, 4, 1.0f};  /* Only 4 slots */
+    cr_config_t cfg = {.embedding_dim = 4, .max_memory_slots = 4, .initial_plasticity = 1.0f};  /* Only 4 slots */
     cr_runtime_t* rt = cr_runtime_create(&cfg);
     cr_state_t* st = cr_state_create(rt);
 
@@ -166,7 +174,7 @@ static int test_bounded_memory(void) {
  *============================================================================*/
 
 static int test_age_monotonic(void) {
-    cr_config_t cfg = {4, 8, 1.0f};
+    cr_config_t cfg = {.embedding_dim = 4, .max_memory_slots = 8, .initial_plasticity = 1.0f};
     cr_runtime_t* rt = cr_runtime_create(&cfg);
     cr_state_t* st = cr_state_create(rt);
 
@@ -195,11 +203,12 @@ static int test_age_monotonic(void) {
  *============================================================================*/
 
 static int test_persistence(void) {
-    cr_config_t cfg = {4, 8, 1.0f};
+    cr_config_t cfg = {.embedding_dim = 4, .max_memory_slots = 8, .initial_plasticity = 1.0f};
     const char* path = "/tmp/mind_test.state";
 
     float pattern[4] = {1.0f, 0.0f, 0.0f, 0.0f};
     float saved_confidence, loaded_confidence;
+    unsigned long long saved_digest, loaded_digest;
 
     /* Create, update, save */
     {
@@ -217,6 +226,18 @@ static int test_persistence(void) {
         int err = cr_state_save(st, path);
         ASSERT(err == 0, "save succeeds");
 
+        /* The digest is FNV-1a of the saved bytes */
+        ASSERT(cr_state_digest(st, &saved_digest) == 0, "digest");
+        unsigned long long h = 0xcbf29ce484222325ULL;
+        FILE* f = fopen(path, "rb");
+        for (int c; f && (c = fgetc(f)) != EOF;) {
+            h = (h ^ (unsigned char)c) * 0x100000001b3ULL;
+        }
+        if (f) {
+            fclose(f);
+        }
+        ASSERT(h == saved_digest, "digest matches the file");
+
         cr_state_destroy(st);
         cr_runtime_destroy(rt);
     }
@@ -233,6 +254,13 @@ static int test_persistence(void) {
         cr_state_query(st, pattern, 4, &hint);
         loaded_confidence = hint.confidence;
 
+        ASSERT(cr_state_digest(st, &loaded_digest) == 0, "digest after load");
+        ASSERT(loaded_digest == saved_digest, "loaded state has the saved digest");
+        cr_state_update(st, pattern, 4, 1.0f);
+        cr_state_digest(st, &loaded_digest);
+        ASSERT(loaded_digest != saved_digest, "digest follows updates");
+        ASSERT(cr_state_digest(st, NULL) == -1, "NULL digest output");
+
         cr_state_destroy(st);
         cr_runtime_destroy(rt);
     }
@@ -248,7 +276,7 @@ static int test_persistence(void) {
  *============================================================================*/
 
 static int test_calibration(void) {
-    cr_config_t cfg = {4, 8, 1.0f};
+    cr_config_t cfg = {.embedding_dim = 4, .max_memory_slots = 8, .initial_plasticity = 1.0f};
     cr_runtime_t* rt = cr_runtime_create(&cfg);
     cr_state_t* st = cr_state_create(rt);
 
@@ -273,6 +301,1252 @@ static int test_calibration(void) {
     return 0;
 }
 
+/*============================================================================
+ * Test: Batch update matches sequential updates
+ *============================================================================*/
+
+static int test_batch(void) {
+    cr_config_t cfg = {.embedding_dim = 4, .max_memory_slots = 16, .initial_plasticity = 1.0f};
+
+    float rows[3][4] = {
+        {1.0f, 0.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f, 0.0f},
+        {0.5f, 0.5f, 0.0f, 0.0f}
+    };
+
+    cr_runtime_t* rt = cr_runtime_create(&cfg);
+    cr_state_t* seq = cr_state_create(rt);
+    cr_state_t* bat = cr_state_create(rt);
+
+    for (int round = 0; round < 20; round++) {
+        for (int i = 0; i < 3; i++) {
+            cr_state_update(seq, rows[i], 4, 1.0f);
+        }
+        int err = cr_state_update_batch(bat, &rows[0][0], 3, 4, 4, 1.0f);
+        ASSERT(err == 0, "batch update succeeds");
+    }
+
+    ASSERT(cr_state_update_batch(bat, &rows[0][0], 3, 2, 4, 1.0f) == -1,
+           "stride below dim rejected");
+
+    cr_hint_t hints[3], hint;
+    ASSERT(cr_state_query_batch(bat, &rows[0][0], 3, 4, 4, hints) == 0,
+           "batch query succeeds");
+
+    for (int i = 0; i < 3; i++) {
+        cr_state_query(seq, rows[i], 4, &hint);
+        ASSERT(hints[i].confidence == hint.confidence, "batch matches sequential");
+    }
+
+    cr_state_destroy(bat);
+    cr_state_destroy(seq);
+    cr_runtime_destroy(rt);
+
+    PASS("batch");
+    return 0;
+}
+
+/*============================================================================
+ * Test: Async queue evolves state like synchronous calls
+ *============================================================================*/
+
+static int test_queue(void) {
+    cr_config_t cfg = {.embedding_dim = 4, .max_memory_slots = 16, .initial_plasticity = 1.0f};
+
+    float rows[3][4] = {
+        {1.0f, 0.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f, 0.0f},
+        {0.5f, 0.5f, 0.0f, 0.0f}
+    };
+
+    cr_runtime_t* rt = cr_runtime_create(&cfg);
+    cr_state_t* seq = cr_state_create(rt);
+    cr_state_t* st = cr_state_create(rt);
+
+    cr_queue_t* q = cr_queue_create(st, 32);
+    ASSERT(q != NULL, "queue creation");
+    ASSERT(cr_queue_fd(q) >= 0, "queue has readiness fd");
+
+    for (int i = 0; i < 30; i++) {
+        cr_state_update(seq, rows[i % 3], 4, 1.0f);
+        ASSERT(cr_queue_submit_update(q, rows[i % 3], 1, 4, 4, 1.0f, i) == 0,
+               "submit update");
+    }
+
+    cr_hint_t hint;
+    float vec[4];
+    ASSERT(cr_queue_submit_query(q, rows[0], 1, 4, 4, &hint, vec, 100) == 0,
+           "submit query");
+    ASSERT(cr_queue_submit_update(q, rows[0], 1, 4, 3, 1.0f, 0) == -1,
+           "dimension mismatch rejected at submission");
+
+    /* Reap in submission order */
+    cr_completion_t done[8];
+    unsigned long long expect = 0;
+    while (expect <= 30) {
+        int n = cr_queue_poll(q, done, 8);
+        ASSERT(n >= 0, "poll succeeds");
+        for (int i = 0; i < n; i++, expect++) {
+            ASSERT(done[i].status == 0, "operation succeeds");
+            ASSERT(done[i].tag == (expect < 30 ? expect : 100), "in order");
+        }
+    }
+
+    cr_hint_t ref;
+    cr_state_query(seq, rows[0], 4, &ref);
+    ASSERT(hint.confidence == ref.confidence, "async matches sync");
+    ASSERT(hint.vector == vec, "hint vector snapshotted");
+
+    /* Reaping fewer than are ready leaves the descriptor readable */
+    for (int i = 0; i < 20; i++) {
+        cr_queue_submit_update(q, rows[i % 3], 1, 4, 4, 1.0f, i);
+    }
+    struct pollfd pfd = {cr_queue_fd(q), POLLIN, 0};
+    for (int reaped = 0; reaped < 20; ) {
+        ASSERT(poll(&pfd, 1, 2000) == 1, "readable while completions remain");
+        int n = cr_queue_poll(q, done, 4);
+        ASSERT(n >= 0, "poll succeeds");
+        reaped += n;
+    }
+
+    cr_queue_destroy(q);
+    cr_state_destroy(st);
+    cr_state_destroy(seq);
+    cr_runtime_destroy(rt);
+
+    PASS("queue");
+    return 0;
+}
+
+/*============================================================================
+ * Test: Two-level memory matches flat memory on clustered data
+ *============================================================================*/
+
+static int test_hierarchy(void) {
+    /* 4 orthogonal clusters of 3 patterns each (40 degrees apart) */
+    float rows[12][8];
+    const float angle_cos[3] = {1.0f, 0.76604444f, 0.17364818f};
+    const float angle_sin[3] = {0.0f, 0.64278761f, 0.98480775f};
+    memset(rows, 0, sizeof(rows));
+    for (int a = 0; a < 3; a++) {
+        for (int k = 0; k < 4; k++) {
+            rows[a * 4 + k][2 * k] = angle_cos[a];
+            rows[a * 4 + k][2 * k + 1] = angle_sin[a];
+        }
+    }
+
+    cr_config_t flat_cfg = {.embedding_dim = 8, .max_memory_slots = 32, .initial_plasticity = 1.0f};
+    cr_config_t tree_cfg = flat_cfg;
+    tree_cfg.coarse_slots = 4;
+    tree_cfg.coarse_probe = 1;
+
+    cr_runtime_t* flat_rt = cr_runtime_create(&flat_cfg);
+    cr_runtime_t* tree_rt = cr_runtime_create(&tree_cfg);
+    ASSERT(tree_rt != NULL, "two-level runtime");
+
+    cr_config_t got;
+    cr_runtime_config(tree_rt, &got);
+    ASSERT(got.coarse_slots == 4 && got.coarse_probe == 1, "config round-trips");
+
+    cr_state_t* flat = cr_state_create(flat_rt);
+    cr_state_t* tree = cr_state_create(tree_rt);
+
+    for (int round = 0; round < 20; round++) {
+        cr_state_update_batch(flat, &rows[0][0], 12, 8, 8, 1.0f);
+        cr_state_update_batch(tree, &rows[0][0], 12, 8, 8, 1.0f);
+    }
+
+    ASSERT(cr_state_slot_count(tree) == cr_state_slot_count(flat),
+           "same invariants as flat memory");
+
+    cr_hint_t a, b;
+    for (int i = 0; i < 12; i++) {
+        cr_state_query(flat, rows[i], 8, &a);
+        cr_state_query(tree, rows[i], 8, &b);
+        ASSERT(a.confidence == b.confidence, "probing one bucket finds the match");
+    }
+
+    /* Index survives persistence */
+    const char* path = "/tmp/mind_test_hierarchy.state";
+    ASSERT(cr_state_save(tree, path) == 0, "save two-level state");
+    cr_state_reset(tree);
+    ASSERT(cr_state_slot_count(tree) == 0, "reset clears");
+    ASSERT(cr_state_load(tree, path) == 0, "load two-level state");
+    for (int i = 0; i < 12; i++) {
+        cr_state_query(flat, rows[i], 8, &a);
+        cr_state_query(tree, rows[i], 8, &b);
+        ASSERT(a.confidence == b.confidence, "index rebuilt on load");
+    }
+    remove(path);
+
+    cr_state_destroy(tree);
+    cr_state_destroy(flat);
+    cr_runtime_destroy(tree_rt);
+    cr_runtime_destroy(flat_rt);
+
+    PASS("hierarchy");
+    return 0;
+}
+
+/*============================================================================
+ * Test: Hot/cold tiering preserves decisions
+ *============================================================================*/
+
+static int test_tiering(void) {
+    /* 12 mutually orthogonal patterns, only 3 of which fit in the hot tier */
+    float rows[12][16];
+    memset(rows, 0, sizeof(rows));
+    for (int i = 0; i < 12; i++) {
+        rows[i][i] = 1.0f;
+        rows[i][15] = 0.25f;
+    }
+
+    cr_config_t cfg = {.embedding_dim = 16, .max_memory_slots = 32, .initial_plasticity = 1.0f};
+    cr_runtime_t* rt = cr_runtime_create(&cfg);
+    cr_state_t* ref = cr_state_create(rt);
+    cr_state_t* st = cr_state_create(rt);
+
+    /* Tier a state that already holds invariants */
+    cr_state_update_batch(ref, &rows[0][0], 6, 16, 16, 1.0f);
+    cr_state_update_batch(st, &rows[0][0], 6, 16, 16, 1.0f);
+    ASSERT(cr_state_tier(st, 0, NULL) == -1, "empty hot tier rejected");
+    ASSERT(cr_state_tier(st, 3, NULL) == 0, "tier state");
+    ASSERT(cr_state_tier(st, 3, NULL) == -1, "already tiered");
+
+    for (int round = 0; round < 10; round++) {
+        cr_state_update_batch(ref, &rows[0][0], 12, 16, 16, 1.0f);
+        cr_state_update_batch(st, &rows[0][0], 12, 16, 16, 1.0f);
+    }
+
+    cr_tier_stats_t ts;
+    ASSERT(cr_state_tier_stats(st, &ts) == 0, "tier stats");
+    ASSERT(ts.hot_slots == 3 && ts.hot_count == 3, "hot tier bounded");
+    ASSERT(ts.cold_count == 9, "rest is cold");
+    ASSERT(ts.promotions > 0 && ts.demotions > 0, "rows move between tiers");
+    ASSERT(cr_state_slot_count(st) == cr_state_slot_count(ref), "same invariants");
+
+    cr_hint_t a, b;
+    for (int i = 0; i < 12; i++) {
+        cr_state_query(ref, rows[i], 16, &a);
+        cr_state_query(st, rows[i], 16, &b);
+        ASSERT(a.confidence == b.confidence, "cold match found and promoted");
+    }
+
+    /* Save and reload through the tiers */
+    const char* path = "/tmp/mind_test_tier.state";
+    ASSERT(cr_state_save(st, path) == 0, "save tiered state");
+    cr_state_reset(st);
+    ASSERT(cr_state_slot_count(st) == 0, "reset clears");
+    ASSERT(cr_state_load(st, path) == 0, "load tiered state");
+    for (int i = 0; i < 12; i++) {
+        cr_state_query(ref, rows[i], 16, &a);
+        cr_state_query(st, rows[i], 16, &b);
+        ASSERT(a.confidence == b.confidence, "tiered state reloads");
+    }
+    remove(path);
+
+    /* Batch queries: later rows must not reuse the slab row of an earlier hint */
+    cr_hint_t ha[12], hb[12];
+    cr_state_query_batch(ref, &rows[0][0], 12, 16, 16, ha);
+    cr_state_query_batch(st, &rows[0][0], 12, 16, 16, hb);
+    for (int i = 0; i < 12; i++) {
+        ASSERT(ha[i].confidence == hb[i].confidence, "batch confidence");
+        ASSERT(memcmp(ha[i].vector, hb[i].vector, sizeof(rows[i])) == 0,
+               "batch hint shows its own invariant");
+    }
+
+    cr_state_t* one = cr_state_create(rt);
+    cr_state_update_batch(one, &rows[0][0], 3, 16, 16, 1.0f);
+    ASSERT(cr_state_tier(one, 1, NULL) == 0, "single hot row");
+    cr_state_query_batch(ref, &rows[1][0], 2, 16, 16, ha);
+    cr_state_query_batch(one, &rows[1][0], 2, 16, 16, hb);
+    ASSERT(hb[0].vector[1] > 0.5f && hb[0].vector[2] == 0.0f, "first hint kept");
+    ASSERT(hb[1].vector[2] > 0.5f && hb[1].vector[1] == 0.0f, "second hint read cold");
+    cr_state_query(one, rows[2], 16, &b);
+    ASSERT(cr_state_tier_stats(one, &ts) == 0 && ts.hot_count == 1, "promoted after the batch");
+    cr_state_destroy(one);
+
+    cr_state_destroy(st);
+    cr_state_destroy(ref);
+    cr_runtime_destroy(rt);
+
+    PASS("tiering");
+    return 0;
+}
+
+/*============================================================================
+ * Test: Pool hibernation is transparent
+ *============================================================================*/
+
+typedef struct {
+    cr_state_t* st;
+    const float* query;
+    float confidence;
+    int status;
+} pool_waiter_t;
+
+static void* pool_waiter(void* arg) {
+    pool_waiter_t* w = arg;
+    cr_hint_t hint;
+    w->status = cr_state_query(w->st, w->query, 8, &hint);
+    w->confidence = hint.confidence;
+    return NULL;
+}
+
+static int test_pool(void) {
+    float rows[4][8];
+    memset(rows, 0, sizeof(rows));
+    for (int i = 0; i < 4; i++) {
+        rows[i][i] = 1.0f;
+    }
+
+    cr_config_t cfg = {.embedding_dim = 8, .max_memory_slots = 16, .initial_plasticity = 1.0f};
+    cr_runtime_t* rt = cr_runtime_create(&cfg);
+
+    const char* dirs[2] = {NULL, "/tmp"};  /* In-memory images, then files */
+    for (int d = 0; d < 2; d++) {
+        cr_state_t* ref = cr_state_create(rt);
+        for (int r = 0; r < 20; r++) {
+            cr_state_update_batch(ref, &rows[0][0], 4, 8, 8, 1.0f);
+        }
+
+        cr_pool_t* pool = cr_pool_create(0.0, dirs[d]);
+        ASSERT(pool != NULL, "create pool");
+
+        cr_state_t* st[3];
+        for (int k = 0; k < 3; k++) {
+            st[k] = cr_state_create(rt);
+            ASSERT(cr_pool_add(pool, st[k]) == 0, "add member");
+            for (int r = 0; r < 20; r++) {
+                cr_state_update_batch(st[k], &rows[0][0], 4, 8, 8, 1.0f);
+            }
+        }
+        ASSERT(cr_pool_add(pool, st[0]) == -1, "already a member");
+
+        cr_pool_stats_t ps;
+        ASSERT(cr_pool_sweep(pool) == 3, "idle members hibernate");
+        ASSERT(cr_pool_sweep(pool) == 0, "hibernated once");
+        cr_pool_stats(pool, &ps);
+        ASSERT(ps.members == 3 && ps.hibernated == 3, "all hibernated");
+        ASSERT(ps.image_bytes > 0, "images held");
+        ASSERT(cr_state_slot_count(st[0]) == 4, "scalar accessors need no revival");
+
+        /* Concurrent first calls share one revival */
+        pool_waiter_t w[4];
+        pthread_t th[4];
+        for (int i = 0; i < 4; i++) {
+            w[i].st = st[0];
+            w[i].query = rows[i];
+            pthread_create(&th[i], NULL, pool_waiter, &w[i]);
+        }
+        cr_hint_t a;
+        for (int i = 0; i < 4; i++) {
+            pthread_join(th[i], NULL);
+            cr_state_query(ref, rows[i], 8, &a);
+            ASSERT(w[i].status == 0 && w[i].confidence == a.confidence,
+                   "revived state answers like the original");
+        }
+        cr_pool_stats(pool, &ps);
+        ASSERT(ps.revivals == 1 && ps.hibernated == 2, "one revival");
+
+        /* Updates revive too, and continue where the state left off */
+        cr_state_update_batch(ref, &rows[0][0], 4, 8, 8, 1.0f);
+        ASSERT(cr_state_update_batch(st[1], &rows[0][0], 4, 8, 8, 1.0f) == 0, "update revives");
+        cr_plasticity_t p1, p2;
+        cr_state_plasticity(ref, &p1);
+        cr_state_plasticity(st[1], &p2);
+        ASSERT(p1.plasticity == p2.plasticity && p1.age == p2.age, "same evolution after revival");
+
+        ASSERT(cr_pool_remove(pool, st[2]) == 0, "remove revives");
+        ASSERT(cr_pool_remove(pool, st[2]) == -1, "not a member");
+        cr_hint_t b;
+        cr_state_query(st[2], rows[1], 8, &b);
+        ASSERT(b.confidence > 0.0f, "removed state keeps its memory");
+
+        cr_state_destroy(st[0]);  /* Destroying a member detaches it */
+        cr_pool_stats(pool, &ps);
+        ASSERT(ps.members == 1, "destroyed member left the pool");
+
+        cr_pool_destroy(pool);    /* Revives and detaches st[1] */
+        ASSERT(cr_state_slot_count(st[1]) == 4, "detached after pool");
+        cr_state_destroy(st[1]);
+        cr_state_destroy(st[2]);
+        cr_state_destroy(ref);
+    }
+
+    /* A member that cannot be revived at destroy keeps its image */
+    char dir[] = "/tmp/mind-pool-test-XXXXXX";
+    ASSERT(mkdtemp(dir) != NULL, "hibernation dir");
+    cr_pool_t* pool = cr_pool_create(0.0, dir);
+    cr_state_t* st = cr_state_create(rt);
+    cr_pool_add(pool, st);
+    for (int r = 0; r < 20; r++) {
+        cr_state_update_batch(st, &rows[0][0], 4, 8, 8, 1.0f);
+    }
+    ASSERT(cr_pool_sweep(pool) == 1, "member hibernates");
+
+    char image[300] = "", moved[320];
+    DIR* dp = opendir(dir);
+    for (struct dirent* e; dp && (e = readdir(dp)); ) {
+        if (e->d_name[0] != '.') {
+            snprintf(image, sizeof(image), "%s/%s", dir, e->d_name);
+        }
+    }
+    closedir(dp);
+    snprintf(moved, sizeof(moved), "%s.moved", image);
+    ASSERT(image[0] && rename(image, moved) == 0, "hide the image");
+
+    cr_pool_destroy(pool);
+    cr_hint_t h;
+    ASSERT(cr_state_query(st, rows[1], 8, &h) == -1, "detached member still hibernated");
+    ASSERT(cr_state_slot_count(st) == 4, "invariants not thrown away");
+    ASSERT(rename(moved, image) == 0, "restore the image");
+    ASSERT(cr_state_query(st, rows[1], 8, &h) == 0 && h.confidence > 0.0f,
+           "next call revives it");
+
+    pool = cr_pool_create(0.0, NULL);
+    ASSERT(cr_pool_add(pool, st) == 0, "detached member joins a new pool");
+    cr_pool_destroy(pool);
+    cr_state_destroy(st);
+    ASSERT(rmdir(dir) == 0, "image removed after revival");
+
+    ASSERT(cr_pool_create(-1.0, NULL) == NULL, "negative TTL rejected");
+
+    cr_runtime_destroy(rt);
+
+    PASS("pool");
+    return 0;
+}
+
+/*============================================================================
+ * Test: Quotas degrade in order
+ *============================================================================*/
+
+/* 64 pseudo-random unit-scale rows: pairwise similarities stay far below 0.85 */
+static void quota_rows(float* rows, int count, int dim) {
+    unsigned int x = 12345u;
+    for (int i = 0; i < count * dim; i++) {
+        x = x * 1103515245u + 12345u;
+        rows[i] = (float)((x >> 8) & 0xffff) / 32768.0f - 1.0f;
+    }
+}
+
+static int test_quota(void) {
+    enum { DIM = 32, N = 64 };
+    static float rows[N * DIM];
+    quota_rows(rows, N, DIM);
+
+    cr_config_t cfg = {.embedding_dim = DIM, .max_memory_slots = 128,
+                       .initial_plasticity = 1.0f, .coarse_slots = 8};
+    cr_runtime_t* rt = cr_runtime_create(&cfg);
+    cr_quota_stats_t qs;
+    cr_hint_t a, b;
+
+    /* Quantize: an untiered state moves to the cold tier, nothing is lost */
+    cr_state_t* st = cr_state_create(rt);
+    cr_state_update_batch(st, rows, N, DIM, DIM, 1.0f);
+    cr_state_quota(st, &qs);
+    ASSERT(qs.quota == 0 && qs.bytes > 0, "footprint without quota");
+    ASSERT(cr_state_set_quota(st, qs.bytes) == CR_DEGRADE_NONE, "within quota");
+    float before[N];
+    for (int i = 0; i < N; i++) {
+        cr_state_query(st, rows + i * DIM, DIM, &a);
+        before[i] = a.confidence;
+    }
+    ASSERT(cr_state_set_quota(st, qs.bytes - 16 * DIM * 4) == CR_DEGRADE_QUANTIZE, "quantize");
+    cr_tier_stats_t ts;
+    cr_state_tier_stats(st, &ts);
+    ASSERT(ts.hot_slots > 0 && ts.cold_count > 0, "state was tiered");
+    cr_state_quota(st, &qs);
+    ASSERT(qs.bytes <= qs.quota && qs.step == CR_DEGRADE_QUANTIZE, "quantized state fits");
+    ASSERT(cr_state_slot_count(st) == N, "quantize keeps every invariant");
+    for (int i = 0; i < N; i++) {
+        cr_state_query(st, rows + i * DIM, DIM, &a);
+        ASSERT(a.confidence == before[i], "quantized state answers the same");
+    }
+    cr_state_destroy(st);
+
+    /* Index: pooled states cannot be tiered, so the index goes next */
+    cr_pool_t* pool = cr_pool_create(1e9, NULL);
+    st = cr_state_create(rt);
+    cr_pool_add(pool, st);
+    cr_state_update_batch(st, rows, N, DIM, DIM, 1.0f);
+    cr_state_quota(st, &qs);
+    ASSERT(cr_state_set_quota(st, qs.bytes - 4 * DIM * 4) == CR_DEGRADE_INDEX, "drop index");
+    ASSERT(cr_state_slot_count(st) == N, "index drop keeps every invariant");
+    cr_state_query(st, rows + 5 * DIM, DIM, &a);
+    ASSERT(a.vector && fabsf(a.vector[0] - rows[5 * DIM]) < 1e-6f, "flat scan still matches");
+
+    /* Pool quota hibernates members that are not in use */
+    ASSERT(cr_pool_sweep(pool) == 0, "TTL not reached");
+    cr_pool_set_quota(pool, 1);
+    ASSERT(cr_pool_sweep(pool) == 1, "pool quota hibernates");
+    cr_pool_destroy(pool);
+    cr_state_destroy(st);
+
+    /* Evict: least reinforced first, and the quota holds from then on */
+    st = cr_state_create(rt);
+    for (int r = 0; r < 5; r++) {
+        cr_state_update_batch(st, rows, 4, DIM, DIM, 1.0f);  /* Well reinforced */
+    }
+    cr_state_update_batch(st, rows, N, DIM, DIM, 1.0f);
+    cr_state_quota(st, &qs);
+    unsigned long long quota = qs.bytes - (unsigned long long)(N - 8) * DIM * 4;
+    ASSERT(cr_state_set_quota(st, quota) == CR_DEGRADE_EVICT, "evict");
+    cr_state_quota(st, &qs);
+    ASSERT(qs.bytes <= quota && qs.evicted > 0, "evicted into quota");
+    ASSERT(cr_state_slot_count(st) < N, "slots evicted");
+    for (int i = 0; i < 4; i++) {
+        cr_state_query(st, rows + i * DIM, DIM, &b);
+        ASSERT(b.vector && fabsf(b.vector[1] - rows[i * DIM + 1]) < 1e-5f,
+               "reinforced invariants survive");
+    }
+    for (int i = 0; i < 4; i++) {
+        cr_state_update_batch(st, rows, N, DIM, DIM, 1.0f);
+        cr_state_quota(st, &qs);
+        ASSERT(qs.bytes <= quota, "quota holds under new experience");
+    }
+
+    ASSERT(cr_state_set_quota(st, 0) == CR_DEGRADE_NONE, "quota removed");
+    cr_state_destroy(st);
+    cr_runtime_destroy(rt);
+
+    /* The slot table is fixed: a quota below it (plus one row) is refused,
+     * and one just above it keeps as many invariants as fit */
+    cfg.coarse_slots = 0;
+    rt = cr_runtime_create(&cfg);
+    st = cr_state_create(rt);
+    cr_state_quota(st, &qs);
+    unsigned long long floor = qs.bytes + DIM * 4;
+    ASSERT(cr_state_set_quota(st, floor - 1) == -1, "quota below the floor refused");
+    cr_state_quota(st, &qs);
+    ASSERT(qs.quota == 0, "refused quota not applied");
+    quota = floor + 8 * DIM * 4;
+    ASSERT(cr_state_set_quota(st, quota) == CR_DEGRADE_NONE, "quota at the floor");
+    for (int r = 0; r < 3; r++) {
+        cr_state_update_batch(st, rows, N, DIM, DIM, 1.0f);
+        cr_state_quota(st, &qs);
+        ASSERT(qs.bytes <= quota, "small quota holds");
+        ASSERT(cr_state_slot_count(st) >= 7, "small quota keeps what fits");
+    }
+    cr_state_destroy(st);
+    cr_runtime_destroy(rt);
+
+    PASS("quota");
+    return 0;
+}
+
+/*============================================================================
+ * Test: Pressure releases and rebuilds optional memory
+ *============================================================================*/
+
+static int test_pressure(void) {
+    enum { DIM = 32, N = 64 };
+    static float rows[N * DIM];
+    quota_rows(rows, N, DIM);
+
+    cr_config_t flat_cfg = {.embedding_dim = DIM, .max_memory_slots = 128,
+                            .initial_plasticity = 1.0f};
+    cr_config_t tree_cfg = flat_cfg;
+    tree_cfg.coarse_slots = 8;
+    cr_runtime_t* flat_rt = cr_runtime_create(&flat_cfg);
+    cr_runtime_t* tree_rt = cr_runtime_create(&tree_cfg);
+    cr_state_t* flat = cr_state_create(flat_rt);
+    cr_state_t* tree = cr_state_create(tree_rt);
+    cr_state_t* st = cr_state_create(tree_rt);
+    ASSERT(cr_state_tier(st, 8, NULL) == 0, "tier state");
+
+    cr_monitor_t* mon = cr_monitor_create(NULL);
+    ASSERT(mon != NULL, "manual monitor");
+    ASSERT(cr_monitor_add(mon, st) == 0, "attach");
+    ASSERT(cr_monitor_add(mon, st) == -1, "attached once");
+
+    cr_monitor_stats_t ms;
+    cr_quota_stats_t before, during;
+    cr_state_update_batch(st, rows, N, DIM, DIM, 1.0f);
+    cr_state_quota(st, &before);
+
+    /* Under pressure: index and sketches go, lookups scan exactly */
+    cr_monitor_signal(mon, 1);
+    cr_state_update_batch(flat, rows, N, DIM, DIM, 1.0f);
+    cr_state_update_batch(tree, rows, N, DIM, DIM, 1.0f);
+    for (int r = 0; r < 3; r++) {
+        cr_state_update_batch(flat, rows, 8, DIM, DIM, 1.0f);
+        cr_state_update_batch(tree, rows, 8, DIM, DIM, 1.0f);
+        cr_state_update_batch(st, rows, 8, DIM, DIM, 1.0f);
+    }
+    cr_state_quota(st, &during);
+    ASSERT(during.bytes + (unsigned long long)N * DIM <= before.bytes, "optional memory released");
+    cr_monitor_stats(mon, &ms);
+    ASSERT(ms.pressure == 1 && ms.releases == 1 && ms.rebuilds == 0, "released once");
+
+    cr_hint_t a, b;
+    for (int i = 0; i < N; i++) {
+        cr_state_query(flat, rows + i * DIM, DIM, &a);
+        cr_state_query(st, rows + i * DIM, DIM, &b);
+        ASSERT(a.confidence == b.confidence, "pressure mode answers like a flat scan");
+    }
+
+    /* Relief: rebuilt at the next call */
+    cr_monitor_signal(mon, 0);
+    for (int i = 0; i < N; i++) {
+        cr_state_query(tree, rows + i * DIM, DIM, &a);
+        cr_state_query(st, rows + i * DIM, DIM, &b);
+        ASSERT(a.confidence == b.confidence, "rebuilt index answers like before");
+    }
+    cr_monitor_stats(mon, &ms);
+    ASSERT(ms.pressure == 0 && ms.rebuilds == 1, "rebuilt once");
+
+    cr_monitor_signal(mon, 1);
+    cr_state_query(st, rows, DIM, &b);
+    ASSERT(cr_monitor_remove(mon, st) == 0, "detach rebuilds");
+    cr_monitor_stats(mon, &ms);
+    ASSERT(ms.releases == 2 && ms.rebuilds == 2, "detached state is complete");
+    cr_monitor_destroy(mon);
+
+    /* A PSI-backed monitor, where the kernel has PSI */
+    FILE* psi = fopen("/proc/pressure/memory", "r");
+    if (psi) {
+        fclose(psi);
+        cr_monitor_config_t mc = {.quiet_ms = 100};
+        mon = cr_monitor_create(&mc);
+        ASSERT(mon != NULL, "PSI monitor");
+        ASSERT(cr_monitor_stats(mon, &ms) == 0, "PSI monitor stats");
+        cr_monitor_destroy(mon);
+    }
+
+    /* Sampling mode: the kernel refuses triggers with windows under
+     * 500 ms, so the thread must keep sampling avg10 every 300 ms */
+    psi = fopen("/proc/pressure/memory", "r");
+    if (psi) {
+        fclose(psi);
+        cr_monitor_config_t mc = {.stall_us = 100000, .window_us = 300000, .quiet_ms = 100};
+        mon = cr_monitor_create(&mc);
+        ASSERT(mon != NULL, "sampling monitor");
+        struct timespec tick = {0, 20 * 1000 * 1000};
+        for (int i = 0; i < 150; i++) {
+            cr_monitor_stats(mon, &ms);
+            if (ms.samples >= 2) {
+                break;
+            }
+            nanosleep(&tick, NULL);
+        }
+        ASSERT(ms.triggered == 0 && ms.samples >= 2, "sampling thread keeps running");
+        cr_monitor_destroy(mon);
+    }
+
+    cr_state_destroy(st);
+    cr_state_destroy(tree);
+    cr_state_destroy(flat);
+    cr_runtime_destroy(tree_rt);
+    cr_runtime_destroy(flat_rt);
+
+    PASS("pressure");
+    return 0;
+}
+
+/*============================================================================
+ * Test: Splitting into cluster-coherent children
+ *============================================================================*/
+
+static int test_split(void) {
+    /* 4 orthogonal clusters of 3 patterns each (40 degrees apart) */
+    enum { DIM = 16, N = 12 };
+    float rows[N][DIM];
+    const float angle_cos[3] = {1.0f, 0.76604444f, 0.17364818f};
+    const float angle_sin[3] = {0.0f, 0.64278761f, 0.98480775f};
+    memset(rows, 0, sizeof(rows));
+    for (int k = 0; k < 4; k++) {
+        for (int a = 0; a < 3; a++) {
+            rows[k * 3 + a][4 * k] = angle_cos[a];
+            rows[k * 3 + a][4 * k + 1] = angle_sin[a];
+        }
+    }
+
+    cr_config_t cfg = {.embedding_dim = DIM, .max_memory_slots = 32};
+    cr_runtime_t* rt = cr_runtime_create(&cfg);
+    cr_state_t* st = cr_state_create(rt);
+    for (int round = 0; round < 5; round++) {
+        cr_state_update_batch(st, &rows[0][0], N - round, DIM, DIM, 1.0f);
+    }
+    ASSERT(cr_state_slot_count(st) == N, "one slot per pattern");
+
+    cr_split_t one, many;
+    ASSERT(cr_state_split(st, 4, 1, &one) == 0, "split single-threaded");
+    ASSERT(cr_state_split(st, 4, 3, &many) == 0, "split on 3 threads");
+    ASSERT(one.k == 4 && one.dim == DIM, "split shape");
+    ASSERT(memcmp(one.centroids, many.centroids, sizeof(float) * 4 * DIM) == 0,
+           "centroids do not depend on the thread count");
+
+    /* Each cluster lands in exactly one child, which answers like the parent */
+    int total = 0, updates = 0;
+    cr_temporal_t tp;
+    cr_hint_t a, b;
+    for (int k = 0; k < 4; k++) {
+        int c = cr_split_route(&one, rows[k * 3], DIM);
+        ASSERT(c >= 0 && c == cr_split_route(&many, rows[k * 3], DIM), "same routing");
+        ASSERT(cr_state_slot_count(one.children[c]) == 3, "cluster stays together");
+        ASSERT(cr_state_slot_count(many.children[c]) == 3, "same children");
+        for (int i = k * 3; i < k * 3 + 3; i++) {
+            ASSERT(cr_split_route(&one, rows[i], DIM) == c, "cluster routes to its child");
+            cr_state_query(st, rows[i], DIM, &a);
+            cr_split_query(&one, rows[i], DIM, &b);
+            ASSERT(a.confidence == b.confidence &&
+                   memcmp(a.vector, b.vector, sizeof(float) * DIM) == 0,
+                   "child answers like the parent");
+        }
+        total += cr_state_slot_count(one.children[c]);
+        cr_state_temporal(one.children[c], &tp);
+        updates += tp.total_updates;
+    }
+    ASSERT(total == N, "every slot in one child");
+    cr_state_temporal(st, &tp);
+    ASSERT(updates == tp.total_updates, "updates apportioned by weight");
+    ASSERT(cr_state_slot_count(st) == N, "parent unmodified");
+
+    /* Updates go to the routed child only */
+    int c = cr_split_route(&one, rows[0], DIM);
+    cr_temporal_t other, routed;
+    cr_state_temporal(one.children[(c + 1) % 4], &other);
+    cr_state_temporal(one.children[c], &routed);
+    ASSERT(cr_split_update(&one, rows[0], DIM, 1.0f) == 0, "routed update");
+    cr_state_temporal(one.children[(c + 1) % 4], &tp);
+    ASSERT(tp.total_updates == other.total_updates, "other children untouched");
+    cr_state_temporal(one.children[c], &tp);
+    ASSERT(tp.total_updates == routed.total_updates + 1, "routed child updated");
+
+    cr_split_t bad;
+    ASSERT(cr_state_split(st, N + 1, 1, &bad) == -1, "k beyond slot count");
+    ASSERT(cr_state_split(st, 0, 1, &bad) == -1, "k below one");
+    ASSERT(bad.children == NULL && bad.k == 0, "failed split is empty");
+    ASSERT(cr_split_route(&one, rows[0], DIM - 1) == -1, "dimension mismatch");
+
+    cr_split_destroy(&one);
+    cr_split_destroy(&many);
+    cr_state_destroy(st);
+    cr_runtime_destroy(rt);
+
+    PASS("split");
+    return 0;
+}
+
+/*============================================================================
+ * Test: Shrinking releases storage past the live slots
+ *============================================================================*/
+
+static int test_shrink(void) {
+    enum { DIM = 32, N = 64 };
+    static float rows[N * DIM];
+    quota_rows(rows, N, DIM);
+
+    cr_config_t cfg = {.embedding_dim = DIM, .max_memory_slots = 128,
+                       .initial_plasticity = 1.0f};
+    cr_runtime_t* rt = cr_runtime_create(&cfg);
+    cr_quota_stats_t qs;
+    cr_hint_t a, b;
+
+    for (int tiered = 0; tiered < 2; tiered++) {
+        /*
+         * The same history, with and without shrinking after eviction.
+         * Pooled states skip the quantize step, so eviction comes first.
+         */
+        cr_pool_t* pool = cr_pool_create(1e9, NULL);
+        cr_state_t* st = cr_state_create(rt);
+        cr_state_t* ref = cr_state_create(rt);
+        if (tiered) {
+            ASSERT(cr_state_tier(st, 8, NULL) == 0, "tier state");
+            ASSERT(cr_state_tier(ref, 8, NULL) == 0, "tier reference");
+        } else {
+            cr_pool_add(pool, st);
+            cr_pool_add(pool, ref);
+        }
+        cr_state_update_batch(st, rows, N, DIM, DIM, 1.0f);
+        cr_state_update_batch(ref, rows, N, DIM, DIM, 1.0f);
+        cr_tier_stats_t ts;
+        if (cr_state_tier_stats(st, &ts) == 0 && ts.cold_count > 0) {
+            cr_state_quota(st, &qs);
+            cr_state_set_quota(st, qs.bytes - 1);   /* Drops cached cold pages */
+            cr_state_set_quota(ref, qs.bytes - 1);
+        }
+        cr_state_quota(st, &qs);
+        unsigned long long quota = qs.bytes - (unsigned long long)(N / 2) * DIM * (tiered ? 1 : 4);
+        cr_state_set_quota(st, quota);
+        cr_state_set_quota(ref, quota);
+        cr_state_set_quota(st, 0);
+        cr_state_set_quota(ref, 0);
+        int live = cr_state_slot_count(st);
+        ASSERT(live > 0 && live < N, "evicted");
+
+        ASSERT(cr_state_shrink(st) == 0, "shrink");
+        ASSERT(cr_state_shrink(st) == 0, "shrink is idempotent");
+        ASSERT(cr_state_slot_count(st) == live, "shrink keeps every invariant");
+        for (int i = 0; i < N; i++) {
+            cr_state_query(st, rows + i * DIM, DIM, &a);
+            cr_state_query(ref, rows + i * DIM, DIM, &b);
+            ASSERT(a.confidence == b.confidence, "shrunk state answers the same");
+        }
+
+        /* New invariants regrow the storage */
+        for (int r = 0; r < 2; r++) {
+            cr_state_update_batch(st, rows, N, DIM, DIM, 1.0f);
+            cr_state_update_batch(ref, rows, N, DIM, DIM, 1.0f);
+        }
+        ASSERT(cr_state_slot_count(st) == cr_state_slot_count(ref), "regrown");
+        ASSERT(cr_state_slot_count(st) > live, "new invariants stored");
+        for (int i = 0; i < N; i++) {
+            cr_state_query(st, rows + i * DIM, DIM, &a);
+            cr_state_query(ref, rows + i * DIM, DIM, &b);
+            ASSERT(a.confidence == b.confidence &&
+                   memcmp(a.vector, b.vector, sizeof(float) * DIM) == 0,
+                   "regrown state evolves like the reference");
+        }
+        cr_pool_destroy(pool);
+        cr_state_destroy(ref);
+        cr_state_destroy(st);
+    }
+
+    /* Loading into a shrunk empty state */
+    const char* path = "/tmp/mind_test_shrink.state";
+    cr_state_t* ref = cr_state_create(rt);
+    cr_state_update_batch(ref, rows, N, DIM, DIM, 1.0f);
+    ASSERT(cr_state_save(ref, path) == 0, "save");
+    cr_state_t* st = cr_state_create(rt);
+    ASSERT(cr_state_shrink(st) == 0, "shrink empty state");
+    ASSERT(cr_state_load(st, path) == 0, "load regrows");
+    ASSERT(cr_state_slot_count(st) == N, "all slots loaded");
+    for (int i = 0; i < N; i++) {
+        cr_state_query(st, rows + i * DIM, DIM, &a);
+        cr_state_query(ref, rows + i * DIM, DIM, &b);
+        ASSERT(a.confidence == b.confidence, "loaded state answers the same");
+    }
+    remove(path);
+
+    ASSERT(cr_state_shrink(NULL) == -1, "NULL state");
+    cr_state_destroy(st);
+    cr_state_destroy(ref);
+    cr_runtime_destroy(rt);
+
+    PASS("shrink");
+    return 0;
+}
+
+/*============================================================================
+ * Test: Age and counters of long-lived states
+ *============================================================================*/
+
+static int test_long_lived(void) {
+    cr_config_t cfg = {.embedding_dim = 4, .max_memory_slots = 8, .initial_plasticity = 1.0f};
+    const char* path = "/tmp/mind_test_long_lived.state";
+    float pattern[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+
+    cr_runtime_t* rt = cr_runtime_create(&cfg);
+    cr_state_t* st = cr_state_create(rt);
+
+    /* Past 2^24 a float age would stop advancing at delta_t = 1 */
+    cr_state_update(st, pattern, 4, 16777216.0f);
+    for (int i = 0; i < 8; i++) {
+        cr_state_update(st, pattern, 4, 1.0f);
+    }
+    cr_temporal_t t;
+    cr_state_temporal(st, &t);
+    ASSERT(t.age == 16777224.0, "age keeps advancing");
+    ASSERT(t.last_reinforcement_age == 16777224.0, "landmark keeps advancing");
+    ASSERT(t.time_since_reinforcement == 0.0, "no drift between age and landmark");
+    ASSERT(t.total_updates == 9 && t.total_reinforcements == 8, "counters");
+
+    /* Version 2 files keep the full precision */
+    ASSERT(cr_state_save(st, path) == 0, "save");
+    cr_state_t* loaded = cr_state_create(rt);
+    ASSERT(cr_state_load(loaded, path) == 0, "load");
+    cr_temporal_t lt;
+    cr_state_temporal(loaded, &lt);
+    ASSERT(lt.age == t.age && lt.total_updates == t.total_updates, "round trip");
+
+    /* Version 1 files (float32 ages, int32 counters) still load */
+    FILE* f = fopen(path, "wb");
+    ASSERT(f != NULL, "open v1 file");
+    uint32_t header[2] = {0x4D494E44u, 1u};
+    int32_t shape[3] = {4, 8, 1};   /* dim, max_slots, slot_count */
+    float scalars[5] = {0.5f, 12.0f, 0.5f, 0.0f, 11.0f};
+    int32_t counters[2] = {12, 11};
+    float slot[5] = {0.0f, 1.0f, 0.0f, 0.0f, 12.0f};
+    fwrite(header, sizeof(header), 1, f);
+    fwrite(shape, sizeof(shape), 1, f);
+    fwrite(&scalars[0], sizeof(float), 1, f);         /* plasticity */
+    fwrite(&scalars[1], sizeof(float), 1, f);         /* age */
+    fwrite(&scalars[2], sizeof(float), 3, f);         /* prev, velocity, landmark */
+    fwrite(counters, sizeof(counters), 1, f);
+    fwrite(slot, sizeof(slot), 1, f);
+    fclose(f);
+
+    ASSERT(cr_state_load(loaded, path) == 0, "load v1");
+    cr_state_temporal(loaded, &lt);
+    ASSERT(lt.age == 12.0 && lt.last_reinforcement_age == 11.0, "v1 ages");
+    ASSERT(lt.total_updates == 12 && lt.total_reinforcements == 11, "v1 counters");
+    ASSERT(cr_state_slot_count(loaded) == 1, "v1 slots");
+    remove(path);
+
+    cr_state_destroy(loaded);
+    cr_state_destroy(st);
+    cr_runtime_destroy(rt);
+
+    PASS("long_lived");
+    return 0;
+}
+
+/*============================================================================
+ * Test: Rolling statistics match a recomputation
+ *============================================================================*/
+
+static int test_rolling(void) {
+    enum { DIM = 32, N = 64, STEPS = 600 };
+    static float rows[N * DIM];
+    static float velocity[STEPS];
+    static int reinforced[STEPS], created[STEPS];
+    quota_rows(rows, N, DIM);
+
+    cr_config_t cfg = {.embedding_dim = DIM, .max_memory_slots = 48, .initial_plasticity = 1.0f};
+    cr_runtime_t* rt = cr_runtime_create(&cfg);
+    cr_state_t* st = cr_state_create(rt);
+
+    cr_rolling_t r;
+    ASSERT(cr_state_rolling(st, &r) == 0, "rolling stats");
+    ASSERT(r.window[0].updates == 0 && r.ewma[2].velocity == 0.0f, "empty before updates");
+
+    /* Novelty, repetition and a full memory, with irregular steps */
+    cr_temporal_t t;
+    for (int i = 0; i < STEPS; i++) {
+        int row = i < 200 ? i % N : (i * 7) % 16;
+        cr_state_temporal(st, &t);
+        long long reinforcements = t.total_reinforcements;
+        int slots = cr_state_slot_count(st);
+        cr_state_update(st, rows + row * DIM, DIM, 0.5f + (float)(i % 3));
+        cr_state_temporal(st, &t);
+        velocity[i] = t.velocity;
+        reinforced[i] = t.total_reinforcements > reinforcements;
+        created[i] = cr_state_slot_count(st) > slots;
+    }
+
+    ASSERT(cr_state_rolling(st, &r) == 0, "rolling stats");
+    for (int h = 0; h < CR_ROLLING_HORIZONS; h++) {
+        int horizon = r.window[h].horizon;
+        ASSERT(r.window[h].updates == horizon && r.ewma[h].horizon == horizon, "horizons filled");
+
+        double v = 0.0, re = 0.0, cr = 0.0;
+        for (int i = STEPS - horizon; i < STEPS; i++) {
+            v += velocity[i];
+            re += reinforced[i];
+            cr += created[i];
+        }
+        ASSERT(fabs(r.window[h].velocity - v / horizon) < 1e-6, "window velocity");
+        ASSERT(fabs(r.window[h].reinforcement_ratio - re / horizon) < 1e-6, "window reinforcement ratio");
+        ASSERT(fabs(r.window[h].create_rate - cr / horizon) < 1e-6, "window create rate");
+
+        float ev = 0.0f, er = 0.0f;
+        for (int i = 0; i < STEPS; i++) {
+            float alpha = i + 1 < horizon ? 1.0f / (float)(i + 1) : 1.0f / (float)horizon;
+            ev += alpha * (velocity[i] - ev);
+            er += alpha * ((float)reinforced[i] - er);
+        }
+        ASSERT(fabsf(r.ewma[h].velocity - ev) < 1e-6f, "EWMA velocity");
+        ASSERT(fabsf(r.ewma[h].reinforcement_ratio - er) < 1e-6f, "EWMA reinforcement ratio");
+    }
+    ASSERT(r.window[0].reinforcement_ratio == 1.0f && r.window[0].create_rate == 0.0f,
+           "recent updates only reinforce");
+
+    cr_state_reset(st);
+    cr_state_rolling(st, &r);
+    ASSERT(r.window[2].updates == 0 && r.window[2].velocity == 0.0f, "reset clears");
+    ASSERT(cr_state_rolling(NULL, &r) == -1 && cr_state_rolling(st, NULL) == -1, "arguments");
+
+    cr_state_destroy(st);
+    cr_runtime_destroy(rt);
+
+    PASS("rolling");
+    return 0;
+}
+
+/*============================================================================
+ * Test: Weights decay lazily with age
+ *============================================================================*/
+
+static int test_decay(void) {
+    enum { DIM = 32, N = 17 };
+    static float rows[N * DIM];
+    quota_rows(rows, N, DIM);
+
+    cr_config_t flat_cfg = {.embedding_dim = DIM, .max_memory_slots = 32, .initial_plasticity = 1.0f};
+    cr_config_t decay_cfg = flat_cfg;
+    decay_cfg.weight_half_life = 8.0f;
+    cr_runtime_t* flat_rt = cr_runtime_create(&flat_cfg);
+    cr_runtime_t* decay_rt = cr_runtime_create(&decay_cfg);
+    ASSERT(decay_rt != NULL, "decaying runtime");
+    cr_config_t got;
+    cr_runtime_config(decay_rt, &got);
+    ASSERT(got.weight_half_life == 8.0f, "config round-trips");
+    decay_cfg.weight_half_life = -1.0f;
+    ASSERT(cr_runtime_create(&decay_cfg) == NULL, "negative half-life rejected");
+
+    /* Reinforce A at ages 1..10, then 16 unrelated experiences */
+    cr_state_t* flat = cr_state_create(flat_rt);
+    cr_state_t* st = cr_state_create(decay_rt);
+    for (int i = 0; i < 10; i++) {
+        cr_state_update(flat, rows, DIM, 1.0f);
+        cr_state_update(st, rows, DIM, 1.0f);
+    }
+    for (int i = 1; i < N; i++) {
+        cr_state_update(flat, rows + i * DIM, DIM, 1.0f);
+        cr_state_update(st, rows + i * DIM, DIM, 1.0f);
+    }
+
+    double w = 0.0;
+    for (int k = 1; k <= 10; k++) {
+        w += pow(2.0, -(26.0 - k) / 8.0);
+    }
+    cr_hint_t a, b;
+    cr_state_query(flat, rows, DIM, &a);
+    cr_state_query(st, rows, DIM, &b);
+    ASSERT(a.confidence > 0.0f, "reinforced pattern is confident");
+    double expect = a.confidence * ((w / (w + 1.0)) / (10.0 / 11.0));
+    ASSERT(fabs(b.confidence - expect) < 1e-6, "confidence uses the decayed weight");
+
+    /* Saved weights are the decayed ones */
+    const char* path = "/tmp/mind_test_decay.state";
+    ASSERT(cr_state_save(st, path) == 0, "save");
+    cr_state_t* loaded = cr_state_create(decay_rt);
+    ASSERT(cr_state_load(loaded, path) == 0, "load");
+    cr_state_query(loaded, rows, DIM, &a);
+    ASSERT(a.confidence == b.confidence, "decayed weights persist");
+    remove(path);
+    cr_state_destroy(loaded);
+    cr_state_destroy(st);
+
+    /* Fast decay crosses renormalization many times: w -> 1 / (1 - 2^-4) */
+    cr_runtime_destroy(decay_rt);
+    decay_cfg.weight_half_life = 0.25f;
+    decay_rt = cr_runtime_create(&decay_cfg);
+    st = cr_state_create(decay_rt);
+    for (int i = 0; i < 200; i++) {
+        cr_state_update(st, rows, DIM, 1.0f);
+    }
+    cr_plasticity_t p;
+    cr_state_plasticity(st, &p);
+    cr_state_query(st, rows, DIM, &b);
+    w = 1.0 / (1.0 - 1.0 / 16.0);
+    ASSERT(fabs(b.confidence - p.stability * (w / (w + 1.0))) < 1e-5, "steady-state weight");
+    cr_state_destroy(st);
+
+    /* An untouched slot keeps exactly 2^-n across renormalization (~step 58) */
+    cr_runtime_destroy(decay_rt);
+    decay_cfg.weight_half_life = 1.0f;
+    decay_rt = cr_runtime_create(&decay_cfg);
+    st = cr_state_create(decay_rt);
+    cr_state_update(st, rows, DIM, 1.0f);
+    cr_invariant_t old;
+    for (int n = 1; n <= 70; n++) {
+        cr_state_update(st, rows + DIM, DIM, 1.0f);
+        ASSERT(cr_state_oldest(st, &old) == 0, "oldest");
+        ASSERT(fabs(old.weight / ldexp(1.0, -n) - 1.0) < 1e-5, "untouched weight is 2^-n");
+    }
+
+    cr_state_destroy(st);
+    cr_state_destroy(flat);
+    cr_runtime_destroy(decay_rt);
+    cr_runtime_destroy(flat_rt);
+
+    PASS("decay");
+    return 0;
+}
+
+/*============================================================================
+ * Test: Recency list orders invariants by last reinforcement
+ *============================================================================*/
+
+static int test_recency(void) {
+    enum { DIM = 32, N = 64 };
+    static float rows[N * DIM];
+    quota_rows(rows, N, DIM);
+
+    cr_config_t cfg = {.embedding_dim = DIM, .max_memory_slots = 128,
+                       .initial_plasticity = 1.0f};
+    cr_runtime_t* rt = cr_runtime_create(&cfg);
+    cr_state_t* st = cr_state_create(rt);
+    cr_invariant_t inv[4];
+
+    ASSERT(cr_state_oldest(st, inv) == -1, "empty state has no oldest");
+    ASSERT(cr_state_recent(st, 10.0, inv, 4) == 0, "empty state has no recent");
+
+    /* A, B, C at ages 1..3, then A again at age 4 */
+    cr_state_update(st, rows, DIM, 1.0f);
+    cr_state_update(st, rows + DIM, DIM, 1.0f);
+    cr_state_update(st, rows + 2 * DIM, DIM, 1.0f);
+    cr_state_update(st, rows, DIM, 1.0f);
+
+    ASSERT(cr_state_oldest(st, inv) == 0, "oldest");
+    ASSERT(inv[0].reinforced_age == 2.0 && inv[0].vector[0] == rows[DIM], "B is oldest");
+    ASSERT(inv[0].dim == DIM && inv[0].weight == 1.0f, "oldest fields");
+    ASSERT(cr_state_recent(st, 1.5, inv, 4) == 2, "two within 1.5");
+    ASSERT(inv[0].vector[0] == rows[0] && inv[0].reinforced_age == 4.0, "A is newest");
+    ASSERT(inv[0].weight == 2.0f, "A was reinforced");
+    ASSERT(inv[1].vector[0] == rows[2 * DIM], "then C");
+    ASSERT(cr_state_recent(st, 1.5, inv, 1) == 2, "count exceeds capacity");
+    ASSERT(cr_state_recent(st, 1e9, NULL, 0) == 3, "count only");
+
+    /* Order survives save and load */
+    const char* path = "/tmp/mind_test_recency.state";
+    ASSERT(cr_state_save(st, path) == 0, "save");
+    cr_state_t* loaded = cr_state_create(rt);
+    ASSERT(cr_state_load(loaded, path) == 0, "load");
+    ASSERT(cr_state_oldest(loaded, inv) == 0 && inv[0].vector[0] == rows[DIM],
+           "loaded oldest");
+    ASSERT(cr_state_recent(loaded, 1.5, inv, 4) == 2 && inv[0].vector[0] == rows[0],
+           "loaded recent");
+    remove(path);
+    cr_state_destroy(loaded);
+
+    /* Reset empties the list */
+    cr_state_reset(st);
+    ASSERT(cr_state_oldest(st, inv) == -1, "reset clears recency");
+
+    /* Eviction compacts slots; the list follows */
+    cr_pool_t* pool = cr_pool_create(1e9, NULL);
+    cr_pool_add(pool, st);
+    cr_state_update_batch(st, rows, N, DIM, DIM, 1.0f);
+    cr_state_update_batch(st, rows, 4, DIM, DIM, 1.0f);
+    cr_quota_stats_t qs;
+    cr_state_quota(st, &qs);
+    ASSERT(cr_state_set_quota(st, qs.bytes - (N / 2) * DIM * 4) == CR_DEGRADE_EVICT, "evict");
+    int count = cr_state_slot_count(st);
+    ASSERT(count < N, "slots evicted");
+    static cr_invariant_t all[N];
+    ASSERT(cr_state_recent(st, 1e9, all, N) == count, "every survivor listed");
+    for (int i = 0; i < 4; i++) {
+        ASSERT(all[i].vector[0] == rows[(3 - i) * DIM], "reinforced survivors lead");
+    }
+    for (int i = 1; i < count; i++) {
+        ASSERT(all[i].reinforced_age <= all[i - 1].reinforced_age, "newest first");
+    }
+    ASSERT(cr_state_oldest(st, inv) == 0 && inv[0].reinforced_age == all[count - 1].reinforced_age,
+           "oldest is the tail");
+    cr_pool_destroy(pool);
+
+    ASSERT(cr_state_recent(NULL, 1.0, inv, 4) == -1, "NULL state");
+    ASSERT(cr_state_recent(st, -1.0, inv, 4) == -1, "negative span");
+    ASSERT(cr_state_recent(st, 1.0, NULL, 4) == -1, "NULL output");
+    ASSERT(cr_state_oldest(st, NULL) == -1, "NULL oldest output");
+
+    cr_state_destroy(st);
+    cr_runtime_destroy(rt);
+
+    PASS("recency");
+    return 0;
+}
+
+/*============================================================================
+ * Test: Sliding window expires invariants outside the horizon
+ *============================================================================*/
+
+static int test_expiry(void) {
+    enum { DIM = 32, N = 64, STEPS = 300 };
+    static float rows[N * DIM];
+    quota_rows(rows, N, DIM);
+    const double horizon = 16.0;
+
+    /* Flat, two-level, and tiered two-level memory expire the same way */
+    cr_config_t cfgs[2] = {
+        {.embedding_dim = DIM, .max_memory_slots = N, .initial_plasticity = 1.0f},
+        {.embedding_dim = DIM, .max_memory_slots = N, .initial_plasticity = 1.0f,
+         .coarse_slots = 8, .coarse_probe = 8},
+    };
+    for (int mode = 0; mode < 3; mode++) {
+        cr_runtime_t* rt = cr_runtime_create(&cfgs[mode > 0]);
+        cr_state_t* st = cr_state_create(rt);
+        if (mode == 2) {
+            ASSERT(cr_state_tier(st, 8, NULL) == 0, "tier state");
+        }
+        ASSERT(cr_state_set_horizon(st, horizon) == 0, "set horizon");
+
+        /* Row 0 every third step stays; rows 1..40 recur after 40 and expire */
+        double last[N];
+        for (int r = 0; r < N; r++) {
+            last[r] = -1e9;
+        }
+        int created = 0;
+        for (int t = 1; t <= STEPS; t++) {
+            int r = t % 3 == 0 ? 0 : 1 + t % 40;
+            if (t - last[r] > horizon) {
+                created++;
+            }
+            last[r] = t;
+            cr_state_update(st, rows + r * DIM, DIM, 1.0f);
+
+            int live = 0;
+            for (int k = 0; k < N; k++) {
+                live += t - last[k] <= horizon;
+            }
+            ASSERT(cr_state_slot_count(st) == live, "live invariants are the window");
+        }
+
+        cr_expiry_stats_t es;
+        ASSERT(cr_state_expiry(st, &es) == 0 && es.horizon == horizon, "expiry stats");
+        ASSERT(es.expired == (unsigned long long)(created - cr_state_slot_count(st)),
+               "every other creation expired");
+        cr_invariant_t inv;
+        ASSERT(cr_state_oldest(st, &inv) == 0 && STEPS - inv.reinforced_age <= horizon,
+               "oldest is within the horizon");
+        ASSERT(cr_state_recent(st, 1e9, NULL, 0) == cr_state_slot_count(st),
+               "recency lists every slot");
+        cr_hint_t h;
+        for (int r = 0; r < N; r++) {
+            if (STEPS - last[r] <= horizon) {
+                cr_state_query(st, rows + r * DIM, DIM, &h);
+                ASSERT(h.vector && fabsf(h.vector[0] - rows[r * DIM]) < 1e-5f,
+                       "live invariants still match");
+            }
+        }
+        ASSERT(cr_state_query(st, rows + 41 * DIM, DIM, &h) == 0 && h.confidence < 0.5f,
+               "expired content is gone");
+
+        /* Shrinking the horizon expires immediately; 0 turns expiry off */
+        ASSERT(cr_state_set_horizon(st, 0.5) == 0, "shrink horizon");
+        ASSERT(cr_state_slot_count(st) == 1, "only the newest survives");
+        ASSERT(cr_state_set_horizon(st, 0.0) == 0, "disable");
+        for (int r = 0; r < N; r++) {
+            cr_state_update(st, rows + r * DIM, DIM, 100.0f);
+        }
+        ASSERT(cr_state_slot_count(st) == N, "no expiry without a horizon");
+
+        cr_state_destroy(st);
+        cr_runtime_destroy(rt);
+    }
+
+    /* Loading applies the horizon at the saved age */
+    cr_runtime_t* rt = cr_runtime_create(&cfgs[0]);
+    cr_state_t* st = cr_state_create(rt);
+    for (int r = 0; r < 10; r++) {
+        cr_state_update(st, rows + r * DIM, DIM, 1.0f);
+    }
+    const char* path = "/tmp/mind_test_expiry.state";
+    ASSERT(cr_state_save(st, path) == 0, "save");
+    cr_state_t* loaded = cr_state_create(rt);
+    ASSERT(cr_state_set_horizon(loaded, 2.5) == 0, "horizon before load");
+    ASSERT(cr_state_load(loaded, path) == 0, "load");
+    ASSERT(cr_state_slot_count(loaded) == 3, "stale invariants expire on load");
+    remove(path);
+
+    ASSERT(cr_state_set_horizon(NULL, 1.0) == -1, "NULL state");
+    ASSERT(cr_state_set_horizon(st, -1.0) == -1, "negative horizon");
+    ASSERT(cr_state_set_horizon(st, NAN) == -1, "NaN horizon");
+    ASSERT(cr_state_expiry(st, NULL) == -1, "NULL stats");
+
+    cr_state_destroy(loaded);
+    cr_state_destroy(st);
+    cr_runtime_destroy(rt);
+
+    PASS("expiry");
+    return 0;
+}
+
 /*============================================================================
  * Main
  *============================================================================*/
@@ -290,6 +1564,20 @@ int main(void) {
     failures += test_age_monotonic();
     failures += test_persistence();
     failures += test_calibration();
+    failures += test_batch();
+    failures += test_queue();
+    failures += test_hierarchy();
+    failures += test_tiering();
+    failures += test_pool();
+    failures += test_quota();
+    failures += test_pressure();
+    failures += test_split();
+    failures += test_shrink();
+    failures += test_long_lived();
+    failures += test_rolling();
+    failures += test_decay();
+    failures += test_recency();
+    failures += test_expiry();
 
     printf("\n================\n");
     if (failures == 0) {
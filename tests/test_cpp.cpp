@@ -0,0 +1,416 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file test_cpp.cpp
+ * @brief Tests for the C++ wrapper (external/bindings/cpp)
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <coroutine>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "mind.hpp"
+#include "mind_async.hpp"
+#include "mind_fixed.hpp"
+
+#define ASSERT(cond, msg) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "FAIL: %s\n  at %s:%d\n", msg, __FILE__, __LINE__); \
+        return 1; \
+    } \
+} while(0)
+
+#define PASS(name) std::printf("PASS: %s\n", name)
+
+/*============================================================================
+ * Test: Wrapper matches the C API
+ *============================================================================*/
+
+static int test_wrapper_matches_c(void) {
+    std::array<float, 12> rows = {
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.5f, 0.5f, 0.0f, 0.0f
+    };
+
+    cr_config_t cfg = mind::runtime::make_config(4, 16);
+    cr_runtime_t* crt = cr_runtime_create(&cfg);
+    cr_state_t* cst = cr_state_create(crt);
+
+    mind::runtime rt(4, 16);
+    mind::state st(rt);
+
+    for (int i = 0; i < 30; i++) {
+        cr_state_update(cst, rows.data() + (i % 3) * 4, 4, 1.0f);
+        st.update(std::span<const float>(rows).subspan((i % 3) * 4, 4));
+    }
+
+    cr_hint_t ref;
+    cr_state_query(cst, rows.data(), 4, &ref);
+    mind::hint h = st.query(std::span<const float>(rows.data(), 4));
+
+    ASSERT(h.confidence == ref.confidence, "query matches C");
+    ASSERT(h.vector.size() == 4, "hint views invariant");
+    ASSERT(st.temporal().total_updates == 30, "temporal forwarded");
+    ASSERT(st.rolling().window[0].updates == 16, "rolling forwarded");
+
+    cr_state_destroy(cst);
+    cr_runtime_destroy(crt);
+
+    PASS("wrapper_matches_c");
+    return 0;
+}
+
+/*============================================================================
+ * Test: Strided batch views
+ *============================================================================*/
+
+static int test_batch_view(void) {
+    /* Rows padded to 8 floats: only the first 4 are the embedding */
+    std::vector<float> padded(3 * 8, 0.0f);
+    padded[0 * 8 + 0] = 1.0f;
+    padded[1 * 8 + 1] = 1.0f;
+    padded[2 * 8 + 0] = 0.5f;
+    padded[2 * 8 + 1] = 0.5f;
+
+    mind::runtime rt(4, 16);
+    mind::state seq(rt);
+    mind::state bat(rt);
+
+    mind::batch_view<const float> view(padded.data(), 3, 4, 8);
+    for (int round = 0; round < 10; round++) {
+        for (std::size_t i = 0; i < view.rows(); i++) {
+            seq.update(view[i]);
+        }
+        bat.update(view);
+    }
+
+    std::vector<mind::hint> hints = bat.query(view);
+    ASSERT(hints.size() == 3, "one hint per row");
+    for (std::size_t i = 0; i < 3; i++) {
+        ASSERT(hints[i].confidence == seq.query(view[i]).confidence,
+               "batch matches sequential");
+    }
+
+    PASS("batch_view");
+    return 0;
+}
+
+/* More rows than fit a fixed chunk, on a state with one hot slab row */
+static int test_tiered_batch(void) {
+    const std::array<float, 4> a = {1.0f, 0.0f, 0.0f, 0.0f};
+    const std::array<float, 4> b = {0.0f, 1.0f, 0.0f, 0.0f};
+
+    mind::runtime rt(4, 16);
+    mind::state st(rt);
+    st.update(a);
+    st.update(b);
+    ASSERT(cr_state_tier(st.get(), 1, nullptr) == 0, "tier state");
+
+    std::vector<float> rows(65 * 4, 0.0f);
+    std::copy(a.begin(), a.end(), rows.begin());
+    for (std::size_t r = 1; r < 65; r++) {
+        std::copy(b.begin(), b.end(), rows.begin() + static_cast<std::ptrdiff_t>(r * 4));
+    }
+
+    std::vector<mind::hint> hints = st.query(mind::batch_view<const float>(rows.data(), 65, 4, 4));
+    ASSERT(hints.size() == 65, "one hint per row");
+    ASSERT(hints[0].vector.size() == 4 && hints[0].vector[0] > 0.5f,
+           "first hint still shows its own invariant");
+    ASSERT(hints[64].vector[1] > 0.5f, "last hint shows its own invariant");
+
+    PASS("tiered_batch");
+    return 0;
+}
+
+/*============================================================================
+ * Test: Move semantics and errors
+ *============================================================================*/
+
+static int test_move_and_errors(void) {
+    mind::runtime rt(4, 8);
+    mind::state a(rt);
+    mind::state b(std::move(a));
+
+    ASSERT(!a, "moved-from state is empty");
+    ASSERT(b && b.dim() == 4, "moved-to state owns handle");
+
+    std::array<float, 3> wrong = {1.0f, 0.0f, 0.0f};
+    bool threw = false;
+    try {
+        b.update(wrong);
+    } catch (const mind::error&) {
+        threw = true;
+    }
+    ASSERT(threw, "dimension mismatch throws");
+
+    PASS("move_and_errors");
+    return 0;
+}
+
+/*============================================================================
+ * Test: Fixed-dimension states
+ *============================================================================*/
+
+static_assert(mind::storage_policy<mind::storage::int8, 4>);
+static_assert(sizeof(mind::storage::fp16::row<32>) < sizeof(mind::storage::fp32::row<32>));
+
+template <class Storage>
+static int run_fixed(const char* name, float tolerance) {
+    const std::array<std::array<float, 4>, 3> rows = {{
+        {1.0f, 0.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f, 0.0f},
+        {0.5f, 0.5f, 0.0f, 0.0f}
+    }};
+
+    mind::runtime rt(4, 16);
+    mind::state ref(rt);
+    mind::basic_state<4, Storage> st(16);
+
+    for (int i = 0; i < 60; i++) {
+        ref.update(rows[i % 3]);
+        st.update(rows[i % 3]);
+    }
+
+    ASSERT(st.slot_count() == static_cast<std::size_t>(ref.slot_count()),
+           "same slots as dynamic state");
+    ASSERT(st.temporal().plasticity == ref.temporal().plasticity,
+           "same plasticity trajectory");
+
+    for (const auto& r : rows) {
+        auto h = st.query(r);
+        float diff = h.confidence - ref.query(r).confidence;
+        ASSERT(diff <= tolerance && -diff <= tolerance, "confidence matches");
+
+        auto row = st.row(h);
+        for (std::size_t i = 0; i < 4; i++) {
+            float err = row.get(i) - h.view()[i];
+            ASSERT(err <= tolerance && -err <= tolerance, "row round-trips");
+        }
+    }
+
+    PASS(name);
+    return 0;
+}
+
+/* Same stream through basic_state<768> and the C API, with decay, expiry
+ * and the two-level index on: every decision must be bit-identical */
+static int test_fixed_parity(void) {
+    constexpr std::size_t dim = 768;
+    cr_config_t cfg = mind::runtime::make_config(dim, 48);
+    cfg.coarse_slots = 8;
+    cfg.coarse_probe = 2;
+    cfg.weight_half_life = 40.0f;
+
+    mind::basic_state<dim> st(cfg);
+    mind::runtime rt(cfg);
+    mind::state owner(rt);
+    cr_state_t* ref = owner.get();
+    ASSERT(cr_state_set_horizon(st.get(), 120.0) == 0 &&
+           cr_state_set_horizon(ref, 120.0) == 0, "horizon set");
+
+    /* A new cluster every 8 updates; older clusters age out */
+    unsigned seed = 12345;
+    auto next = [&seed] {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<float>((seed >> 8) & 0xFFFF) / 32768.0f - 1.0f;
+    };
+    std::vector<std::array<float, dim>> centers(50);
+    for (auto& c : centers) {
+        for (float& x : c) {
+            x = next();
+        }
+    }
+
+    std::array<float, dim> e;
+    for (int i = 0; i < 400; i++) {
+        const auto& c = centers[(i / 8) % centers.size()];
+        for (std::size_t j = 0; j < dim; j++) {
+            e[j] = c[j] + 0.2f * next();
+        }
+        float dt = (i % 3) ? 1.0f : 0.5f;
+        st.update(e, dt);
+        ASSERT(cr_state_update(ref, e.data(), dim, dt) == 0, "reference update");
+
+        unsigned long long a = 0, b = 0;
+        ASSERT(cr_state_digest(st.get(), &a) == 0 &&
+               cr_state_digest(ref, &b) == 0, "digests");
+        ASSERT(a == b, "identical state after every update");
+    }
+
+    cr_temporal_t t = st.temporal();
+    cr_temporal_t rt_t;
+    cr_state_temporal(ref, &rt_t);
+    ASSERT(t.total_reinforcements > 0 && t.total_reinforcements < t.total_updates,
+           "stream both reinforces and creates");
+    ASSERT(t.plasticity == rt_t.plasticity && t.age == rt_t.age,
+           "same plasticity and age");
+    ASSERT(st.slot_count() == static_cast<std::size_t>(cr_state_slot_count(ref)),
+           "same slot count");
+
+    cr_expiry_stats_t ex;
+    ASSERT(cr_state_expiry(st.get(), &ex) == 0 && ex.expired > 0, "expiry ran");
+
+    for (const auto& c : centers) {
+        auto h = st.query(c);
+        cr_hint_t rh;
+        ASSERT(cr_state_query(ref, c.data(), dim, &rh) == 0, "reference query");
+        ASSERT(h.confidence == rh.confidence, "bit-identical confidence");
+        ASSERT(!h == !rh.vector, "same match");
+        if (h) {
+            ASSERT(std::memcmp(h.vector, rh.vector, dim * sizeof(float)) == 0,
+                   "bit-identical invariant");
+        }
+    }
+
+    PASS("fixed_state_parity_768");
+    return 0;
+}
+
+static int test_fixed_state(void) {
+    int failures = 0;
+    failures += run_fixed<mind::storage::fp32>("fixed_state_fp32", 0.0f);
+    failures += run_fixed<mind::storage::fp16>("fixed_state_fp16", 1e-3f);
+    failures += run_fixed<mind::storage::int8>("fixed_state_int8", 1e-2f);
+    failures += test_fixed_parity();
+    return failures;
+}
+
+/*============================================================================
+ * Test: Coroutine awaitables
+ *============================================================================*/
+
+/* Fire-and-forget coroutine: starts eagerly, counts itself done at the end */
+struct detached {
+    struct promise_type {
+        detached get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+static detached feed(mind::async_state& a, std::span<const float> row,
+                     std::atomic<int>& done) {
+    co_await a.update(row);
+    done++;
+}
+
+static detached drive(mind::async_state& a, std::span<const float> rows,
+                      float* confidence, bool* threw, std::atomic<int>& done) {
+    for (int i = 0; i < 30; i++) {
+        co_await a.update(rows.subspan((i % 3) * 4, 4));
+    }
+    mind::query_result r = co_await a.query(rows.first(4));
+    *confidence = r.confidence;
+
+    std::array<float, 3> wrong = {1.0f, 0.0f, 0.0f};
+    try {
+        co_await a.update(wrong);
+    } catch (const mind::error&) {
+        *threw = true;
+    }
+    done++;
+}
+
+static void wait_for(const std::atomic<int>& done, int n) {
+    while (done.load() < n) {
+        std::this_thread::yield();
+    }
+}
+
+static int test_async_state(void) {
+    std::array<float, 12> rows = {
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.5f, 0.5f, 0.0f, 0.0f
+    };
+
+    mind::runtime rt(4, 16);
+    mind::state ref(rt);
+    for (int i = 0; i < 30; i++) {
+        ref.update(std::span<const float>(rows).subspan((i % 3) * 4, 4));
+    }
+
+    mind::state st(rt);
+    float confidence = -1.0f;
+    bool threw = false;
+    {
+        std::atomic<int> done{0};
+        mind::async_state a(st);
+        drive(a, rows, &confidence, &threw, done);
+        wait_for(done, 1);
+    }
+
+    ASSERT(confidence == ref.query(std::span<const float>(rows.data(), 4)).confidence,
+           "awaited updates match sync state");
+    ASSERT(threw, "invalid operation resumes with error");
+
+    /* More concurrent awaits than capacity: overflow keeps submission order */
+    mind::state seq(rt);
+    mind::state over(rt);
+    {
+        std::atomic<int> done{0};
+        mind::async_state a(over, 2);
+        for (int i = 0; i < 24; i++) {
+            auto row = std::span<const float>(rows).subspan((i % 3) * 4, 4);
+            seq.update(row);
+            feed(a, row, done);
+        }
+        wait_for(done, 24);
+    }
+
+    ASSERT(over.temporal().total_updates == 24, "overflowed awaits all ran");
+    ASSERT(over.temporal().plasticity == seq.temporal().plasticity,
+           "overflow preserves order");
+
+    PASS("async_state");
+    return 0;
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+int main() {
+    std::printf("MIND C++ Test Suite\n");
+    std::printf("====================\n\n");
+
+    int failures = 0;
+
+    failures += test_wrapper_matches_c();
+    failures += test_batch_view();
+    failures += test_tiered_batch();
+    failures += test_move_and_errors();
+    failures += test_fixed_state();
+    failures += test_async_state();
+
+    std::printf("\n====================\n");
+    if (failures == 0) {
+        std::printf("All tests passed.\n");
+        return 0;
+    }
+    std::printf("%d test(s) failed.\n", failures);
+    return 1;
+}
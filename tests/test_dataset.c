@@ -0,0 +1,324 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file test_dataset.c
+ * @brief Tests for the mapped dataset readers (tools/mind_dataset.h)
+ *
+ * Given the path of mind_replay as its argument, also replays a small
+ * file through it in each mode.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "mind_dataset.h"
+
+#define ASSERT(cond, msg) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "FAIL: %s\n  at %s:%d\n", msg, __FILE__, __LINE__); \
+        return 1; \
+    } \
+} while(0)
+
+#define PASS(name) printf("PASS: %s\n", name)
+
+enum { ROWS = 5, DIM = 3 };
+
+static float value(int r, int i) {
+    return (float)(r * DIM + i) * 0.5f - 2.0f;
+}
+
+/* npy 1.0 header padded so the data starts at a multiple of 64 */
+static void write_npy_shape(FILE* f, const char* descr, const char* shape) {
+    char dict[128];
+    int n = snprintf(dict, sizeof(dict),
+                     "{'descr': '%s', 'fortran_order': False, 'shape': %s, }",
+                     descr, shape);
+    int len = n + 1;
+    len += (64 - (10 + len) % 64) % 64;
+    unsigned char pre[10] = {0x93, 'N', 'U', 'M', 'P', 'Y', 1, 0,
+                             (unsigned char)(len & 0xff), (unsigned char)(len >> 8)};
+    fwrite(pre, 1, sizeof(pre), f);
+    fwrite(dict, 1, (size_t)n, f);
+    for (int i = n; i < len - 1; i++) {
+        fputc(' ', f);
+    }
+    fputc('\n', f);
+}
+
+static void write_npy(FILE* f, const char* descr) {
+    char shape[32];
+    snprintf(shape, sizeof(shape), "(%d, %d)", ROWS, DIM);
+    write_npy_shape(f, descr, shape);
+}
+
+/*============================================================================
+ * Test: vecs files
+ *============================================================================*/
+
+static int test_vecs(void) {
+    const char* fpath = "/tmp/mind_test_dataset.fvecs";
+    const char* bpath = "/tmp/mind_test_dataset.bvecs";
+    FILE* f = fopen(fpath, "wb");
+    FILE* b = fopen(bpath, "wb");
+    ASSERT(f && b, "create files");
+    for (int r = 0; r < ROWS; r++) {
+        int32_t dim = DIM;
+        fwrite(&dim, sizeof(dim), 1, f);
+        fwrite(&dim, sizeof(dim), 1, b);
+        for (int i = 0; i < DIM; i++) {
+            float v = value(r, i);
+            unsigned char u = (unsigned char)(r * DIM + i);
+            fwrite(&v, sizeof(v), 1, f);
+            fwrite(&u, 1, 1, b);
+        }
+    }
+    fclose(f);
+    fclose(b);
+
+    /* fvecs rows come back in place, strided past each length prefix */
+    mind_dataset_t ds;
+    mind_batch_t batch;
+    ASSERT(mind_dataset_open(&ds, fpath) == 0, "open fvecs");
+    ASSERT(strcmp(ds.format, "fvecs") == 0 && ds.type == MIND_DATASET_F32, "fvecs type");
+    ASSERT(ds.count == ROWS && ds.dim == DIM, "fvecs shape");
+    ASSERT(mind_dataset_batch(&ds, 1, 10, NULL, &batch) == 0, "fvecs batch");
+    ASSERT(batch.count == ROWS - 1 && batch.stride == DIM + 1, "batch clipped and strided");
+    ASSERT((const void*)batch.rows == mind_dataset_row(&ds, 1), "zero-copy");
+    for (int r = 0; r < batch.count; r++) {
+        for (int i = 0; i < DIM; i++) {
+            ASSERT(batch.rows[r * batch.stride + i] == value(r + 1, i), "fvecs values");
+        }
+    }
+    ASSERT(mind_dataset_row(&ds, ROWS) == NULL, "row out of range");
+    ASSERT(mind_dataset_batch(&ds, ROWS, 1, NULL, &batch) == -1, "batch out of range");
+    mind_dataset_close(&ds);
+
+    /* bvecs widen into scratch */
+    float scratch[ROWS * DIM];
+    ASSERT(mind_dataset_open(&ds, bpath) == 0, "open bvecs");
+    ASSERT(strcmp(ds.format, "bvecs") == 0 && ds.type == MIND_DATASET_U8, "bvecs type");
+    ASSERT(mind_dataset_batch(&ds, 0, ROWS, NULL, &batch) == -1, "conversion needs scratch");
+    ASSERT(mind_dataset_batch(&ds, 0, ROWS, scratch, &batch) == 0, "bvecs batch");
+    ASSERT(batch.rows == scratch && batch.stride == DIM, "converted batch is dense");
+    for (int k = 0; k < ROWS * DIM; k++) {
+        ASSERT(scratch[k] == (float)k, "bvecs values");
+    }
+    mind_dataset_close(&ds);
+
+    remove(fpath);
+    remove(bpath);
+    PASS("vecs");
+    return 0;
+}
+
+/*============================================================================
+ * Test: npy files
+ *============================================================================*/
+
+static int test_npy(void) {
+    const char* path = "/tmp/mind_test_dataset.npy";
+    mind_dataset_t ds;
+    mind_batch_t batch;
+    float scratch[ROWS * DIM];
+
+    /* float32 */
+    FILE* f = fopen(path, "wb");
+    ASSERT(f, "create file");
+    write_npy(f, "<f4");
+    for (int r = 0; r < ROWS; r++) {
+        for (int i = 0; i < DIM; i++) {
+            float v = value(r, i);
+            fwrite(&v, sizeof(v), 1, f);
+        }
+    }
+    fclose(f);
+    ASSERT(mind_dataset_open(&ds, path) == 0, "open f4");
+    ASSERT(strcmp(ds.format, "npy") == 0 && ds.type == MIND_DATASET_F32, "f4 type");
+    ASSERT(ds.count == ROWS && ds.dim == DIM, "f4 shape");
+    ASSERT(((uintptr_t)ds.rows & 63) == 0, "data is aligned");
+    ASSERT(mind_dataset_batch(&ds, 2, 2, NULL, &batch) == 0, "f4 batch");
+    ASSERT(batch.stride == DIM && batch.rows[0] == value(2, 0) &&
+           batch.rows[DIM + 2] == value(3, 2), "f4 values");
+    mind_dataset_close(&ds);
+
+    /* float16: every value is exact in half precision */
+    f = fopen(path, "wb");
+    write_npy(f, "<f2");
+    for (int r = 0; r < ROWS; r++) {
+        for (int i = 0; i < DIM; i++) {
+            float v = value(r, i);
+            uint32_t bits;
+            memcpy(&bits, &v, sizeof(bits));
+            uint16_t h = (uint16_t)((bits >> 16) & 0x8000u);
+            if (v != 0.0f) {
+                h |= (uint16_t)((((bits >> 23) & 0xff) - 112) << 10 | ((bits >> 13) & 0x3ff));
+            }
+            fwrite(&h, sizeof(h), 1, f);
+        }
+    }
+    fclose(f);
+    ASSERT(mind_dataset_open(&ds, path) == 0, "open f2");
+    ASSERT(ds.type == MIND_DATASET_F16, "f2 type");
+    ASSERT(mind_dataset_batch(&ds, 0, ROWS, scratch, &batch) == 0, "f2 batch");
+    for (int r = 0; r < ROWS; r++) {
+        for (int i = 0; i < DIM; i++) {
+            ASSERT(scratch[r * DIM + i] == value(r, i), "f2 values");
+        }
+    }
+    mind_dataset_close(&ds);
+
+    /* Truncated data is rejected */
+    f = fopen(path, "wb");
+    write_npy(f, "<f4");
+    fclose(f);
+    ASSERT(mind_dataset_open(&ds, path) == -1, "truncated npy");
+    mind_dataset_close(&ds);
+
+    /* Unsupported element type */
+    f = fopen(path, "wb");
+    write_npy(f, "<f8");
+    fclose(f);
+    ASSERT(mind_dataset_open(&ds, path) == -1, "float64 rejected");
+    mind_dataset_close(&ds);
+
+    /* Only two dimensions, with or without a trailing comma */
+    float zeros[2 * 3 * 4] = {0};
+    f = fopen(path, "wb");
+    write_npy_shape(f, "<f4", "(2, 3, 4)");
+    fwrite(zeros, sizeof(zeros), 1, f);
+    fclose(f);
+    ASSERT(mind_dataset_open(&ds, path) == -1, "3-D rejected");
+    mind_dataset_close(&ds);
+
+    f = fopen(path, "wb");
+    write_npy_shape(f, "<f4", "(2, 3,)");
+    fwrite(zeros, sizeof(float), 6, f);
+    fclose(f);
+    ASSERT(mind_dataset_open(&ds, path) == 0 && ds.count == 2 && ds.dim == 3,
+           "trailing comma accepted");
+    mind_dataset_close(&ds);
+
+    remove(path);
+    PASS("npy");
+    return 0;
+}
+
+/*============================================================================
+ * Test: Half precision
+ *============================================================================*/
+
+static int test_half(void) {
+    ASSERT(mind_dataset_half(0x3c00) == 1.0f, "one");
+    ASSERT(mind_dataset_half(0xc000) == -2.0f, "minus two");
+    ASSERT(mind_dataset_half(0x7bff) == 65504.0f, "largest normal");
+    ASSERT(mind_dataset_half(0x0001) == ldexpf(1.0f, -24), "smallest subnormal");
+    ASSERT(mind_dataset_half(0x8000) == 0.0f && signbit(mind_dataset_half(0x8000)), "negative zero");
+    ASSERT(isinf(mind_dataset_half(0x7c00)), "infinity");
+    ASSERT(isnan(mind_dataset_half(0x7e00)), "NaN");
+
+    mind_dataset_t ds;
+    ASSERT(mind_dataset_open(&ds, "/nonexistent/mind.fvecs") == -1, "missing file");
+    mind_dataset_close(&ds);
+
+    PASS("half");
+    return 0;
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+/*============================================================================
+ * Test: mind_replay (when its path is given)
+ *============================================================================*/
+
+/* Exit status of replay run with args, or -1 if it was killed (10 s limit) */
+static int run_replay(const char* replay, char* const args[]) {
+    pid_t pid = fork();
+    if (pid == 0) {
+        int null = open("/dev/null", O_WRONLY);
+        if (null >= 0) {
+            dup2(null, STDOUT_FILENO);
+        }
+        alarm(10);
+        execv(replay, args);
+        _exit(127);
+    }
+    int status;
+    if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status)) {
+        return -1;
+    }
+    return WEXITSTATUS(status);
+}
+
+static int test_replay(const char* replay) {
+    enum { RROWS = 200, RDIM = 4 };
+    const char* path = "/tmp/mind_test_replay.fvecs";
+    FILE* f = fopen(path, "wb");
+    ASSERT(f, "create file");
+    for (int r = 0; r < RROWS; r++) {
+        int32_t dim = RDIM;
+        fwrite(&dim, sizeof(dim), 1, f);
+        for (int i = 0; i < RDIM; i++) {
+            float v = (float)((r * 7 + i * 3) % 11) - 5.0f;
+            fwrite(&v, sizeof(v), 1, f);
+        }
+    }
+    fclose(f);
+
+    /* 50 batches in flight at once: more completions than one reap takes */
+    char* deep[] = {"mind_replay", "-m", "async", "-b", "4", "-q", "64", (char*)path, NULL};
+    char* shallow[] = {"mind_replay", "-m", "async", "-b", "4", "-q", "4", (char*)path, NULL};
+    char* batch[] = {"mind_replay", "-m", "batch", "-b", "4", (char*)path, NULL};
+    ASSERT(run_replay(replay, deep) == 0, "async replay deeper than a reap");
+    ASSERT(run_replay(replay, shallow) == 0, "async replay");
+    ASSERT(run_replay(replay, batch) == 0, "batch replay");
+
+    remove(path);
+    PASS("replay");
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    printf("MIND Dataset Tests\n");
+    printf("==================\n\n");
+
+    int failures = 0;
+
+    failures += test_vecs();
+    failures += test_npy();
+    failures += test_half();
+    if (argc > 1) {
+        failures += test_replay(argv[1]);
+    }
+
+    printf("\n==================\n");
+    if (failures == 0) {
+        printf("All tests passed.\n");
+        return 0;
+    } else {
+        printf("%d test(s) failed.\n", failures);
+        return 1;
+    }
+}
@@ -0,0 +1,384 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file test_integrations.c
+ * @brief Tests for the integration layer (external/integrations)
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "cr.h"
+#include "mind_cache.h"
+#include "mind_hash.h"
+#include "mind_pipeline.h"
+
+#define ASSERT(cond, msg) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "FAIL: %s\n  at %s:%d\n", msg, __FILE__, __LINE__); \
+        return 1; \
+    } \
+} while(0)
+
+#define PASS(name) printf("PASS: %s\n", name)
+
+enum { DIM = 256 };
+
+static float dot(const float* a, const float* b, int dim) {
+    float s = 0.0f;
+    for (int i = 0; i < dim; i++) {
+        s += a[i] * b[i];
+    }
+    return s;
+}
+
+/*============================================================================
+ * Test: Hashed n-gram embedder
+ *============================================================================*/
+
+static int test_hash_embed(void) {
+    mind_hash_t h;
+    mind_hash_init(&h, DIM);
+    float a[DIM], b[DIM], c[DIM], d[DIM];
+
+    /* Deterministic and unit length */
+    const char* text = "The quick brown fox jumps over the lazy dog";
+    ASSERT(mind_hash_embed(&h, text, strlen(text), a) == 0, "embed");
+    ASSERT(mind_hash_embed(&h, text, strlen(text), b) == 0, "embed again");
+    ASSERT(memcmp(a, b, sizeof(a)) == 0, "same text, same bits");
+    ASSERT(fabsf(dot(a, a, DIM) - 1.0f) < 1e-5f, "unit length");
+
+    /* Shared n-grams make rows similar */
+    const char* near = "The quick brown fox jumped over a lazy dog";
+    const char* far = "Quarterly revenue exceeded analyst estimates";
+    mind_hash_embed(&h, near, strlen(near), c);
+    mind_hash_embed(&h, far, strlen(far), d);
+    ASSERT(dot(a, c, DIM) > 0.5f, "near text is similar");
+    ASSERT(dot(a, c, DIM) > dot(a, d, DIM) + 0.3f, "far text is less similar");
+
+    /* Case folding, and an independent family per seed */
+    mind_hash_embed(&h, "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG", strlen(text), c);
+    ASSERT(memcmp(a, c, sizeof(a)) == 0, "case folded");
+    h.flags = 0;
+    mind_hash_embed(&h, "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG", strlen(text), c);
+    ASSERT(memcmp(a, c, sizeof(a)) != 0, "case kept without MIND_HASH_LOWER");
+    h.flags = MIND_HASH_LOWER;
+    h.seed = 7;
+    mind_hash_embed(&h, text, strlen(text), c);
+    ASSERT(fabsf(dot(a, c, DIM)) < 0.5f, "other seed, other features");
+    h.seed = 0;
+
+    /* Length, not the terminator, delimits the text */
+    mind_hash_embed(&h, "The quick brown fox!!!", 19, c);
+    mind_hash_embed(&h, "The quick brown fox", 19, d);
+    ASSERT(memcmp(c, d, sizeof(c)) == 0, "length delimits");
+
+    /* Too short for a 3-gram with its markers: zero row */
+    ASSERT(mind_hash_embed(&h, "", 0, c) == 0, "empty text");
+    ASSERT(dot(c, c, DIM) == 0.0f, "empty text, zero row");
+    ASSERT(mind_hash_embed(&h, "a", 1, c) == 0 && dot(c, c, DIM) > 0.0f, "one byte, one 3-gram");
+
+    /* Raw counts across chunk boundaries: 998 "aaa" plus the two edge grams */
+    static char run[1000];
+    memset(run, 'a', sizeof(run));
+    mind_hash_t raw = {DIM, 3, 3, 0, MIND_HASH_RAW};
+    ASSERT(mind_hash_embed(&raw, run, sizeof(run), c) == 0, "raw embed");
+    float total = 0.0f, peak = 0.0f;
+    for (int i = 0; i < DIM; i++) {
+        total += fabsf(c[i]);
+        peak = fmaxf(peak, fabsf(c[i]));
+    }
+    ASSERT(total <= 1000.0f && total >= 996.0f && peak >= 997.0f, "every n-gram counted once");
+
+    /* Invalid configurations */
+    mind_hash_t bad = h;
+    bad.max_n = MIND_HASH_MAX_N + 1;
+    ASSERT(mind_hash_embed(&bad, text, 4, c) == -1, "n too large");
+    bad = h;
+    bad.min_n = 6;
+    ASSERT(mind_hash_embed(&bad, text, 4, c) == -1, "min_n > max_n");
+    bad = h;
+    bad.dim = 0;
+    ASSERT(mind_hash_embed(&bad, text, 4, c) == -1, "zero dim");
+    ASSERT(mind_hash_embed(&h, NULL, 4, c) == -1, "NULL text");
+
+    PASS("hash_embed");
+    return 0;
+}
+
+/*============================================================================
+ * Test: Provider interface into a state
+ *============================================================================*/
+
+static int test_hash_provider(void) {
+    enum { ROWS = 4, STRIDE = 64 + 8 };
+    mind_hash_t h;
+    mind_hash_init(&h, 64);
+    mind_embedder_t e = mind_hash_embedder(&h);
+    ASSERT(e.dim == 64 && e.embed && e.ctx == &h, "handle");
+
+    const char* texts[ROWS] = {"alpha", "beta", "gamma", "alpha"};
+    float rows[ROWS * STRIDE];
+    float one[64];
+    ASSERT(e.embed(e.ctx, texts, NULL, ROWS, rows, STRIDE) == 0, "batch");
+    for (int r = 0; r < ROWS; r++) {
+        mind_hash_embed(&h, texts[r], strlen(texts[r]), one);
+        ASSERT(memcmp(rows + r * STRIDE, one, sizeof(one)) == 0, "batch row = single");
+    }
+    size_t lens[ROWS] = {3, 4, 5, 5};
+    ASSERT(e.embed(e.ctx, texts, lens, ROWS, rows, STRIDE) == 0, "batch with lengths");
+    mind_hash_embed(&h, "alp", 3, one);
+    ASSERT(memcmp(rows, one, sizeof(one)) == 0, "lengths honoured");
+    ASSERT(e.embed(e.ctx, texts, NULL, ROWS, rows, 32) == -1, "stride < dim");
+
+    /* Repeated text reinforces instead of creating a slot */
+    cr_config_t cfg = {.embedding_dim = 64, .max_memory_slots = 16, .initial_plasticity = 1.0f};
+    cr_runtime_t* rt = cr_runtime_create(&cfg);
+    cr_state_t* st = cr_state_create(rt);
+    ASSERT(st, "state");
+    e.embed(e.ctx, texts, NULL, ROWS, rows, STRIDE);
+    ASSERT(cr_state_update_batch(st, rows, ROWS, STRIDE, 64, 1.0f) == 0, "update_batch");
+    ASSERT(cr_state_slot_count(st) == 3, "three distinct texts");
+    cr_state_destroy(st);
+    cr_runtime_destroy(rt);
+
+    PASS("hash_provider");
+    return 0;
+}
+
+/*============================================================================
+ * Test: Embedding cache
+ *============================================================================*/
+
+/* Hash provider that counts the texts it embeds */
+typedef struct {
+    mind_hash_t h;
+    int embedded;
+} counting_t;
+
+static int counting_embed(void* ctx, const char* const* texts, const size_t* lens, int count,
+                          float* out, int stride) {
+    counting_t* p = ctx;
+    p->embedded += count;
+    return mind_hash_embed_batch(&p->h, texts, lens, count, out, stride);
+}
+
+static int test_cache(void) {
+    enum { D = 32 };
+    const char* path = "/tmp/mind_test_cache.bin";
+    remove(path);
+
+    counting_t prov;
+    mind_hash_init(&prov.h, D);
+    prov.embedded = 0;
+    mind_embedder_t inner = {counting_embed, &prov, D};
+    unsigned long long tag = mind_cache_hash(&prov.h, sizeof(prov.h));
+
+    /* Only misses reach the provider, and cached rows are the provider's rows */
+    mind_cache_t* c = mind_cache_open(path, D, 64, tag);
+    ASSERT(c, "open");
+    mind_embedder_t e;
+    ASSERT(mind_cache_embedder(c, &inner, &e) == 0 && e.dim == D, "caching provider");
+    const char* texts[5] = {"red", "green", "red", "blue", "green"};
+    float rows[5 * D], want[D];
+    ASSERT(e.embed(e.ctx, texts, NULL, 5, rows, D) == 0, "first batch");
+    ASSERT(prov.embedded == 5, "cold cache embeds every text");
+    ASSERT(e.embed(e.ctx, texts, NULL, 5, rows, D) == 0, "second batch");
+    ASSERT(prov.embedded == 5, "warm cache embeds nothing");
+    for (int r = 0; r < 5; r++) {
+        mind_hash_embed(&prov.h, texts[r], strlen(texts[r]), want);
+        ASSERT(memcmp(rows + r * D, want, sizeof(want)) == 0, "cached row");
+    }
+    mind_cache_stats_t stats;
+    ASSERT(mind_cache_stats(c, &stats) == 0, "stats");
+    ASSERT(stats.hits == 5 && stats.misses == 5 && stats.entries == 3, "stats counts");
+    mind_cache_close(c);
+
+    /* Rows survive a reopen with the same shape and tag */
+    c = mind_cache_open(path, D, 64, tag);
+    ASSERT(c && mind_cache_get(c, "blue", 4, want) == 1, "persisted");
+    ASSERT(mind_cache_get(c, "blu", 3, want) == 0, "prefix is another text");
+
+    /* An open file is locked: a second opener, even with another shape, fails */
+    ASSERT(mind_cache_open(path, D, 64, tag) == NULL, "second open refused");
+    ASSERT(mind_cache_open(path, D, 8, tag + 1) == NULL, "no reset under a live mapping");
+    ASSERT(mind_cache_get(c, "blue", 4, want) == 1, "first handle intact");
+    mind_cache_close(c);
+
+    /* Another provider configuration empties the file */
+    c = mind_cache_open(path, D, 64, tag + 1);
+    ASSERT(c && mind_cache_get(c, "blue", 4, want) == 0, "tag mismatch resets");
+    mind_cache_stats(c, &stats);
+    ASSERT(stats.entries == 0, "reset is empty");
+    mind_cache_close(c);
+
+    /* CLOCK: a row hit since the hand passed gets a second chance */
+    c = mind_cache_open(NULL, D, 4, 0);
+    ASSERT(c, "open in memory");
+    float row[D] = {0};
+    const char* keys[6] = {"a", "b", "c", "d", "e", "f"};
+    for (int k = 0; k < 4; k++) {
+        row[0] = (float)k;
+        ASSERT(mind_cache_put(c, keys[k], 1, row) == 0, "put");
+    }
+    ASSERT(mind_cache_get(c, "a", 1, want) == 1 && want[0] == 0.0f, "hit a");
+    row[0] = 4.0f;
+    mind_cache_put(c, "e", 1, row);
+    row[0] = 5.0f;
+    mind_cache_put(c, "f", 1, row);
+    mind_cache_stats(c, &stats);
+    ASSERT(stats.entries == 4 && stats.evictions == 2, "two evictions");
+    ASSERT(mind_cache_get(c, "a", 1, want) == 1, "referenced row kept");
+    ASSERT(mind_cache_get(c, "b", 1, want) == 0 && mind_cache_get(c, "c", 1, want) == 0,
+           "unreferenced rows evicted");
+    ASSERT(mind_cache_get(c, "d", 1, want) == 1 && want[0] == 3.0f, "d kept");
+    ASSERT(mind_cache_get(c, "f", 1, want) == 1 && want[0] == 5.0f, "f stored");
+    row[0] = 9.0f;
+    mind_cache_put(c, "f", 1, row);
+    ASSERT(mind_cache_get(c, "f", 1, want) == 1 && want[0] == 9.0f, "put replaces");
+
+    /* Churn far past capacity keeps the index consistent */
+    char key[16];
+    for (int k = 0; k < 2000; k++) {
+        int n = snprintf(key, sizeof(key), "k%d", k);
+        row[0] = (float)k;
+        mind_cache_put(c, key, (size_t)n, row);
+        if (k >= 1) {
+            n = snprintf(key, sizeof(key), "k%d", k - 1);
+            ASSERT(mind_cache_get(c, key, (size_t)n, want) == 1 && want[0] == (float)(k - 1),
+                   "recent key found");
+        }
+    }
+    mind_cache_close(c);
+
+    mind_embedder_t wrong = {counting_embed, &prov, D + 1};
+    c = mind_cache_open(NULL, D, 4, 0);
+    ASSERT(mind_cache_embedder(c, &wrong, &e) == -1, "dim mismatch");
+    mind_cache_close(c);
+    ASSERT(mind_cache_open(NULL, 0, 4, 0) == NULL, "zero dim");
+    ASSERT(mind_cache_open("/nonexistent/cache.bin", D, 4, 0) == NULL, "bad path");
+
+    remove(path);
+    PASS("cache");
+    return 0;
+}
+
+/*============================================================================
+ * Test: Pipelined ingestion
+ *============================================================================*/
+
+static cr_state_t* make_state(cr_runtime_t** rt, int dim) {
+    cr_config_t cfg = {.embedding_dim = dim, .max_memory_slots = 64, .initial_plasticity = 1.0f};
+    *rt = cr_runtime_create(&cfg);
+    return *rt ? cr_state_create(*rt) : NULL;
+}
+
+static int test_pipeline(void) {
+    enum { D = 48, N = 203, BATCH = 16 };
+    static char words[N][24];
+    const char* texts[N];
+    for (int i = 0; i < N; i++) {
+        snprintf(words[i], sizeof(words[i]), "topic %d item %d", i % 37, i);
+        texts[i] = words[i];
+    }
+    mind_hash_t h;
+    mind_hash_init(&h, D);
+    mind_embedder_t e = mind_hash_embedder(&h);
+
+    /* Reference: embed and update every batch synchronously */
+    cr_runtime_t* rt_ref;
+    cr_state_t* ref = make_state(&rt_ref, D);
+    ASSERT(ref, "reference state");
+    float rows[BATCH * D];
+    for (int first = 0; first < N; first += BATCH) {
+        int n = N - first < BATCH ? N - first : BATCH;
+        e.embed(e.ctx, texts + first, NULL, n, rows, D);
+        ASSERT(cr_state_update_batch(ref, rows, n, D, D, 0.5f) == 0, "reference update");
+    }
+    unsigned long long want;
+    cr_state_digest(ref, &want);
+
+    /* Pipelined, fed in uneven pieces: same state */
+    cr_runtime_t* rt;
+    cr_state_t* st = make_state(&rt, D);
+    mind_pipeline_t* p = mind_pipeline_create(st, &e, BATCH, 2);
+    ASSERT(p, "create");
+    ASSERT(mind_pipeline_feed(p, texts, NULL, 100, 0.5f) == 0, "feed");
+    ASSERT(mind_pipeline_feed(p, texts + 100, NULL, 4, 0.5f) == 0, "feed short");
+    ASSERT(mind_pipeline_feed(p, texts + 104, NULL, 0, 0.5f) == 0, "feed nothing");
+    ASSERT(mind_pipeline_feed(p, texts + 104, NULL, N - 104, 0.5f) == 0, "feed rest");
+    ASSERT(mind_pipeline_flush(p) == 0, "flush");
+    mind_pipeline_stats_t stats;
+    mind_pipeline_stats(p, &stats);
+    ASSERT(stats.texts == N && stats.failed == 0, "stats");
+    mind_pipeline_destroy(p);
+    unsigned long long got;
+    cr_state_digest(st, &got);
+    ASSERT(got == want, "pipelined state matches synchronous state");
+    cr_state_destroy(st);
+    cr_runtime_destroy(rt);
+
+    /* Cut into the same batches as the reference, the order is the same */
+    st = make_state(&rt, D);
+    p = mind_pipeline_create(st, &e, BATCH, 3);
+    ASSERT(p && mind_pipeline_feed(p, texts, NULL, N, 0.5f) == 0, "feed all");
+    mind_pipeline_destroy(p);   /* Destroy flushes */
+    cr_state_digest(st, &got);
+    ASSERT(got == want, "triple buffered, flushed by destroy");
+    cr_state_destroy(st);
+    cr_runtime_destroy(rt);
+
+    /* Errors: dim mismatch fails the first feed, bad arguments fail create */
+    st = make_state(&rt, D + 1);
+    p = mind_pipeline_create(st, &e, BATCH, 2);
+    ASSERT(p && mind_pipeline_feed(p, texts, NULL, 4, 0.5f) == -1, "dim mismatch");
+    mind_pipeline_destroy(p);
+    ASSERT(mind_pipeline_create(st, &e, BATCH, 1) == NULL, "one buffer");
+    ASSERT(mind_pipeline_create(st, &e, 0, 2) == NULL, "empty batch");
+    cr_state_destroy(st);
+    cr_runtime_destroy(rt);
+    cr_state_destroy(ref);
+    cr_runtime_destroy(rt_ref);
+
+    PASS("pipeline");
+    return 0;
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+int main(void) {
+    printf("MIND Integration Tests\n");
+    printf("======================\n\n");
+
+    int failures = 0;
+
+    failures += test_hash_embed();
+    failures += test_hash_provider();
+    failures += test_cache();
+    failures += test_pipeline();
+
+    printf("\n======================\n");
+    if (failures == 0) {
+        printf("All tests passed.\n");
+        return 0;
+    } else {
+        printf("%d test(s) failed.\n", failures);
+        return 1;
+    }
+}
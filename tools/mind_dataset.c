@@ -0,0 +1,261 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file mind_dataset.c
+ * @brief Memory-mapped embedding dataset readers
+ *
+ * Parsing only looks at the first row (vecs) or the header (npy); rows
+ * are never read until a caller asks for them, so opening a large file
+ * costs one mmap.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "mind_dataset.h"
+
+/*============================================================================
+ * Formats
+ *============================================================================*/
+
+/* fvecs / bvecs: every row repeats its int32 length */
+static int dataset_vecs(mind_dataset_t* ds, int type, size_t elem) {
+    const unsigned char* p = ds->map;
+    int32_t dim;
+    if (ds->map_size < sizeof(dim)) {
+        return -1;
+    }
+    memcpy(&dim, p, sizeof(dim));
+    size_t row_bytes = sizeof(int32_t) + elem * (size_t)dim;
+    if (dim <= 0 || ds->map_size % row_bytes != 0) {
+        return -1;
+    }
+
+    ds->format = type == MIND_DATASET_F32 ? "fvecs" : "bvecs";
+    ds->type = type;
+    ds->dim = dim;
+    ds->stride = row_bytes;
+    ds->count = (long long)(ds->map_size / row_bytes);
+    ds->rows = p + sizeof(int32_t);
+    return 0;
+}
+
+/* The shape tuple ends after its second entry: "(N, D)" or "(N, D,)" */
+static int npy_shape_closed(const char* s) {
+    while (*s == ' ') {
+        s++;
+    }
+    if (*s == ',') {
+        s++;
+        while (*s == ' ') {
+            s++;
+        }
+    }
+    return *s == ')';
+}
+
+/* npy 1.0 / 2.0 / 3.0: magic, version, header length, Python dict literal */
+static int dataset_npy(mind_dataset_t* ds) {
+    const unsigned char* p = ds->map;
+    size_t len, start;
+    if (p[6] == 1) {
+        len = (size_t)p[8] | (size_t)p[9] << 8;
+        start = 10;
+    } else {
+        if (ds->map_size < 12) {
+            return -1;
+        }
+        len = (size_t)p[8] | (size_t)p[9] << 8 | (size_t)p[10] << 16 | (size_t)p[11] << 24;
+        start = 12;
+    }
+    if (start + len > ds->map_size) {
+        return -1;
+    }
+
+    char* header = malloc(len + 1);
+    if (!header) {
+        return -1;
+    }
+    memcpy(header, p + start, len);
+    header[len] = '\0';
+
+    static const struct {
+        const char* descr;
+        int type;
+        size_t elem;
+    } types[] = {
+        {"'descr': '<f4'", MIND_DATASET_F32, 4},
+        {"'descr': '<f2'", MIND_DATASET_F16, 2},
+        {"'descr': '|u1'", MIND_DATASET_U8, 1},
+    };
+    int t = -1;
+    for (int i = 0; i < 3; i++) {
+        if (strstr(header, types[i].descr)) {
+            t = i;
+        }
+    }
+
+    long long rows = 0, cols = 0;
+    int end = 0;
+    const char* shape = strstr(header, "'shape':");
+    int ok = t >= 0 && strstr(header, "'fortran_order': False") && shape &&
+             sscanf(shape, "'shape': (%lld, %lld%n", &rows, &cols, &end) == 2 && end > 0 &&
+             npy_shape_closed(shape + end);
+    free(header);
+    if (!ok || rows < 0 || cols <= 0 || cols > INT32_MAX) {
+        return -1;
+    }
+
+    size_t row_bytes = types[t].elem * (size_t)cols;
+    if ((size_t)rows > (ds->map_size - start - len) / row_bytes) {
+        return -1;
+    }
+
+    ds->format = "npy";
+    ds->type = types[t].type;
+    ds->dim = (int)cols;
+    ds->stride = row_bytes;
+    ds->count = rows;
+    ds->rows = p + start + len;
+    return 0;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+int mind_dataset_open(mind_dataset_t* ds, const char* path) {
+    if (!ds) {
+        return -1;
+    }
+    memset(ds, 0, sizeof(*ds));
+    if (!path) {
+        return -1;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    struct stat sb;
+    if (fstat(fd, &sb) != 0 || sb.st_size <= 0) {
+        close(fd);
+        return -1;
+    }
+    void* map = mmap(NULL, (size_t)sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return -1;
+    }
+    ds->map = map;
+    ds->map_size = (size_t)sb.st_size;
+    posix_madvise(map, ds->map_size, POSIX_MADV_SEQUENTIAL);
+
+    if (ds->map_size >= 10 && memcmp(map, "\x93NUMPY", 6) == 0) {
+        return dataset_npy(ds);
+    }
+    size_t n = strlen(path);
+    if (n >= 6 && strcmp(path + n - 6, ".bvecs") == 0) {
+        return dataset_vecs(ds, MIND_DATASET_U8, 1);
+    }
+    return dataset_vecs(ds, MIND_DATASET_F32, sizeof(float));
+}
+
+void mind_dataset_close(mind_dataset_t* ds) {
+    if (ds && ds->map) {
+        munmap(ds->map, ds->map_size);
+    }
+    if (ds) {
+        memset(ds, 0, sizeof(*ds));
+    }
+}
+
+const void* mind_dataset_row(const mind_dataset_t* ds, long long i) {
+    if (!ds || !ds->rows || i < 0 || i >= ds->count) {
+        return NULL;
+    }
+    return (const unsigned char*)ds->rows + (size_t)i * ds->stride;
+}
+
+float mind_dataset_half(unsigned short h) {
+    uint32_t sign = (uint32_t)(h & 0x8000u) << 16;
+    uint32_t exp = (h >> 10) & 0x1fu;
+    uint32_t man = h & 0x3ffu;
+    uint32_t bits;
+
+    if (exp == 0x1f) {
+        bits = sign | 0x7f800000u | (man << 13);            /* Inf / NaN */
+    } else if (exp != 0) {
+        bits = sign | ((exp + 112) << 23) | (man << 13);    /* Rebias 15 -> 127 */
+    } else {
+        float f = (float)man * 5.9604644775390625e-8f;      /* man × 2^-24 */
+        return sign ? -f : f;
+    }
+
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+int mind_dataset_batch(const mind_dataset_t* ds, long long first, int count,
+                       float* scratch, mind_batch_t* out) {
+    if (!ds || !out || !ds->rows || count <= 0 || first < 0 || first >= ds->count) {
+        return -1;
+    }
+    if (count > ds->count - first) {
+        count = (int)(ds->count - first);
+    }
+
+    const unsigned char* row = mind_dataset_row(ds, first);
+    int dim = ds->dim;
+    out->count = count;
+    out->dim = dim;
+
+    if (ds->type == MIND_DATASET_F32) {
+        out->rows = (const float*)row;
+        out->stride = (int)(ds->stride / sizeof(float));
+        return 0;
+    }
+    if (!scratch) {
+        return -1;
+    }
+
+    for (int r = 0; r < count; r++, row += ds->stride) {
+        float* to = scratch + (size_t)r * dim;
+        if (ds->type == MIND_DATASET_U8) {
+            for (int i = 0; i < dim; i++) {
+                to[i] = (float)row[i];
+            }
+        } else {
+            for (int i = 0; i < dim; i++) {
+                unsigned short h;
+                memcpy(&h, row + 2 * (size_t)i, sizeof(h));
+                to[i] = mind_dataset_half(h);
+            }
+        }
+    }
+    out->rows = scratch;
+    out->stride = dim;
+    return 0;
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file mind_dataset.h
+ * @brief Memory-mapped embedding dataset readers
+ *
+ * Maps .fvecs, .bvecs and .npy files and hands out pointers into the
+ * mapping. float32 rows go to cr_state_update_batch() and
+ * cr_state_query_batch() as they are (fvecs rows are strided past their
+ * length prefix). Other element types are widened into a caller buffer,
+ * one batch at a time. Nothing is allocated per row.
+ *
+ * Formats:
+ *   .fvecs   per row: int32 dim, dim × float32
+ *   .bvecs   per row: int32 dim, dim × uint8
+ *   .npy     2-D, C order; '<f4', '<f2' or '|u1'
+ *
+ * POSIX only (mmap).
+ */
+
+#ifndef MIND_DATASET_H
+#define MIND_DATASET_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Element types
+ */
+typedef enum {
+    MIND_DATASET_F32 = 1,   /**< float32 (zero-copy batches) */
+    MIND_DATASET_F16 = 2,   /**< IEEE half precision */
+    MIND_DATASET_U8 = 3     /**< uint8 */
+} mind_dataset_type_t;
+
+/**
+ * @brief Mapped dataset
+ */
+typedef struct {
+    const void* rows;       /**< First row, inside the mapping */
+    long long count;        /**< Number of rows */
+    int dim;                /**< Elements per row */
+    size_t stride;          /**< Bytes between row starts */
+    int type;               /**< mind_dataset_type_t */
+    const char* format;     /**< "fvecs", "bvecs" or "npy" */
+
+    void* map;              /**< Whole-file mapping */
+    size_t map_size;
+} mind_dataset_t;
+
+/**
+ * @brief Batch of rows as float32
+ *
+ * Arguments for cr_state_update_batch() / cr_state_query_batch().
+ */
+typedef struct {
+    const float* rows;      /**< First row */
+    int count;              /**< Rows in the batch */
+    int stride;             /**< Floats between row starts */
+    int dim;                /**< Floats per row */
+} mind_batch_t;
+
+/**
+ * @brief Map a dataset file
+ *
+ * The format is detected from the content (.npy magic), else from the
+ * extension (.bvecs), else fvecs.
+ *
+ * @param ds Dataset to fill (closed with mind_dataset_close() even on error)
+ * @param path File path
+ * @return 0 on success, -1 if the file cannot be mapped or parsed
+ */
+int mind_dataset_open(mind_dataset_t* ds, const char* path);
+
+/**
+ * @brief Unmap a dataset
+ *
+ * @param ds Dataset (may be unopened or failed)
+ */
+void mind_dataset_close(mind_dataset_t* ds);
+
+/**
+ * @brief Pointer to row i in its stored type
+ *
+ * @return Row, or NULL if i is out of range
+ */
+const void* mind_dataset_row(const mind_dataset_t* ds, long long i);
+
+/**
+ * @brief Rows [first, first + count) as float32
+ *
+ * float32 datasets are returned in place and scratch is not touched.
+ * Other types are converted into scratch (count × dim floats, may be
+ * NULL for float32 datasets). count is clipped to the rows available.
+ *
+ * @param ds Dataset
+ * @param first First row
+ * @param count Rows wanted (> 0)
+ * @param scratch Conversion buffer
+ * @param out Receives the batch
+ * @return 0 on success, -1 on error (first out of range, no scratch)
+ */
+int mind_dataset_batch(const mind_dataset_t* ds, long long first, int count,
+                       float* scratch, mind_batch_t* out);
+
+/**
+ * @brief Convert IEEE half precision to float
+ */
+float mind_dataset_half(unsigned short h);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MIND_DATASET_H */
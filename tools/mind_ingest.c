@@ -0,0 +1,268 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file mind_ingest.c
+ * @brief Ingest a text file (one text per line) end to end
+ *
+ * Texts go through the local hashed n-gram embedder (mind_hash.h),
+ * optionally behind an embedding cache (mind_cache.h), into a state.
+ * The pipeline mode overlaps embedding and ingestion (mind_pipeline.h);
+ * the sync mode runs both on one thread, batch after batch, for
+ * comparison. Both produce the same state.
+ *
+ * Output is one "key value" pair per line, like mind_replay.
+ *
+ * Usage: mind_ingest [options] FILE
+ *
+ *   -m MODE    pipeline (default) or sync
+ *   -d DIM     embedding dim (default 384)
+ *   -b ROWS    texts per batch (default 256)
+ *   -q N       pipeline buffers (default 2)
+ *   -s SLOTS   max memory slots (default 1024)
+ *   -t DT      delta_t per text (default 1)
+ *   -r PASSES  passes over the file (default 1)
+ *   -C PATH    embedding cache file
+ *   -k ROWS    embedding cache rows (default 65536)
+ *   -o PATH    save the state afterwards
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "cr.h"
+#include "mind_cache.h"
+#include "mind_hash.h"
+#include "mind_pipeline.h"
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Whole file in memory, split at newlines (texts are not NUL-terminated) */
+static int read_lines(const char* path, char** data, const char*** texts, size_t** lens,
+                      int* count) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        return -1;
+    }
+    size_t cap = 1 << 16, size = 0, got;
+    char* buf = malloc(cap);
+    while (buf && (got = fread(buf + size, 1, cap - size, f)) > 0) {
+        size += got;
+        if (size == cap) {
+            char* grown = realloc(buf, cap * 2);
+            if (!grown) {
+                free(buf);
+                buf = NULL;
+                break;
+            }
+            buf = grown;
+            cap *= 2;
+        }
+    }
+    fclose(f);
+    if (!buf) {
+        return -1;
+    }
+
+    int n = 0;
+    for (size_t i = 0; i < size; i++) {
+        n += buf[i] == '\n';
+    }
+    n += size > 0 && buf[size - 1] != '\n';
+    *texts = malloc(sizeof(**texts) * (size_t)(n > 0 ? n : 1));
+    *lens = malloc(sizeof(**lens) * (size_t)(n > 0 ? n : 1));
+    if (!*texts || !*lens) {
+        free(buf);
+        return -1;
+    }
+    size_t start = 0;
+    int k = 0;
+    for (size_t i = 0; i <= size; i++) {
+        if (i == size ? i > start : buf[i] == '\n') {
+            (*texts)[k] = buf + start;
+            (*lens)[k] = i - start;
+            k++;
+            start = i + 1;
+        }
+    }
+    *data = buf;
+    *count = k;
+    return 0;
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "usage: %s [-m pipeline|sync] [-d dim] [-b rows] [-q buffers] [-s slots]\n"
+            "       [-t delta_t] [-r passes] [-C cache_path] [-k cache_rows]\n"
+            "       [-o save_path] FILE\n", argv0);
+}
+
+int main(int argc, char** argv) {
+    const char* mode = "pipeline";
+    int dim = 384, batch = 256, buffers = 2, slots = 1024, passes = 1, cache_rows = 65536;
+    float delta_t = 1.0f;
+    const char* cache_path = NULL;
+    const char* save_path = NULL;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "m:d:b:q:s:t:r:C:k:o:")) != -1) {
+        switch (opt) {
+        case 'm': mode = optarg; break;
+        case 'd': dim = atoi(optarg); break;
+        case 'b': batch = atoi(optarg); break;
+        case 'q': buffers = atoi(optarg); break;
+        case 's': slots = atoi(optarg); break;
+        case 't': delta_t = (float)atof(optarg); break;
+        case 'r': passes = atoi(optarg); break;
+        case 'C': cache_path = optarg; break;
+        case 'k': cache_rows = atoi(optarg); break;
+        case 'o': save_path = optarg; break;
+        default: usage(argv[0]); return 1;
+        }
+    }
+    int pipelined = strcmp(mode, "pipeline") == 0;
+    if (optind != argc - 1 || (!pipelined && strcmp(mode, "sync") != 0) || dim <= 0 ||
+        batch <= 0 || buffers < 2 || slots <= 0 || !(delta_t > 0.0f) || passes <= 0 ||
+        cache_rows <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    char* data;
+    const char** texts;
+    size_t* lens;
+    int count;
+    if (read_lines(argv[optind], &data, &texts, &lens, &count) != 0) {
+        fprintf(stderr, "%s: cannot read\n", argv[optind]);
+        return 1;
+    }
+
+    mind_hash_t h;
+    mind_hash_init(&h, dim);
+    mind_embedder_t e = mind_hash_embedder(&h);
+    mind_cache_t* cache = NULL;
+    if (cache_path) {
+        cache = mind_cache_open(cache_path, dim, cache_rows, mind_cache_hash(&h, sizeof(h)));
+        if (!cache || mind_cache_embedder(cache, &e, &e) != 0) {
+            fprintf(stderr, "%s: cannot open cache\n", cache_path);
+            return 1;
+        }
+    }
+
+    cr_config_t cfg = {
+        .embedding_dim = dim,
+        .max_memory_slots = slots,
+        .initial_plasticity = 1.0f
+    };
+    cr_runtime_t* rt = cr_runtime_create(&cfg);
+    cr_state_t* st = rt ? cr_state_create(rt) : NULL;
+    float* rows = pipelined ? NULL : malloc(sizeof(float) * (size_t)batch * (size_t)dim);
+    mind_pipeline_t* p = pipelined && st ? mind_pipeline_create(st, &e, batch, buffers) : NULL;
+    if (!st || (pipelined ? !p : !rows)) {
+        fprintf(stderr, "cannot create a state for dim %d, %d slots\n", dim, slots);
+        return 1;
+    }
+
+    int rc = 0;
+    double embed_seconds = 0.0, stall_seconds = 0.0;
+    double t0 = now_s();
+    for (int pass = 0; pass < passes && rc == 0; pass++) {
+        if (pipelined) {
+            rc = mind_pipeline_feed(p, texts, lens, count, delta_t);
+            continue;
+        }
+        for (int first = 0; first < count && rc == 0; first += batch) {
+            int n = count - first < batch ? count - first : batch;
+            double te = now_s();
+            rc = e.embed(e.ctx, texts + first, lens + first, n, rows, dim);
+            embed_seconds += now_s() - te;
+            if (rc == 0) {
+                rc = cr_state_update_batch(st, rows, n, dim, dim, delta_t);
+            }
+        }
+    }
+    if (pipelined) {
+        rc |= mind_pipeline_flush(p);
+        mind_pipeline_stats_t ps;
+        mind_pipeline_stats(p, &ps);
+        embed_seconds = ps.embed_seconds;
+        stall_seconds = ps.stall_seconds;
+        mind_pipeline_destroy(p);
+    }
+    double seconds = now_s() - t0;
+    if (rc != 0) {
+        fprintf(stderr, "ingest failed\n");
+        return 1;
+    }
+
+    unsigned long long digest;
+    cr_state_digest(st, &digest);
+    long long total = (long long)count * passes;
+
+    printf("file %s\n", argv[optind]);
+    printf("texts %lld\n", total);
+    printf("dim %d\n", dim);
+    printf("mode %s\n", mode);
+    printf("batch %d\n", batch);
+    if (pipelined) {
+        printf("buffers %d\n", buffers);
+    }
+    printf("seconds %.6f\n", seconds);
+    printf("texts_per_sec %.1f\n", seconds > 0.0 ? (double)total / seconds : 0.0);
+    printf("embed_seconds %.6f\n", embed_seconds);
+    if (pipelined) {
+        printf("stall_seconds %.6f\n", stall_seconds);
+    }
+    if (cache) {
+        mind_cache_stats_t cs;
+        mind_cache_stats(cache, &cs);
+        printf("cache_hits %llu\n", cs.hits);
+        printf("cache_misses %llu\n", cs.misses);
+        printf("cache_entries %d\n", cs.entries);
+    }
+    printf("slots %d\n", cr_state_slot_count(st));
+    printf("digest %016llx\n", digest);
+
+    if (save_path) {
+        rc = cr_state_save(st, save_path) == 0 ? 0 : 1;
+        if (rc != 0) {
+            fprintf(stderr, "%s: cannot save state\n", save_path);
+        } else {
+            printf("saved %s\n", save_path);
+        }
+    }
+
+    mind_cache_close(cache);
+    free(rows);
+    cr_state_destroy(st);
+    cr_runtime_destroy(rt);
+    free(texts);
+    free(lens);
+    free(data);
+    return rc;
+}
@@ -0,0 +1,310 @@
+/*
+ * Copyright 2026 The MIND Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file mind_replay.c
+ * @brief Replay an embedding stream from a dataset file into a state
+ *
+ * The file is memory-mapped (mind_dataset.h) and float32 rows are
+ * handed to the update API in place, so replay runs at the rate of the
+ * state, not of a parser. Used for capacity tests and to rebuild states
+ * from archived streams.
+ *
+ * Output is one "key value" pair per line, like mind_bench: throughput,
+ * per-call latency, the final temporal and calibration fields, and the
+ * state digest (cr_state_digest), which identifies the resulting state.
+ *
+ * Usage: mind_replay [options] FILE
+ *
+ *   -m MODE    update (one call per row), batch (default) or async
+ *   -b ROWS    rows per batch (default 256)
+ *   -q DEPTH   async batches in flight (default 4)
+ *   -s SLOTS   max memory slots (default 1024)
+ *   -c N       coarse slots (two-level memory, default 0)
+ *   -p N       coarse probe (default 0)
+ *   -t DT      delta_t per row (default 1)
+ *   -n ROWS    replay at most ROWS rows of the file
+ *   -r PASSES  passes over the rows (default 1)
+ *   -l PATH    load this state before replaying
+ *   -o PATH    save the state after replaying
+ *
+ * Formats: .fvecs, .bvecs and .npy (float32, float16 or uint8); see
+ * mind_dataset.h.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "cr.h"
+#include "mind_dataset.h"
+
+typedef struct {
+    const char* mode;
+    int batch;
+    int depth;
+    float delta_t;
+    long limit;
+    int passes;
+} replay_opts_t;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/*============================================================================
+ * Replay
+ *============================================================================*/
+
+/* Latency of every call, in ns; returns the number of calls or -1 */
+static long replay_run(cr_state_t* st, const mind_dataset_t* ds, long long rows,
+                       const replay_opts_t* o, float* scratch, double* lat) {
+    int per_call = strcmp(o->mode, "update") == 0 ? 1 : o->batch;
+    long long per_pass = (rows + per_call - 1) / per_call;
+    long long total = per_pass * o->passes;
+    mind_batch_t b;
+
+    if (strcmp(o->mode, "async") != 0) {
+        for (long long c = 0; c < total; c++) {
+            long long first = (c % per_pass) * per_call;
+            int n = rows - first < per_call ? (int)(rows - first) : per_call;
+            double t0 = now_ns();
+            if (mind_dataset_batch(ds, first, n, scratch, &b) != 0) {
+                return -1;
+            }
+            int rc = per_call == 1
+                ? cr_state_update(st, b.rows, b.dim, o->delta_t)
+                : cr_state_update_batch(st, b.rows, b.count, b.stride, b.dim, o->delta_t);
+            if (rc != 0) {
+                return -1;
+            }
+            lat[c] = now_ns() - t0;
+        }
+        return (long)total;
+    }
+
+    /*
+     * async: keep depth batches in flight, latency is submit to reap.
+     * Completions arrive in submission order, so converted batches use
+     * scratch round-robin.
+     */
+    cr_queue_t* q = cr_queue_create(st, o->depth);
+    if (!q) {
+        return -1;
+    }
+    long long submitted = 0, reaped = 0;
+    int failed = 0;
+    struct pollfd pfd = {cr_queue_fd(q), POLLIN, 0};
+    cr_completion_t done[16];
+
+    while (reaped < total) {
+        while (submitted < total && submitted - reaped < o->depth) {
+            long long first = (submitted % per_pass) * per_call;
+            int n = rows - first < per_call ? (int)(rows - first) : per_call;
+            float* buf = scratch ? scratch + (size_t)(submitted % o->depth) * per_call * ds->dim
+                                 : NULL;
+            lat[submitted] = now_ns();
+            if (mind_dataset_batch(ds, first, n, buf, &b) != 0 ||
+                cr_queue_submit_update(q, b.rows, b.count, b.stride, b.dim, o->delta_t,
+                                       (unsigned long long)submitted) != 0) {
+                break;
+            }
+            submitted++;
+        }
+        if (submitted == reaped) {
+            failed = 1;  /* Nothing in flight and nothing accepted */
+            break;
+        }
+
+        /* Reap until empty: the descriptor is cleared by the first poll,
+         * so completions left behind would never wake us again */
+        int got = cr_queue_poll(q, done, 16);
+        if (got == 0) {
+            poll(&pfd, 1, -1);
+            continue;
+        }
+        if (got < 0) {
+            failed = 1;
+            break;
+        }
+        double t = now_ns();
+        for (int k = 0; k < got; k++) {
+            lat[done[k].tag] = t - lat[done[k].tag];
+            failed |= done[k].status != 0;
+        }
+        reaped += got;
+    }
+
+    cr_queue_destroy(q);
+    return failed ? -1 : (long)reaped;
+}
+
+static int cmp_double(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile of sorted values */
+static double percentile(const double* v, long n, double pct) {
+    long rank = (long)(pct / 100.0 * (double)n + 0.999999);
+    if (rank < 1) {
+        rank = 1;
+    }
+    return v[(rank > n ? n : rank) - 1];
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "usage: %s [-m update|batch|async] [-b rows] [-q depth] [-s slots]\n"
+            "       [-c coarse] [-p probe] [-t delta_t] [-n rows] [-r passes]\n"
+            "       [-l load_path] [-o save_path] FILE\n", argv0);
+}
+
+int main(int argc, char** argv) {
+    replay_opts_t o = {"batch", 256, 4, 1.0f, -1, 1};
+    int slots = 1024, coarse = 0, probe = 0;
+    const char* load_path = NULL;
+    const char* save_path = NULL;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "m:b:q:s:c:p:t:n:r:l:o:")) != -1) {
+        switch (opt) {
+        case 'm': o.mode = optarg; break;
+        case 'b': o.batch = atoi(optarg); break;
+        case 'q': o.depth = atoi(optarg); break;
+        case 's': slots = atoi(optarg); break;
+        case 'c': coarse = atoi(optarg); break;
+        case 'p': probe = atoi(optarg); break;
+        case 't': o.delta_t = (float)atof(optarg); break;
+        case 'n': o.limit = atol(optarg); break;
+        case 'r': o.passes = atoi(optarg); break;
+        case 'l': load_path = optarg; break;
+        case 'o': save_path = optarg; break;
+        default: usage(argv[0]); return 1;
+        }
+    }
+    int known = strcmp(o.mode, "update") == 0 || strcmp(o.mode, "batch") == 0 ||
+                strcmp(o.mode, "async") == 0;
+    if (optind != argc - 1 || !known || o.batch <= 0 || o.depth <= 0 || slots <= 0 ||
+        coarse < 0 || probe < 0 || !(o.delta_t > 0.0f) || o.passes <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    mind_dataset_t d;
+    if (mind_dataset_open(&d, argv[optind]) != 0) {
+        fprintf(stderr, "%s: not a readable .fvecs, .bvecs or .npy file\n", argv[optind]);
+        mind_dataset_close(&d);
+        return 1;
+    }
+    long long rows = o.limit >= 0 && o.limit < d.count ? o.limit : d.count;
+    int per_call = strcmp(o.mode, "update") == 0 ? 1 : o.batch;
+
+    cr_config_t cfg = {
+        .embedding_dim = d.dim,
+        .max_memory_slots = slots,
+        .initial_plasticity = 1.0f,
+        .coarse_slots = coarse,
+        .coarse_probe = probe
+    };
+    cr_runtime_t* rt = cr_runtime_create(&cfg);
+    cr_state_t* st = rt ? cr_state_create(rt) : NULL;
+    long long max_calls = (rows + per_call - 1) / per_call * o.passes;
+    double* lat = malloc(sizeof(double) * (size_t)(max_calls > 0 ? max_calls : 1));
+
+    /* Conversion buffers for non-float32 rows: one batch per call in flight */
+    float* scratch = NULL;
+    if (d.type != MIND_DATASET_F32) {
+        int buffers = strcmp(o.mode, "async") == 0 ? o.depth : 1;
+        scratch = malloc(sizeof(float) * (size_t)buffers * per_call * d.dim);
+    }
+    if (!st || !lat || (d.type != MIND_DATASET_F32 && !scratch)) {
+        fprintf(stderr, "cannot create a state for dim %d, %d slots\n", d.dim, slots);
+        return 1;
+    }
+    if (load_path && cr_state_load(st, load_path) != 0) {
+        fprintf(stderr, "%s: cannot load state\n", load_path);
+        return 1;
+    }
+
+    double t0 = now_ns();
+    long calls = replay_run(st, &d, rows, &o, scratch, lat);
+    double seconds = (now_ns() - t0) * 1e-9;
+    if (calls < 0) {
+        fprintf(stderr, "replay failed\n");
+        return 1;
+    }
+    qsort(lat, (size_t)calls, sizeof(double), cmp_double);
+
+    cr_temporal_t tm;
+    cr_calibration_t cal;
+    unsigned long long digest;
+    cr_state_temporal(st, &tm);
+    cr_state_calibration(st, &cal);
+    cr_state_digest(st, &digest);
+
+    printf("file %s\n", argv[optind]);
+    printf("format %s\n", d.format);
+    printf("dim %d\n", d.dim);
+    printf("rows %lld\n", rows * o.passes);
+    printf("mode %s\n", o.mode);
+    printf("batch %d\n", per_call);
+    printf("seconds %.6f\n", seconds);
+    printf("rows_per_sec %.1f\n", seconds > 0.0 ? (double)(rows * o.passes) / seconds : 0.0);
+    if (calls > 0) {
+        printf("latency_p50_us %.3f\n", percentile(lat, calls, 50.0) * 1e-3);
+        printf("latency_p99_us %.3f\n", percentile(lat, calls, 99.0) * 1e-3);
+        printf("latency_max_us %.3f\n", lat[calls - 1] * 1e-3);
+    }
+    printf("slots %d\n", cr_state_slot_count(st));
+    printf("age %.6f\n", tm.age);
+    printf("plasticity %.6f\n", tm.plasticity);
+    printf("velocity %.6f\n", tm.velocity);
+    printf("maturity %.6f\n", tm.maturity);
+    printf("time_since_reinforcement %.6f\n", tm.time_since_reinforcement);
+    printf("total_updates %lld\n", tm.total_updates);
+    printf("total_reinforcements %lld\n", tm.total_reinforcements);
+    printf("reinforcement_ratio %.6f\n", cal.reinforcement_ratio);
+    printf("digest %016llx\n", digest);
+
+    int rc = 0;
+    if (save_path) {
+        rc = cr_state_save(st, save_path) == 0 ? 0 : 1;
+        if (rc != 0) {
+            fprintf(stderr, "%s: cannot save state\n", save_path);
+        } else {
+            printf("saved %s\n", save_path);
+        }
+    }
+
+    free(scratch);
+    free(lat);
+    cr_state_destroy(st);
+    cr_runtime_destroy(rt);
+    mind_dataset_close(&d);
+    return rc;
+}